@@ -34,6 +34,7 @@
 #include "storage/spin.h"
 #include "tcop/tcopprot.h"
 #include "utils/combocid.h"
+#include "utils/graphalgo.h"
 #include "utils/guc.h"
 #include "utils/inval.h"
 #include "utils/memutils.h"
@@ -135,6 +136,18 @@ static const struct
 	},
 	{
 		"_bt_parallel_build_main", _bt_parallel_build_main
+	},
+	{
+		"pagerank_parallel_main", pagerank_parallel_main
+	},
+	{
+		"wcc_parallel_main", wcc_parallel_main
+	},
+	{
+		"triangle_parallel_main", triangle_parallel_main
+	},
+	{
+		"random_walks_parallel_main", random_walks_parallel_main
 	}
 };
 
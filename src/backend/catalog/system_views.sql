@@ -539,6 +539,24 @@ CREATE VIEW pg_stat_all_tables AS
     WHERE C.relkind IN ('r', 't', 'm')
     GROUP BY C.oid, N.nspname, C.relname;
 
+CREATE VIEW pg_stat_graph_labels AS
+    SELECT
+            L.relid,
+            G.graphname,
+            L.labname,
+            L.labkind,
+            pg_stat_get_tuples_inserted(L.relid) AS created,
+            pg_stat_get_tuples_returned(L.relid) +
+            sum(pg_stat_get_tuples_fetched(I.indexrelid))::bigint +
+            pg_stat_get_tuples_fetched(L.relid) AS matched,
+            pg_stat_get_graph_expanded(L.relid) AS expanded,
+            pg_stat_get_graph_merge_matched(L.relid) AS merge_matched,
+            pg_stat_get_graph_merge_created(L.relid) AS merge_created
+    FROM ag_label L JOIN
+         ag_graph G ON (G.oid = L.graphid)
+         LEFT JOIN pg_index I ON (L.relid = I.indrelid)
+    GROUP BY L.relid, G.graphname, L.labname, L.labkind;
+
 CREATE VIEW pg_stat_xact_all_tables AS
     SELECT
             C.oid AS relid,
@@ -1145,6 +1163,35 @@ LANGUAGE INTERNAL
 STRICT IMMUTABLE PARALLEL SAFE
 AS 'jsonb_insert';
 
+CREATE OR REPLACE FUNCTION
+  graph_projection_create(name text, edge_label text, weight text DEFAULT NULL,
+                          vertex_label text DEFAULT NULL,
+                          reachability boolean DEFAULT false)
+RETURNS void
+LANGUAGE INTERNAL
+VOLATILE PARALLEL UNSAFE
+AS 'graph_projection_create';
+
+CREATE OR REPLACE FUNCTION
+  pagerank(graph text, vertex_label text, edge_label text,
+           iterations integer DEFAULT 20, damping float8 DEFAULT 0.85,
+           OUT id graphid, OUT score float8)
+RETURNS SETOF record
+LANGUAGE INTERNAL
+VOLATILE PARALLEL UNSAFE ROWS 1000
+AS 'pagerank';
+
+CREATE OR REPLACE FUNCTION
+  random_walks(graph text, edge_label text,
+               start_vertices graphid[] DEFAULT NULL,
+               walk_length integer DEFAULT 10,
+               walks_per_vertex integer DEFAULT 1,
+               OUT start graphid, OUT walk integer, OUT path graphid[])
+RETURNS SETOF record
+LANGUAGE INTERNAL
+VOLATILE PARALLEL UNSAFE ROWS 1000
+AS 'random_walks';
+
 --
 -- The default permissions for functions mean that anyone can execute them.
 -- A number of functions shouldn't be executable by just anyone, but rather
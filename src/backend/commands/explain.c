@@ -104,6 +104,9 @@ static void show_tablesample(TableSampleClause *tsc, PlanState *planstate,
 static void show_sort_info(SortState *sortstate, ExplainState *es);
 static void show_hash_info(HashState *hashstate, ExplainState *es);
 static void show_hash2side_info(Hash2SideState *hashstate, ExplainState *es);
+static void show_dijkstra_info(DijkstraState *dstate, ExplainState *es);
+static void show_traversal_info(TraversalInstrumentation *ti,
+					ExplainState *es);
 static void show_tidbitmap_info(BitmapHeapScanState *planstate,
 					ExplainState *es);
 static void show_instrumentation_count(const char *qlabel, int which,
@@ -1822,6 +1825,9 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			if (plan->qual)
 				show_instrumentation_count("Rows Removed by Filter", 2,
 										   planstate, es);
+			if (es->analyze)
+				show_traversal_info(&((NestLoopVLEState *) planstate)->instr,
+									es);
 			break;
 		case T_MergeJoin:
 			show_upper_qual(((MergeJoin *) plan)->mergeclauses,
@@ -1861,6 +1867,9 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			if (plan->qual)
 				show_instrumentation_count("Rows Removed by Filter", 2,
 										   planstate, es);
+			if (es->analyze)
+				show_traversal_info(&((ShortestpathState *) planstate)->instr,
+									es);
 			break;
 		case T_Agg:
 			show_agg_keys(castNode(AggState, planstate), ancestors, es);
@@ -1902,6 +1911,10 @@ ExplainNode(PlanState *planstate, List *ancestors,
 		case T_Hash2Side:
 			show_hash2side_info((Hash2SideState *) planstate, es);
 			break;
+		case T_Dijkstra:
+			if (es->analyze)
+				show_dijkstra_info((DijkstraState *) planstate, es);
+			break;
 		default:
 			break;
 	}
@@ -2836,6 +2849,111 @@ show_hash2side_info(Hash2SideState *hashstate, ExplainState *es)
 			                 spacePeakKb);
 		}
 	}
+
+	if (!es->analyze)
+		return;
+
+	show_traversal_info(&hashstate->instr, es);
+
+	if (es->format != EXPLAIN_FORMAT_TEXT)
+	{
+		ExplainPropertyInteger("Bucket Increases", NULL,
+							   hashstate->bucketIncreases, es);
+		ExplainPropertyInteger("Batch Increases", NULL,
+							   hashstate->batchIncreases, es);
+		ExplainPropertyInteger("Spilled Batches", NULL,
+							   hashstate->spilledBatches, es);
+	}
+	else if (hashstate->bucketIncreases > 0 ||
+			 hashstate->batchIncreases > 0 ||
+			 hashstate->spilledBatches > 0)
+	{
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfo(es->str,
+						 "Hash Growth: buckets=%ld batches=%ld  Spilled Batches: %ld\n",
+						 hashstate->bucketIncreases,
+						 hashstate->batchIncreases,
+						 hashstate->spilledBatches);
+	}
+}
+
+/*
+ * Show the graph projection, the traversal counters and the peak memory of a
+ * Dijkstra node.
+ */
+static void
+show_dijkstra_info(DijkstraState *dstate, ExplainState *es)
+{
+	long		visitedKb = (dstate->visited_peak + 1023) / 1024;
+	long		queueKb = (dstate->pq_peak + 1023) / 1024;
+
+	if (dstate->projection_name != NULL)
+		ExplainPropertyText("Projection", dstate->projection_name, es);
+
+	show_traversal_info(&dstate->instr, es);
+
+	if (es->format != EXPLAIN_FORMAT_TEXT)
+	{
+		ExplainPropertyInteger("Peak Visited Memory Usage", "kB",
+							   visitedKb, es);
+		ExplainPropertyInteger("Peak Queue Memory Usage", "kB",
+							   queueKb, es);
+	}
+	else if (dstate->visited_peak > 0 || dstate->pq_peak > 0)
+	{
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfo(es->str,
+						 "Peak Memory Usage: visited=%ldkB queue=%ldkB\n",
+						 visitedKb, queueKb);
+	}
+}
+
+/*
+ * Show the counters of a graph traversal node. The number of hops and the
+ * frontier sizes are shown only for nodes that traverse hop by hop.
+ */
+static void
+show_traversal_info(TraversalInstrumentation *ti, ExplainState *es)
+{
+	bool		per_hop = (ti->frontier != NULL);
+	int			i;
+
+	if (es->format != EXPLAIN_FORMAT_TEXT)
+	{
+		ExplainPropertyFloat("Vertices Expanded", NULL, ti->nexpanded, 0, es);
+		ExplainPropertyFloat("Edges Examined", NULL, ti->nedges, 0, es);
+		ExplainPropertyFloat("Inner Rescans", NULL, ti->nrescans, 0, es);
+		if (per_hop)
+		{
+			List	   *sizes = NIL;
+
+			ExplainPropertyInteger("Max Depth", NULL, ti->maxdepth, es);
+			for (i = 0; i < ti->nhops; i++)
+				sizes = lappend(sizes, psprintf("%.0f", ti->frontier[i]));
+			ExplainPropertyList("Frontier Sizes", sizes, es);
+		}
+		return;
+	}
+
+	if (ti->nexpanded == 0 && ti->nedges == 0)
+		return;
+
+	appendStringInfoSpaces(es->str, es->indent * 2);
+	appendStringInfo(es->str, "Traversal: expanded=%.0f edges=%.0f rescans=%.0f",
+					 ti->nexpanded, ti->nedges, ti->nrescans);
+	if (per_hop)
+		appendStringInfo(es->str, " depth=%d", ti->maxdepth);
+	appendStringInfoChar(es->str, '\n');
+
+	if (per_hop && ti->nhops > 0)
+	{
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfoString(es->str, "Frontier Sizes:");
+		for (i = 0; i < ti->nhops; i++)
+			appendStringInfo(es->str, "%s %.0f", (i > 0 ? "," : ""),
+							 ti->frontier[i]);
+		appendStringInfoChar(es->str, '\n');
+	}
 }
 
 /*
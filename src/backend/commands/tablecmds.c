@@ -14,6 +14,7 @@
  */
 #include "postgres.h"
 
+#include "ag_const.h"
 #include "access/genam.h"
 #include "access/heapam.h"
 #include "access/heapam_xlog.h"
@@ -90,6 +91,7 @@
 #include "storage/smgr.h"
 #include "utils/acl.h"
 #include "utils/builtins.h"
+#include "utils/cypher_funcs.h"
 #include "utils/fmgroids.h"
 #include "utils/inval.h"
 #include "utils/lsyscache.h"
@@ -475,6 +477,8 @@ static void ATExecEnableRowSecurity(Relation rel);
 static void ATExecDisableRowSecurity(Relation rel);
 static void ATExecForceNoForceRowSecurity(Relation rel, bool force_rls);
 static void ATExecDisableIndex(Relation rel);
+static void ATExecPromoteProperty(AlteredTableInfo *tab, Relation rel,
+					  const char *colName);
 
 static void copy_relation_data(SMgrRelation rel, SMgrRelation dst,
 				   ForkNumber forkNum, char relpersistence);
@@ -3735,6 +3739,10 @@ AlterTableGetLockLevel(List *cmds)
 				cmd_lockmode = AccessShareLock;
 				break;
 
+			case AT_PromoteProperty:
+				cmd_lockmode = AccessExclusiveLock;
+				break;
+
 			default:			/* oops */
 				elog(ERROR, "unrecognized alter table type: %d",
 					 (int) cmd->subtype);
@@ -4086,6 +4094,12 @@ ATPrepCmd(List **wqueue, Relation rel, AlterTableCmd *cmd,
 			ATSimplePermissions(rel, ATT_TABLE);
 			pass = AT_PASS_MISC;
 			break;
+		case AT_PromoteProperty:
+			ATSimplePermissions(rel, ATT_TABLE);
+			/* the column is added to the children as well */
+			ATSimpleRecursion(wqueue, rel, cmd, recurse, lockmode);
+			pass = AT_PASS_COL_ATTRS;
+			break;
 		default:				/* oops */
 			elog(ERROR, "unrecognized alter table type: %d",
 				 (int) cmd->subtype);
@@ -4434,6 +4448,9 @@ ATExecCmd(List **wqueue, AlteredTableInfo *tab, Relation rel,
 		case AT_DisableIndex:
 			ATExecDisableIndex(rel);
 			break;
+		case AT_PromoteProperty:
+			ATExecPromoteProperty(tab, rel, cmd->name);
+			break;
 		case AT_AttachPartition:
 			if (rel->rd_rel->relkind == RELKIND_PARTITIONED_TABLE)
 				ATExecAttachPartition(wqueue, rel, (PartitionCmd *) cmd->def);
@@ -13605,6 +13622,64 @@ ATExecDisableIndex(Relation rel)
 	DisableIndexLabel(rel->rd_id);
 }
 
+/*
+ * ALTER VLABEL/ELABEL PROMOTE PROPERTY
+ *
+ * The column for the property has been added by the preceding ADD COLUMN.
+ * Fill it with the values of the property while the label is rewritten.
+ */
+static void
+ATExecPromoteProperty(AlteredTableInfo *tab, Relation rel,
+					  const char *colName)
+{
+	Oid			relid = RelationGetRelid(rel);
+	AttrNumber	propattnum;
+	AttrNumber	attnum;
+	Form_pg_attribute attr;
+	Oid			collid;
+	Expr	   *expr;
+	NewColumnValue *newval;
+
+	propattnum = get_attnum(relid, AG_ELEM_PROP_MAP);
+	attnum = get_attnum(relid, colName);
+	if (propattnum == InvalidAttrNumber || attnum <= propattnum)
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("cannot promote property \"%s\" of \"%s\"",
+						colName, RelationGetRelationName(rel))));
+
+	attr = TupleDescAttr(RelationGetDescr(rel), attnum - 1);
+	if (!PropertyTypeIsPromotable(attr->atttypid) || attr->atttypmod != -1)
+		ereport(ERROR,
+				(errcode(ERRCODE_DATATYPE_MISMATCH),
+				 errmsg("property cannot be promoted to type %s",
+						format_type_with_typemod(attr->atttypid,
+												 attr->atttypmod))));
+
+	collid = get_typcollation(attr->atttypid);
+
+	/* promote_property(properties, 'key', NULL::type) */
+	expr = (Expr *) makeFuncExpr(F_PROMOTE_PROPERTY, attr->atttypid,
+								 list_make3(makeVar(1, propattnum, JSONBOID,
+													-1, InvalidOid, 0),
+											makeConst(TEXTOID, -1,
+													  DEFAULT_COLLATION_OID,
+													  -1,
+													  CStringGetTextDatum(colName),
+													  false, false),
+											makeNullConst(attr->atttypid, -1,
+														  collid)),
+								 collid, DEFAULT_COLLATION_OID,
+								 COERCE_EXPLICIT_CALL);
+
+	newval = (NewColumnValue *) palloc0(sizeof(NewColumnValue));
+	newval->attnum = attnum;
+	newval->expr = expression_planner(expr);
+
+	tab->newvals = lappend(tab->newvals, newval);
+	tab->rewrite |= AT_REWRITE_DEFAULT_VAL;
+}
+
 /*
  * Preparation phase for SET LOGGED/UNLOGGED
  *
@@ -3582,7 +3582,7 @@ ExecInitCypherListComp(ExprEvalStep *scratch, CypherListCompExpr *listcompexpr,
 	init_step.d.cypherlistcomp_iter.listvalue = scratch->resvalue;
 	init_step.d.cypherlistcomp_iter.listnull = scratch->resnull;
 	init_step.d.cypherlistcomp_iter.listiter =
-		(JsonbIterator **) palloc(sizeof(JsonbIterator *));
+		(JsonbArrayIterator *) palloc(sizeof(JsonbArrayIterator));
 	ExprEvalPushStep(state, &init_step);
 
 	elem_resvalue = (Datum *) palloc(sizeof(Datum));
@@ -3711,6 +3711,9 @@ ExecInitCypherAccess(ExprEvalStep *scratch, CypherAccessExpr *accessexpr,
 	{
 		Node	   *node = lfirst(le);
 
+		path[i].key = NULL;
+		path[i].keyhint = -1;
+
 		if (IsA(node, CypherIndices))
 		{
 			CypherIndices *cind = (CypherIndices *) node;
@@ -3724,6 +3727,23 @@ ExecInitCypherAccess(ExprEvalStep *scratch, CypherAccessExpr *accessexpr,
 			path[i].is_slice = false;
 			MarkCypherIndexResultInvalid(&path[i].lidx);
 			initCypherIndex((Expr *) node, state, &path[i].uidx);
+
+			/*
+			 * Property names (e.g. `.name`) are constant strings. Prepare the
+			 * key once instead of converting it for every row.
+			 */
+			if (IsA(node, Const) && path[i].uidx.type == TEXTOID &&
+				!path[i].uidx.isnull)
+			{
+				char	   *str = TextDatumGetCString(path[i].uidx.value);
+				JsonbValue *key = palloc(sizeof(*key));
+
+				key->type = jbvString;
+				key->val.string.len = strlen(str);
+				key->val.string.val = str;
+
+				path[i].key = key;
+			}
 		}
 
 		i++;
@@ -3744,6 +3764,15 @@ initCypherIndex(Expr *node, ExprState *state, CypherIndexResult *cidxres)
 	{
 		MarkCypherIndexResultInvalid(cidxres);
 	}
+	else if (IsA(node, Const))
+	{
+		Const	   *con = (Const *) node;
+
+		/* no need to evaluate constants for every row */
+		cidxres->type = con->consttype;
+		cidxres->value = con->constvalue;
+		cidxres->isnull = con->constisnull;
+	}
 	else
 	{
 		cidxres->type = exprType((Node *) node);
@@ -1811,99 +1811,35 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 
 		EEO_CASE(EEOP_CYPHERLISTCOMP_BEGIN)
 		{
-			*op->d.cypherlistcomp.liststate = NULL;
-			pushJsonbValue(op->d.cypherlistcomp.liststate,
-						   WJB_BEGIN_ARRAY, NULL);
+			ExecEvalCypherListCompBegin(state, op);
 
 			EEO_NEXT();
 		}
 
 		EEO_CASE(EEOP_CYPHERLISTCOMP_ELEM)
 		{
-			JsonbValue	_ejv;
-			JsonbValue *ejv;
-
-			if (*op->d.cypherlistcomp.elemnull)
-			{
-				_ejv.type = jbvNull;
-				ejv = &_ejv;
-			}
-			else
-			{
-				Jsonb	   *ejb;
-
-				ejb = DatumGetJsonbP(*op->d.cypherlistcomp.elemvalue);
-				if (JB_ROOT_IS_SCALAR(ejb))
-				{
-					ejv = getIthJsonbValueFromContainer(&ejb->root, 0);
-				}
-				else
-				{
-					_ejv.type = jbvBinary;
-					_ejv.val.binary.data = &ejb->root;
-					ejv = &_ejv;
-				}
-			}
-
-			pushJsonbValue(op->d.cypherlistcomp.liststate, WJB_ELEM, ejv);
+			ExecEvalCypherListCompElem(state, op);
 
 			EEO_NEXT();
 		}
 
 		EEO_CASE(EEOP_CYPHERLISTCOMP_END)
 		{
-			JsonbValue *jv;
-
-			jv = pushJsonbValue(op->d.cypherlistcomp.liststate,
-								WJB_END_ARRAY, NULL);
-
-			*op->resvalue = JsonbPGetDatum(JsonbValueToJsonb(jv));
-			*op->resnull = false;
+			ExecEvalCypherListCompEnd(state, op);
 
 			EEO_NEXT();
 		}
 
 		EEO_CASE(EEOP_CYPHERLISTCOMP_ITER_INIT)
 		{
-			Jsonb	   *listjb;
-			JsonbIterator **ji;
-			JsonbValue	jv;
-
-			Assert(!*op->d.cypherlistcomp_iter.listnull);
-
-			listjb = DatumGetJsonbP(*op->d.cypherlistcomp_iter.listvalue);
-			if (!JB_ROOT_IS_ARRAY(listjb) || JB_ROOT_IS_SCALAR(listjb))
-				ereport(ERROR,
-						(errcode(ERRCODE_DATATYPE_MISMATCH),
-						 errmsg("list is expected but %s",
-						 JsonbToCString(NULL, &listjb->root,
-										VARSIZE(listjb)))));
-
-			ji = op->d.cypherlistcomp_iter.listiter;
-			*ji = JsonbIteratorInit(&listjb->root);
-			JsonbIteratorNext(ji, &jv, false);
+			ExecEvalCypherListCompIterInit(state, op);
 
 			EEO_NEXT();
 		}
 
 		EEO_CASE(EEOP_CYPHERLISTCOMP_ITER_NEXT)
 		{
-			JsonbIterator **ji;
-			JsonbValue	jv;
-			JsonbIteratorToken jt;
-
-			ji = op->d.cypherlistcomp_iter.listiter;
-			jt = JsonbIteratorNext(ji, &jv, true);
-			if (jt == WJB_ELEM)
-			{
-				*op->resvalue = JsonbPGetDatum(JsonbValueToJsonb(&jv));
-				*op->resnull = false;
-			}
-			else
-			{
-				*op->resvalue = (Datum) 0;
-				*op->resnull = true;
-			}
+			ExecEvalCypherListCompIterNext(state, op);
 
 			EEO_NEXT();
 		}
@@ -4618,6 +4554,95 @@ ExecEvalCypherListExpr(ExprState *state, ExprEvalStep *op)
 	*op->resnull = false;
 }
 
+/*
+ * Steps of list comprehension. They are out of line so that JIT-compiled
+ * expressions can call them as well.
+ */
+void
+ExecEvalCypherListCompBegin(ExprState *state, ExprEvalStep *op)
+{
+	*op->d.cypherlistcomp.liststate = NULL;
+	pushJsonbValue(op->d.cypherlistcomp.liststate, WJB_BEGIN_ARRAY, NULL);
+}
+
+void
+ExecEvalCypherListCompElem(ExprState *state, ExprEvalStep *op)
+{
+	JsonbValue	_ejv;
+	JsonbValue *ejv;
+
+	if (*op->d.cypherlistcomp.elemnull)
+	{
+		_ejv.type = jbvNull;
+		ejv = &_ejv;
+	}
+	else
+	{
+		Jsonb	   *ejb;
+
+		ejb = DatumGetJsonbP(*op->d.cypherlistcomp.elemvalue);
+		if (JB_ROOT_IS_SCALAR(ejb))
+		{
+			ejv = getIthJsonbValueFromContainer(&ejb->root, 0);
+		}
+		else
+		{
+			_ejv.type = jbvBinary;
+			_ejv.val.binary.data = &ejb->root;
+			ejv = &_ejv;
+		}
+	}
+
+	pushJsonbValue(op->d.cypherlistcomp.liststate, WJB_ELEM, ejv);
+}
+
+void
+ExecEvalCypherListCompEnd(ExprState *state, ExprEvalStep *op)
+{
+	JsonbValue *jv;
+
+	jv = pushJsonbValue(op->d.cypherlistcomp.liststate, WJB_END_ARRAY, NULL);
+
+	*op->resvalue = JsonbPGetDatum(JsonbValueToJsonb(jv));
+	*op->resnull = false;
+}
+
+void
+ExecEvalCypherListCompIterInit(ExprState *state, ExprEvalStep *op)
+{
+	Jsonb	   *listjb;
+
+	Assert(!*op->d.cypherlistcomp_iter.listnull);
+
+	listjb = DatumGetJsonbP(*op->d.cypherlistcomp_iter.listvalue);
+	if (!JB_ROOT_IS_ARRAY(listjb) || JB_ROOT_IS_SCALAR(listjb))
+		ereport(ERROR,
+				(errcode(ERRCODE_DATATYPE_MISMATCH),
+				 errmsg("list is expected but %s",
+						JsonbToCString(NULL, &listjb->root,
+									   VARSIZE(listjb)))));
+
+	JsonbArrayIteratorInit(op->d.cypherlistcomp_iter.listiter, &listjb->root);
+}
+
+void
+ExecEvalCypherListCompIterNext(ExprState *state, ExprEvalStep *op)
+{
+	JsonbValue *jv;
+
+	jv = JsonbArrayIteratorNext(op->d.cypherlistcomp_iter.listiter);
+	if (jv != NULL)
+	{
+		*op->resvalue = JsonbPGetDatum(JsonbValueToJsonb(jv));
+		*op->resnull = false;
+	}
+	else
+	{
+		*op->resvalue = (Datum) 0;
+		*op->resnull = true;
+	}
+}
+
 void
 ExecEvalCypherAccessExpr(ExprState *state, ExprEvalStep *op)
 {
@@ -4639,24 +4664,47 @@ ExecEvalCypherAccessExpr(ExprState *state, ExprEvalStep *op)
 		return;
 	}
 
-	argjb = DatumGetJsonbP(*op->d.cypheraccessexpr.argvalue);
-	if (JB_ROOT_IS_SCALAR(argjb))
+	path = op->d.cypheraccessexpr.path;
+	pathlen = op->d.cypheraccessexpr.pathlen;
+	Assert(pathlen > 0);
+
+	/*
+	 * If the map is stored out of line (e.g. large properties) and the first
+	 * key is a constant, fetch only the parts of it needed to find the key.
+	 */
+	if (path[0].key != NULL &&
+		findJsonbValueFromToast((struct varlena *)
+								DatumGetPointer(*op->d.cypheraccessexpr.argvalue),
+								path[0].key, &vjv))
 	{
-		vjv = getIthJsonbValueFromContainer(&argjb->root, 0);
+		if (vjv == NULL)
+		{
+			*op->resvalue = (Datum) 0;
+			*op->resnull = true;
+			return;
+		}
+
+		i = 1;
 	}
 	else
 	{
-		_vjv.type = jbvBinary;
-		_vjv.val.binary.len = argjb->vl_len_;
-		_vjv.val.binary.data = &argjb->root;
-		vjv = &_vjv;
-	}
+		argjb = DatumGetJsonbP(*op->d.cypheraccessexpr.argvalue);
+		if (JB_ROOT_IS_SCALAR(argjb))
+		{
+			vjv = getIthJsonbValueFromContainer(&argjb->root, 0);
+		}
+		else
+		{
+			_vjv.type = jbvBinary;
+			_vjv.val.binary.len = argjb->vl_len_;
+			_vjv.val.binary.data = &argjb->root;
+			vjv = &_vjv;
+		}
 
-	path = op->d.cypheraccessexpr.path;
-	pathlen = op->d.cypheraccessexpr.pathlen;
-	Assert(pathlen > 0);
+		i = 0;
+	}
 
-	for (i = 0; i < pathlen; i++)
+	for (; i < pathlen; i++)
 	{
 		switch (vjv->type)
 		{
@@ -4740,6 +4788,16 @@ cypher_access_object(JsonbContainer *container, CypherAccessPathElem *pathelem)
 		return NULL;
 	}
 
+	if (pathelem->key != NULL)
+	{
+		if (findJsonbObjectValueWithHint(container, pathelem->key,
+										 &pathelem->keyhint,
+										 &pathelem->keyvalue))
+			return &pathelem->keyvalue;
+
+		return NULL;
+	}
+
 	key = &pathelem->uidx;
 	if (key->isnull)
 	{
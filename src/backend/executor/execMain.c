@@ -58,6 +58,7 @@
 #include "storage/lmgr.h"
 #include "tcop/utility.h"
 #include "utils/acl.h"
+#include "utils/graphprojection.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/partcache.h"
@@ -1325,6 +1326,9 @@ InitResultRelInfo(ResultRelInfo *resultRelInfo,
 {
 	List	   *partition_check = NIL;
 
+	/* graph projections of the relation are stale from now on */
+	GraphProjectionRelationModified(RelationGetRelid(resultRelationDesc));
+
 	MemSet(resultRelInfo, 0, sizeof(ResultRelInfo));
 	resultRelInfo->type = T_ResultRelInfo;
 	resultRelInfo->ri_RangeTableIndex = resultRelationIndex;
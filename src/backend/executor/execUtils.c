@@ -61,6 +61,7 @@
 
 static bool tlist_matches_tupdesc(PlanState *ps, List *tlist, Index varno, TupleDesc tupdesc);
 static void ShutdownExprContext(ExprContext *econtext, bool isCommit);
+static bool label_graph_walker(PlanState *planstate, Oid *graphoid);
 
 
 /* ----------------------------------------------------------------
@@ -1162,3 +1163,57 @@ InitScanLabelInfo(ScanState *node)
 		ReleaseSysCache(labtup);
 	}
 }
+
+/*
+ * Find the graph of the labels that the plan scans, or InvalidOid if it scans
+ * no label. Graph traversals use it to find the labels of the vertices they
+ * visit. graph_path is of no use for that, since it may have been changed
+ * after the plan was made.
+ */
+Oid
+ExecGetLabelGraphOid(PlanState *planstate)
+{
+	Oid			graphoid = InvalidOid;
+
+	label_graph_walker(planstate, &graphoid);
+
+	return graphoid;
+}
+
+static bool
+label_graph_walker(PlanState *planstate, Oid *graphoid)
+{
+	if (planstate == NULL)
+		return false;
+
+	switch (nodeTag(planstate))
+	{
+		case T_SeqScanState:
+		case T_SampleScanState:
+		case T_IndexScanState:
+		case T_IndexOnlyScanState:
+		case T_BitmapHeapScanState:
+		case T_TidScanState:
+			{
+				Relation	rel = ((ScanState *) planstate)->ss_currentRelation;
+				HeapTuple	labtup;
+
+				if (rel == NULL)
+					break;
+
+				labtup = SearchSysCache1(LABELRELID,
+										 ObjectIdGetDatum(RelationGetRelid(rel)));
+				if (HeapTupleIsValid(labtup))
+				{
+					*graphoid = ((Form_ag_label) GETSTRUCT(labtup))->graphid;
+					ReleaseSysCache(labtup);
+					return true;
+				}
+			}
+			break;
+		default:
+			break;
+	}
+
+	return planstate_tree_walker(planstate, label_graph_walker, graphoid);
+}
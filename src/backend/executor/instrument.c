@@ -188,6 +188,49 @@ InstrAccumParallelQuery(BufferUsage *result)
 	BufferUsageAdd(&pgBufferUsage, result);
 }
 
+/*
+ * Set up counters of a graph traversal node. If per_hop is true, the number
+ * of vertices expanded at each hop is counted too; the array for it is
+ * allocated in the current memory context, so this should be called at node
+ * initialization.
+ */
+void
+InstrInitTraversal(TraversalInstrumentation *ti, bool per_hop)
+{
+	memset(ti, 0, sizeof(TraversalInstrumentation));
+	if (per_hop)
+	{
+		ti->maxhops = 8;
+		ti->frontier = palloc0(ti->maxhops * sizeof(double));
+	}
+}
+
+/* count a vertex expanded to find the edges of the given hop (1-based) */
+void
+InstrCountExpansion(TraversalInstrumentation *ti, int hop)
+{
+	ti->nexpanded += 1;
+
+	if (ti->frontier == NULL || hop < 1)
+		return;
+
+	if (hop > ti->maxhops)
+	{
+		int			newmax = ti->maxhops;
+
+		while (hop > newmax)
+			newmax *= 2;
+		ti->frontier = repalloc(ti->frontier, newmax * sizeof(double));
+		memset(ti->frontier + ti->maxhops, 0,
+			   (newmax - ti->maxhops) * sizeof(double));
+		ti->maxhops = newmax;
+	}
+
+	ti->frontier[hop - 1] += 1;
+	if (hop > ti->nhops)
+		ti->nhops = hop;
+}
+
 /* dst += add */
 static void
 BufferUsageAdd(BufferUsage *dst, const BufferUsage *add)
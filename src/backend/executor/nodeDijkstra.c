@@ -27,10 +27,13 @@
 #include "executor/tuptable.h"
 #include "funcapi.h"
 #include "lib/pairingheap.h"
+#include "miscadmin.h"
 #include "nodes/execnodes.h"
 #include "nodes/memnodes.h"
+#include "pgstat.h"
 #include "utils/array.h"
 #include "utils/graph.h"
+#include "utils/graphprojection.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/typcache.h"
@@ -299,6 +302,119 @@ compute_limit(DijkstraState *node)
 	}
 }
 
+/*
+ * Relax the edge eid that goes from frontier to the vertex to.
+ */
+static void
+relax_edge(DijkstraState *node, vnode *frontier, Graphid to, Graphid eid,
+		   double weight)
+{
+	double		new_weight;
+	vnode	   *neighbor;
+	bool		found;
+	MemoryContext oldcxt;
+
+	if (weight < 0.0)
+		ereport(ERROR,
+				(errcode(ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE),
+				 errmsg("WEIGHT must be larger than 0")));
+
+	node->instr.nedges += 1;
+
+	new_weight = frontier->weight + weight;
+
+	neighbor = (vnode *) hash_search(node->visited_nodes, &to, HASH_ENTER,
+									 &found);
+
+	/* the lists of incoming edges belong to the visited vertices */
+	oldcxt = MemoryContextSwitchTo(node->visited_mcxt);
+
+	if (!found)
+	{
+		pq_add(node->pq, node->pq_mcxt, to, new_weight);
+
+		neighbor->incoming_enodes = NIL;
+		vnode_add_enode(neighbor, new_weight, eid, frontier);
+	}
+	else if (new_weight < neighbor->weight)
+	{
+		pq_add(node->pq, node->pq_mcxt, to, new_weight);
+
+		vnode_update_enode(neighbor, new_weight, eid, frontier);
+	}
+	else if (node->max_n > 1 && new_weight == neighbor->weight)
+	{
+		/* add a same weight edge */
+		vnode_add_enode(neighbor, new_weight, eid, frontier);
+	}
+
+	MemoryContextSwitchTo(oldcxt);
+}
+
+/*
+ * Relax the edges of frontier from the adjacency lists of the graph
+ * projection instead of scanning the edge label.
+ */
+static void
+relax_projection_edges(DijkstraState *node, vnode *frontier)
+{
+	Dijkstra   *plan = (Dijkstra *) node->ps.plan;
+	GraphCSR   *csr = node->projection;
+	int64		v;
+	int64		i;
+
+	v = graph_csr_ordinal(csr, frontier->id);
+	if (v < 0)
+		return;
+
+	if (plan->direction != CYPHER_REL_DIR_LEFT)
+	{
+		for (i = csr->out_off[v]; i < csr->out_off[v + 1]; i++)
+			relax_edge(node, frontier, csr->vertices[csr->out_adj[i]],
+					   csr->out_eid[i], csr->out_weight[i]);
+	}
+
+	if (plan->direction != CYPHER_REL_DIR_RIGHT)
+	{
+		for (i = csr->in_off[v]; i < csr->in_off[v + 1]; i++)
+			relax_edge(node, frontier, csr->vertices[csr->in_adj[i]],
+					   csr->in_eid[i], csr->in_weight[i]);
+	}
+}
+
+/*
+ * Remember the peak memory of the visited vertices and the priority queue.
+ * Both only grow while a search runs, so this is called when it ends.
+ */
+static void
+update_memory_peak(DijkstraState *node)
+{
+	Size		size;
+
+	size = MemoryContextMemAllocated(node->visited_mcxt, true);
+	if (size > node->visited_peak)
+		node->visited_peak = size;
+
+	size = MemoryContextMemAllocated(node->pq_mcxt, true);
+	if (size > node->pq_peak)
+		node->pq_peak = size;
+}
+
+/*
+ * Create the hash table of visited vertices.
+ */
+static HTAB *
+create_visited_nodes(DijkstraState *node)
+{
+	HASHCTL		hash_ctl;
+
+	hash_ctl.keysize = sizeof(Graphid);
+	hash_ctl.entrysize = sizeof(vnode);
+	hash_ctl.hcxt = node->visited_mcxt;
+	return hash_create("dijkstra's visited nodes", 1024, &hash_ctl,
+					   HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+}
+
 /*
  * Helper function to replace the graphid portion of a vertex
  * row. It requires the vertex row and tuple descriptor be non NULL and
@@ -344,6 +460,7 @@ ExecDijkstra(PlanState *pstate)
 	dijkstra_pq_entry *start_node;
 	Datum		end_vid;
 	vnode	   *vertex;
+	MemoryContext oldcxt;
 
 	dijkstra = (Dijkstra *) node->ps.plan;
 	outerPlan = outerPlanState(node);
@@ -377,7 +494,9 @@ ExecDijkstra(PlanState *pstate)
 	vertex = hash_search(node->visited_nodes, &start_node->to, HASH_ENTER,
 						 NULL);
 	vertex->incoming_enodes = NIL;
+	oldcxt = MemoryContextSwitchTo(node->visited_mcxt);
 	vnode_add_enode(vertex, 0.0, -1, NULL);
+	MemoryContextSwitchTo(oldcxt);
 
 	while (!pairingheap_is_empty(node->pq))
 	{
@@ -390,12 +509,27 @@ ExecDijkstra(PlanState *pstate)
 
 		min_pq_entry = (dijkstra_pq_entry *) pairingheap_remove_first(node->pq);
 		if (min_pq_entry->to == node->target_id)
+		{
+			update_memory_peak(node);
 			return proj_path(node);
+		}
 
 		frontier = (vnode *) hash_search(node->visited_nodes,
 										 &min_pq_entry->to, HASH_FIND, &found);
 		Assert(found);
 
+		InstrCountExpansion(&node->instr, 0);
+		agstat_count_vertex_expand(node->graphoid, min_pq_entry->to);
+
+		if (node->projection != NULL)
+		{
+			CHECK_FOR_INTERRUPTS();
+
+			pfree(min_pq_entry);
+			relax_projection_edges(node, frontier);
+			continue;
+		}
+
 		if (IsA(node->source->expr, FieldSelect))
 			paramno = ((Param *) ((FieldSelect *) node->source->expr)->arg)->paramid;
 		else
@@ -417,6 +551,7 @@ ExecDijkstra(PlanState *pstate)
 
 		outerPlan->chgParam = bms_add_member(outerPlan->chgParam, paramno);
 		ExecReScan(outerPlan);
+		node->instr.nrescans += 1;
 
 		pfree(min_pq_entry);
 
@@ -425,52 +560,17 @@ ExecDijkstra(PlanState *pstate)
 			Datum		to;
 			Datum		eid;
 			Datum		weight;
-			Graphid		to_val;
-			Graphid		eid_val;
-			double		weight_val;
-			double		new_weight;
-			vnode	   *neighbor;
 
 			outerTupleSlot = ExecProcNode(outerPlan);
 			if (TupIsNull(outerTupleSlot))
 				break;
 
 			to = slot_getattr(outerTupleSlot, dijkstra->end_id, &is_null);
-			to_val = DatumGetGraphid(to);
-
 			eid = slot_getattr(outerTupleSlot, dijkstra->edge_id, &is_null);
-			eid_val = DatumGetGraphid(eid);
-
 			weight = slot_getattr(outerTupleSlot, dijkstra->weight, &is_null);
-			weight_val = DatumGetFloat8(weight);
-			if (weight_val < 0.0)
-				ereport(ERROR,
-						(errcode(ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE),
-						 errmsg("WEIGHT must be larger than 0")));
-
-			new_weight = frontier->weight + weight_val;
-
-			neighbor = (vnode *) hash_search(node->visited_nodes, &to_val,
-											 HASH_ENTER, &found);
-
-			if (!found)
-			{
-				pq_add(node->pq, node->pq_mcxt, to_val, new_weight);
-
-				neighbor->incoming_enodes = NIL;
-				vnode_add_enode(neighbor, new_weight, eid_val, frontier);
-			}
-			else if (new_weight < neighbor->weight)
-			{
-				pq_add(node->pq, node->pq_mcxt, to_val, new_weight);
-
-				vnode_update_enode(neighbor, new_weight, eid_val, frontier);
-			}
-			else if (node->max_n > 1 && new_weight == neighbor->weight)
-			{
-				/* add a same weight edge */
-				vnode_add_enode(neighbor, new_weight, eid_val, frontier);
-			}
+
+			relax_edge(node, frontier, DatumGetGraphid(to),
+					   DatumGetGraphid(eid), DatumGetFloat8(weight));
 		}
 
 		/*
@@ -479,6 +579,8 @@ ExecDijkstra(PlanState *pstate)
 		prm->value = orig_param;
 	}
 
+	update_memory_peak(node);
+
 	node->n = node->max_n;
 	return NULL;
 }
@@ -487,7 +589,6 @@ DijkstraState *
 ExecInitDijkstra(Dijkstra *node, EState *estate, int eflags)
 {
 	DijkstraState *dstate;
-	HASHCTL		hash_ctl;
 	PlanState  *outerPlan;
 
 	/* check for unsupported flags */
@@ -513,22 +614,41 @@ ExecInitDijkstra(Dijkstra *node, EState *estate, int eflags)
 	dstate->pq_mcxt = AllocSetContextCreate(CurrentMemoryContext,
 											"dijkstra's priority queue",
 											ALLOCSET_DEFAULT_SIZES);
-	hash_ctl.keysize = sizeof(Graphid);
-	hash_ctl.entrysize = sizeof(vnode);
-	hash_ctl.hcxt = CurrentMemoryContext;
-	dstate->visited_nodes = hash_create("dijkstra's visited nodes",
-										1024, &hash_ctl,
-										HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	dstate->visited_mcxt = AllocSetContextCreate(CurrentMemoryContext,
+												 "dijkstra's visited nodes",
+												 ALLOCSET_SMALL_SIZES);
+	dstate->visited_nodes = create_visited_nodes(dstate);
+	InstrInitTraversal(&dstate->instr, false);
+	dstate->visited_peak = 0;
+	dstate->pq_peak = 0;
 
 	dstate->source = ExecInitExpr((Expr *) node->source, (PlanState *) dstate);
 	dstate->target = ExecInitExpr((Expr *) node->target, (PlanState *) dstate);
 	dstate->limit = ExecInitExpr((Expr *) node->limit, (PlanState *) dstate);
 
+	/* use a graph projection of the edges if there is a usable one */
+	dstate->projection = NULL;
+	dstate->projection_name = NULL;
+	if (OidIsValid(node->elabel) && !(eflags & EXEC_FLAG_EXPLAIN_ONLY))
+	{
+		GraphCSR	csr;
+
+		if (GetGraphProjection(node->elabel, node->weight_key,
+							   estate->es_snapshot, CurrentMemoryContext,
+							   &csr, &dstate->projection_name))
+		{
+			dstate->projection = palloc(sizeof(GraphCSR));
+			*dstate->projection = csr;
+		}
+	}
+
 	/*
 	 * initialize child nodes
 	 */
 	outerPlan = ExecInitNode(outerPlan(node), estate, eflags);
 	outerPlanState(dstate) = outerPlan;
+	dstate->graphoid = pgstat_track_counts ?
+		ExecGetLabelGraphOid(outerPlan) : InvalidOid;
 
 	/*
 	 * tuple table initialization
@@ -603,7 +723,6 @@ void
 ExecReScanDijkstra(DijkstraState *node)
 {
 	PlanState  *outerPlan = outerPlanState(node);
-	HASHCTL		hash_ctl;
 
 	compute_limit(node);
 
@@ -619,12 +738,8 @@ ExecReScanDijkstra(DijkstraState *node)
 
 	/* reset hash table and priority queue */
 	hash_destroy(node->visited_nodes);
-	hash_ctl.keysize = sizeof(Graphid);
-	hash_ctl.entrysize = sizeof(vnode);
-	hash_ctl.hcxt = CurrentMemoryContext;
-	node->visited_nodes = hash_create("dijkstra's visited nodes",
-									  1024, &hash_ctl,
-									  HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	MemoryContextReset(node->visited_mcxt);
+	node->visited_nodes = create_visited_nodes(node);
 	MemoryContextReset(node->pq_mcxt);
 	pairingheap_reset(node->pq);
 
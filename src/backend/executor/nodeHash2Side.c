@@ -41,7 +41,8 @@
 #include "utils/syscache.h"
 
 
-static void ExecHash2SideIncreaseNumBatches(HashJoinTable hashtable);
+static void ExecHash2SideIncreaseNumBatches(HashJoinTable hashtable,
+								Hash2SideState *node);
 
 static void *dense_alloc(HashJoinTable hashtable, Size size);
 
@@ -200,6 +201,10 @@ ExecInitHash2Side(Hash2Side *node, EState *estate, int eflags)
 	hashstate->totalPaths = 0;
 	hashstate->hops = 0;
 	hashstate->spacePeak = 0;
+	InstrInitTraversal(&hashstate->instr, false);
+	hashstate->bucketIncreases = 0;
+	hashstate->batchIncreases = 0;
+	hashstate->spilledBatches = 0;
 
 	/*
 	 * Miscellaneous initialization
@@ -708,7 +713,7 @@ ExecHash2SideTableDestroy(HashJoinTable hashtable)
  *		current memory consumption
  */
 static void
-ExecHash2SideIncreaseNumBatches(HashJoinTable hashtable)
+ExecHash2SideIncreaseNumBatches(HashJoinTable hashtable, Hash2SideState *node)
 {
 	int			oldnbatch = hashtable->nbatch;
 	int			curbatch = hashtable->curbatch;
@@ -729,6 +734,8 @@ ExecHash2SideIncreaseNumBatches(HashJoinTable hashtable)
 	nbatch = oldnbatch * 2;
 	Assert(nbatch > 1);
 
+	node->batchIncreases++;
+
 #ifdef HJDEBUG
 	printf("Shortestpath %p: increasing nbatch to %d because space = %zu\n",
 		   hashtable, nbatch, hashtable->spaceUsed);
@@ -828,6 +835,8 @@ ExecHash2SideIncreaseNumBatches(HashJoinTable hashtable)
 			{
 				/* dump it out */
 				Assert(batchno > curbatch);
+				if (hashtable->innerBatchFile[batchno] == NULL)
+					node->spilledBatches++;
 				ExecShortestpathSaveTuple(HJTUPLE_MINTUPLE(hashTuple),
 										  hashTuple->hashvalue,
 										  &hashtable->innerBatchFile[batchno]);
@@ -893,6 +902,7 @@ ExecHash2SideIncreaseNumBuckets(HashJoinTable hashtable, Hash2SideState *node)
 
 	hashtable->nbuckets = hashtable->nbuckets_optimal;
 	hashtable->log2_nbuckets = hashtable->log2_nbuckets_optimal;
+	node->bucketIncreases++;
 
 	Assert(hashtable->nbuckets > 1);
 	Assert(hashtable->nbuckets <= (INT_MAX / 2));
@@ -1116,7 +1126,7 @@ ExecHash2SideTableInsertTuple(HashJoinTable hashtable,
 		if (hashtable->spaceUsed +
 			hashtable->nbuckets_optimal * sizeof(HashJoinTuple)
 			> hashtable->spaceAllowed)
-			ExecHash2SideIncreaseNumBatches(hashtable);
+			ExecHash2SideIncreaseNumBatches(hashtable, node);
 	}
 	else
 	{
@@ -1124,6 +1134,8 @@ ExecHash2SideTableInsertTuple(HashJoinTable hashtable,
 		 * put the tuple into a temp file for later batches
 		 */
 		Assert(batchno > hashtable->curbatch);
+		if (hashtable->innerBatchFile[batchno] == NULL)
+			node->spilledBatches++;
 		ExecShortestpathSaveTuple(tuple,
 								  hashvalue,
 								  &hashtable->innerBatchFile[batchno]);
@@ -25,6 +25,7 @@
 #include "pgstat.h"
 #include "utils/arrayaccess.h"
 #include "utils/builtins.h"
+#include "utils/cypher_funcs.h"
 #include "utils/datum.h"
 #include "utils/graph.h"
 #include "utils/jsonb.h"
@@ -90,6 +91,7 @@ static Datum makeModifiedElem(Datum elem, Oid elemtype,
 static TupleTableSlot *ExecMergeGraph(ModifyGraphState *mgstate,
 									  TupleTableSlot *slot);
 static bool isMatchedMergePattern(PlanState *planstate);
+static void countMergeMatch(GraphPath *path);
 static TupleTableSlot *createMergePath(ModifyGraphState *mgstate,
 									   GraphPath *path, TupleTableSlot *slot);
 static Datum createMergeVertex(ModifyGraphState *mgstate,
@@ -114,6 +116,9 @@ static Datum findEdge(TupleTableSlot *slot, GraphEdge *node, Graphid *eid);
 static AttrNumber findAttrInSlotByName(TupleTableSlot *slot, char *name);
 static void setSlotValueByName(TupleTableSlot *slot, Datum value, char *name);
 static void setSlotValueByAttnum(TupleTableSlot *slot, Datum value, int attnum);
+static void fillPromotedProperties(ModifyGraphState *mgstate,
+								   ResultRelInfo *resultRelInfo,
+								   TupleTableSlot *slot, int propattnum);
 static Datum *makeDatumArray(ExprContext *econtext, int len);
 
 /* global variable - see postgres.c */
@@ -173,6 +178,8 @@ ExecInitModifyGraph(ModifyGraph *mgplan, EState *estate, int eflags)
 		ParseState *pstate;
 		ResultRelInfo *resultRelInfo;
 		ListCell   *lt;
+		int			i;
+
 		/*
 		 * RTEs need to be added to the es_range_table using the
 		 * proper memory context due to cached plans. So, we need to
@@ -283,6 +290,11 @@ ExecInitModifyGraph(ModifyGraph *mgplan, EState *estate, int eflags)
 		mgstate->resultRelations = resultRelInfos;
 		mgstate->numResultRelations = numResultRelInfo;
 
+		mgstate->promotedProps = palloc(numResultRelInfo * sizeof(List *));
+		for (i = 0; i < numResultRelInfo; i++)
+			mgstate->promotedProps[i] =
+				RelationGetPromotedProperties(resultRelInfos[i].ri_RelationDesc);
+
 		/* es_result_relation_info is NULL except ModifyTable case */
 		estate->es_result_relation_info = NULL;
 
@@ -771,6 +783,8 @@ createVertex(ModifyGraphState *mgstate, GraphVertex *gvertex, Graphid *vid,
 	elemTupleSlot->tts_values[1] = vertexProp;
 	MemSet(elemTupleSlot->tts_isnull, false,
 		   elemTupleSlot->tts_tupleDescriptor->natts * sizeof(bool));
+	fillPromotedProperties(mgstate, resultRelInfo, elemTupleSlot,
+						   Anum_vertex_properties);
 	ExecStoreVirtualTuple(elemTupleSlot);
 
 	tuple = ExecMaterializeSlot(elemTupleSlot);
@@ -851,6 +865,8 @@ createEdge(ModifyGraphState *mgstate, GraphEdge *gedge, Graphid start,
 	elemTupleSlot->tts_values[3] = edgeProp;
 	MemSet(elemTupleSlot->tts_isnull, false,
 		   elemTupleSlot->tts_tupleDescriptor->natts * sizeof(bool));
+	fillPromotedProperties(mgstate, resultRelInfo, elemTupleSlot,
+						   Anum_edge_properties);
 	ExecStoreVirtualTuple(elemTupleSlot);
 
 	tuple = ExecMaterializeSlot(elemTupleSlot);
@@ -1285,6 +1301,9 @@ updateElemProp(ModifyGraphState *mgstate, Oid elemtype, Datum gid,
 	}
 	MemSet(elemTupleSlot->tts_isnull, false,
 		   elemTupleSlot->tts_tupleDescriptor->natts * sizeof(bool));
+	fillPromotedProperties(mgstate, resultRelInfo, elemTupleSlot,
+						   elemtype == VERTEXOID ? Anum_vertex_properties :
+												   Anum_edge_properties);
 	ExecStoreVirtualTuple(elemTupleSlot);
 
 	tuple = ExecMaterializeSlot(elemTupleSlot);
@@ -1365,6 +1384,8 @@ ExecMergeGraph(ModifyGraphState *mgstate, TupleTableSlot *slot)
 
 	if (isMatchedMergePattern(mgstate->subplan))
 	{
+		countMergeMatch(path);
+
 		if (mgstate->sets != NIL)
 			slot = ExecSetGraph(mgstate, GSP_ON_MATCH, slot);
 	}
@@ -1394,6 +1415,23 @@ isMatchedMergePattern(PlanState *planstate)
 	return ((NestLoopState *) planstate)->nl_MatchedOuter;
 }
 
+/* count the elements of the matched pattern against their labels */
+static void
+countMergeMatch(GraphPath *path)
+{
+	ListCell   *le;
+
+	foreach(le, path->chain)
+	{
+		Node	   *elem = (Node *) lfirst(le);
+
+		if (IsA(elem, GraphVertex))
+			agstat_count_merge_match(((GraphVertex *) elem)->relid);
+		else
+			agstat_count_merge_match(((GraphEdge *) elem)->relid);
+	}
+}
+
 static TupleTableSlot *
 createMergePath(ModifyGraphState *mgstate, GraphPath *path,
 				TupleTableSlot *slot)
@@ -1529,6 +1567,8 @@ createMergeVertex(ModifyGraphState *mgstate, GraphVertex *gvertex,
 	insertSlot->tts_values[1] = vertexProp;
 	MemSet(insertSlot->tts_isnull, false,
 		   insertSlot->tts_tupleDescriptor->natts * sizeof(bool));
+	fillPromotedProperties(mgstate, resultRelInfo, insertSlot,
+						   Anum_vertex_properties);
 	ExecStoreVirtualTuple(insertSlot);
 
 	tuple = ExecMaterializeSlot(insertSlot);
@@ -1553,6 +1593,7 @@ createMergeVertex(ModifyGraphState *mgstate, GraphVertex *gvertex,
 		setSlotValueByAttnum(slot, vertex, gvertex->resno);
 
 	graphWriteStats.insertVertex++;
+	pgstat_count_graph_merge_create(resultRelInfo->ri_RelationDesc);
 
 	estate->es_result_relation_info = savedResultRelInfo;
 
@@ -1599,6 +1640,8 @@ createMergeEdge(ModifyGraphState *mgstate, GraphEdge *gedge, Graphid start,
 	insertSlot->tts_values[3] = edgeProp;
 	MemSet(insertSlot->tts_isnull, false,
 		   insertSlot->tts_tupleDescriptor->natts * sizeof(bool));
+	fillPromotedProperties(mgstate, resultRelInfo, insertSlot,
+						   Anum_edge_properties);
 	ExecStoreVirtualTuple(insertSlot);
 
 	tuple = ExecMaterializeSlot(insertSlot);
@@ -1626,6 +1669,7 @@ createMergeEdge(ModifyGraphState *mgstate, GraphEdge *gedge, Graphid start,
 		setSlotValueByAttnum(slot, edge, gedge->resno);
 
 	graphWriteStats.insertEdge++;
+	pgstat_count_graph_merge_create(resultRelInfo->ri_RelationDesc);
 
 	estate->es_result_relation_info = savedResultRelInfo;
 
@@ -2076,6 +2120,46 @@ setSlotValueByAttnum(TupleTableSlot *slot, Datum value, int attnum)
 	slot->tts_isnull[attnum - 1] = (value == (Datum) 0) ? true : false;
 }
 
+/*
+ * Set the promoted properties (see ALTER VLABEL ... PROMOTE PROPERTY) of the
+ * label of resultRelInfo from the property map in the slot. Any other
+ * attributes after `properties` are set to NULL.
+ */
+static void
+fillPromotedProperties(ModifyGraphState *mgstate,
+					   ResultRelInfo *resultRelInfo, TupleTableSlot *slot,
+					   int propattnum)
+{
+	TupleDesc	tupdesc = slot->tts_tupleDescriptor;
+	List	   *promoted;
+	Jsonb	   *props;
+	ListCell   *lc;
+	int			i;
+
+	if (tupdesc->natts <= propattnum)
+		return;
+
+	for (i = propattnum; i < tupdesc->natts; i++)
+		slot->tts_isnull[i] = true;
+
+	promoted = mgstate->promotedProps[resultRelInfo -
+									  mgstate->resultRelations];
+	if (promoted == NIL)
+		return;
+
+	props = DatumGetJsonbP(slot->tts_values[propattnum - 1]);
+
+	foreach(lc, promoted)
+	{
+		PromotedProperty *prop = lfirst(lc);
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, prop->attnum - 1);
+
+		slot->tts_values[prop->attnum - 1] =
+			getPromotedPropertyDatum(props, prop->key, attr->atttypid,
+									 &slot->tts_isnull[prop->attnum - 1]);
+	}
+}
+
 static Datum *
 makeDatumArray(ExprContext *econtext, int len)
 {
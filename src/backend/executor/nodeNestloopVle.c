@@ -25,6 +25,7 @@
 #include "fmgr.h"
 #include "miscadmin.h"
 #include "nodes/pg_list.h"
+#include "pgstat.h"
 #include "utils/array.h"
 #include "utils/datum.h"
 #include "utils/graph.h"
@@ -55,6 +56,8 @@ typedef struct NestLoopVLEContext
 static int getInitialCurhops(NestLoopVLE *node);
 static bool canFollowEdge(NestLoopVLEState *node);
 static bool needResult(NestLoopVLEState *node);
+/* instrumentation */
+static void countExpansion(NestLoopVLEState *node);
 /* result values */
 static void pushPathElementOuter(NestLoopVLEState *node, TupleTableSlot *slot);
 static void pushPathElementInner(NestLoopVLEState *node, TupleTableSlot *slot);
@@ -148,6 +151,10 @@ ExecNestLoopVLE(PlanState *pstate)
 				return NULL;
 			}
 
+			/* the outer tuple has the first edge unless it is zero-length */
+			if (node->curhops > 0)
+				node->instr.nedges += 1;
+
 			if (canFollowEdge(node))
 			{
 				ENLV1_printf("saving new outer tuple information");
@@ -167,6 +174,7 @@ ExecNestLoopVLE(PlanState *pstate)
 				 */
 				ENLV1_printf("rescanning inner plan");
 				ExecReScan(innerPlan);
+				countExpansion(node);
 
 				/*
 				 * in the case that <curhops, minHops> is either <0, 0> or
@@ -257,6 +265,8 @@ ExecNestLoopVLE(PlanState *pstate)
 			continue;
 		}
 
+		node->instr.nedges += 1;
+
 		/*
 		 * at this point we have a new pair of inner and outer tuples so we
 		 * test the inner and outer tuples to see if they satisfy the node's
@@ -371,6 +381,7 @@ ExecNestLoopVLE(PlanState *pstate)
 					 */
 					ENLV1_printf("rescanning inner plan");
 					ExecReScan(innerPlan);
+					countExpansion(node);
 
 					node->curhops++;
 
@@ -483,6 +494,9 @@ ExecInitNestLoopVLE(NestLoopVLE *node, EState *estate, int eflags)
 	ExecAssignProjectionInfo(&nlvstate->nls.js.ps, NULL);
 
 	nlvstate->curhops = getInitialCurhops(node);
+	nlvstate->graphoid = pgstat_track_counts ?
+		ExecGetLabelGraphOid(innerPlanState(nlvstate)) : InvalidOid;
+	InstrInitTraversal(&nlvstate->instr, true);
 
 	innerTupleDesc =
 			innerPlanState(nlvstate)->ps_ResultTupleSlot->tts_tupleDescriptor;
@@ -721,6 +735,39 @@ needResult(NestLoopVLEState *node)
 	return node->curhops >= nlv->minHops;
 }
 
+/*
+ * Count the rescan of innerPlan that looks for the edges of the next hop from
+ * the end of the current path. The vertex at the end is the graphid passed
+ * down to innerPlan by fetchOuterVars().
+ */
+static void
+countExpansion(NestLoopVLEState *node)
+{
+	NestLoopVLE *nlv = (NestLoopVLE *) node->nls.js.ps.plan;
+	ExprContext *econtext = node->nls.js.ps.ps_ExprContext;
+	ListCell   *lc;
+
+	node->instr.nrescans += 1;
+	InstrCountExpansion(&node->instr, node->eids->nelems + 1);
+
+	if (!OidIsValid(node->graphoid))
+		return;
+
+	foreach(lc, nlv->nl.nestParams)
+	{
+		NestLoopParam *nlp = (NestLoopParam *) lfirst(lc);
+		ParamExecData *prm = &(econtext->ecxt_param_exec_vals[nlp->paramno]);
+
+		if (nlp->paramval->varattno == OUTER_CURR_VID_VARNO + 1 &&
+			!prm->isnull)
+		{
+			agstat_count_vertex_expand(node->graphoid,
+									   DatumGetGraphid(prm->value));
+			break;
+		}
+	}
+}
+
 static void
 pushPathElementOuter(NestLoopVLEState *node, TupleTableSlot *slot)
 {
@@ -756,6 +803,9 @@ pushPathElementOuter(NestLoopVLEState *node, TupleTableSlot *slot)
 		accumArrayResult(node->edges, value, isnull, node->edges->element_type,
 						 CurrentMemoryContext);
 	}
+
+	if (node->eids->nelems > node->instr.maxdepth)
+		node->instr.maxdepth = node->eids->nelems;
 }
 
 static void
@@ -777,6 +827,9 @@ pushPathElementInner(NestLoopVLEState *node, TupleTableSlot *slot)
 						 slot->tts_isnull[INNER_VERTEX_VARNO],
 						 attrs[INNER_VERTEX_VARNO].atttypid,
 						 CurrentMemoryContext);
+
+	if (node->eids->nelems > node->instr.maxdepth)
+		node->instr.maxdepth = node->eids->nelems;
 }
 
 static void
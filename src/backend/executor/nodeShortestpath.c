@@ -25,6 +25,7 @@
 #include "executor/nodeHash2Side.h"
 #include "executor/nodeShortestpath.h"
 #include "miscadmin.h"
+#include "pgstat.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/graph.h"
@@ -64,6 +65,9 @@ static TupleTableSlot *ExecShortestpathProject(ShortestpathState *node,
 static HeapTuple replace_vertexRow_graphid(TupleDesc tupleDesc,
 										   HeapTuple vertexRow,
 										   Datum graphid);
+static void ExecShortestpathCountExpansion(Hash2SideState    *node,
+										   ShortestpathState *spstate,
+										   Graphid            vid);
 
 /* ----------------------------------------------------------------
  *		ExecShortestpath
@@ -199,6 +203,8 @@ ExecShortestpath(PlanState *pstate)
 				}
 
 				node->hops++;
+				if (node->hops > node->instr.maxdepth)
+					node->instr.maxdepth = node->hops;
 				if (node->hops >= node->sp_Hops)
 				{
 					node->sp_Hops *= 2;
@@ -659,6 +665,7 @@ ExecInitShortestpath(Shortestpath *node, EState *estate, int eflags)
 	spstate->endVid     = 0;
 	spstate->hops       = 0;
 	spstate->numResults = 0;
+	InstrInitTraversal(&spstate->instr, true);
 
 	/*
 	 * initialize child nodes
@@ -679,6 +686,9 @@ ExecInitShortestpath(Shortestpath *node, EState *estate, int eflags)
 	((Hash2SideState *) outerPlanState(spstate))->spstate = (PlanState *) spstate;
 	((Hash2SideState *) innerPlanState(spstate))->spstate = (PlanState *) spstate;
 
+	spstate->graphoid = pgstat_track_counts ?
+		ExecGetLabelGraphOid((PlanState *) spstate) : InvalidOid;
+
 	/*
 	 * tuple table initialization
 	 */
@@ -938,9 +948,31 @@ ExecShortestpathProcOuterNode(PlanState *node, ShortestpathState *spstate)
 		slot = ExecProcNode(node);
 	}
 
+	((Hash2SideState *) node)->instr.nedges += 1;
+	spstate->instr.nedges += 1;
+
 	return slot;
 }
 
+/*
+ * Count a vertex of the frontier of the current hop whose edges are about to
+ * be scanned by the Hash2Side node.
+ */
+static void
+ExecShortestpathCountExpansion(Hash2SideState *node, ShortestpathState *spstate,
+							   Graphid vid)
+{
+	node->instr.nrescans += 1;
+	InstrCountExpansion(&node->instr, 0);
+	if (node->hops > node->instr.maxdepth)
+		node->instr.maxdepth = node->hops;
+
+	spstate->instr.nrescans += 1;
+	InstrCountExpansion(&spstate->instr, spstate->hops);
+
+	agstat_count_vertex_expand(spstate->graphoid, vid);
+}
+
 /*
  * Helper function to replace the graphid portion of a vertex
  * row. It requires the vertex row and tuple descriptor be non NULL and
@@ -1048,6 +1080,7 @@ ExecShortestpathRescanOuterNode(Hash2SideState *node, ShortestpathState *spstate
 				outerPlanState(node)->chgParam = bms_add_member(outerPlanState(node)->chgParam,
 																paramno);
 				ExecReScan(outerPlanState(node));
+				ExecShortestpathCountExpansion(node, spstate, *graphid);
 
 				if (node->hops > 1)
 				{
@@ -1114,6 +1147,7 @@ ExecShortestpathRescanOuterNode(Hash2SideState *node, ShortestpathState *spstate
 				outerPlanState(node)->chgParam = bms_add_member(outerPlanState(node)->chgParam,
 																paramno);
 				ExecReScan(outerPlanState(node));
+				ExecShortestpathCountExpansion(node, spstate, *graphid);
 
 				if (node->hops > 1)
 				{
@@ -2529,6 +2529,83 @@ llvm_compile_expr(ExprState *state)
 				LLVMBuildBr(b, opblocks[i + 1]);
 				break;
 
+			case EEOP_CYPHERTYPECAST:
+				build_EvalXFunc(b, mod, "ExecEvalCypherTypeCast",
+								v_state, v_econtext, op);
+				LLVMBuildBr(b, opblocks[i + 1]);
+				break;
+
+			case EEOP_CYPHERMAPEXPR:
+				build_EvalXFunc(b, mod, "ExecEvalCypherMapExpr",
+								v_state, v_econtext, op);
+				LLVMBuildBr(b, opblocks[i + 1]);
+				break;
+
+			case EEOP_CYPHERLISTEXPR:
+				build_EvalXFunc(b, mod, "ExecEvalCypherListExpr",
+								v_state, v_econtext, op);
+				LLVMBuildBr(b, opblocks[i + 1]);
+				break;
+
+			case EEOP_CYPHERLISTCOMP_BEGIN:
+				build_EvalXFunc(b, mod, "ExecEvalCypherListCompBegin",
+								v_state, v_econtext, op);
+				LLVMBuildBr(b, opblocks[i + 1]);
+				break;
+
+			case EEOP_CYPHERLISTCOMP_ELEM:
+				build_EvalXFunc(b, mod, "ExecEvalCypherListCompElem",
+								v_state, v_econtext, op);
+				LLVMBuildBr(b, opblocks[i + 1]);
+				break;
+
+			case EEOP_CYPHERLISTCOMP_END:
+				build_EvalXFunc(b, mod, "ExecEvalCypherListCompEnd",
+								v_state, v_econtext, op);
+				LLVMBuildBr(b, opblocks[i + 1]);
+				break;
+
+			case EEOP_CYPHERLISTCOMP_ITER_INIT:
+				build_EvalXFunc(b, mod, "ExecEvalCypherListCompIterInit",
+								v_state, v_econtext, op);
+				LLVMBuildBr(b, opblocks[i + 1]);
+				break;
+
+			case EEOP_CYPHERLISTCOMP_ITER_NEXT:
+				build_EvalXFunc(b, mod, "ExecEvalCypherListCompIterNext",
+								v_state, v_econtext, op);
+				LLVMBuildBr(b, opblocks[i + 1]);
+				break;
+
+			case EEOP_CYPHERLISTCOMP_VAR:
+				{
+					LLVMValueRef v_elemvaluep,
+								v_elemvalue;
+					LLVMValueRef v_elemnullp,
+								v_elemnull;
+
+					v_elemvaluep =
+						l_ptr_const(op->d.cypherlistcomp_var.elemvalue,
+									l_ptr(TypeSizeT));
+					v_elemnullp =
+						l_ptr_const(op->d.cypherlistcomp_var.elemnull,
+									l_ptr(TypeStorageBool));
+
+					v_elemvalue = LLVMBuildLoad(b, v_elemvaluep, "");
+					v_elemnull = LLVMBuildLoad(b, v_elemnullp, "");
+					LLVMBuildStore(b, v_elemvalue, v_resvaluep);
+					LLVMBuildStore(b, v_elemnull, v_resnullp);
+
+					LLVMBuildBr(b, opblocks[i + 1]);
+					break;
+				}
+
+			case EEOP_CYPHERACCESSEXPR:
+				build_EvalXFunc(b, mod, "ExecEvalCypherAccessExpr",
+								v_state, v_econtext, op);
+				LLVMBuildBr(b, opblocks[i + 1]);
+				break;
+
 			case EEOP_LAST:
 				Assert(false);
 				break;
@@ -1264,6 +1264,9 @@ _copyDijkstra(const Dijkstra *from)
 	COPY_NODE_FIELD(source);
 	COPY_NODE_FIELD(target);
 	COPY_NODE_FIELD(limit);
+	COPY_SCALAR_FIELD(elabel);
+	COPY_STRING_FIELD(weight_key);
+	COPY_SCALAR_FIELD(direction);
 
 	return newnode;
 }
@@ -2577,6 +2580,7 @@ _copyRangeTblEntry(const RangeTblEntry *from)
 	COPY_NODE_FIELD(subquery);
 	COPY_SCALAR_FIELD(security_barrier);
 	COPY_SCALAR_FIELD(isVLE);
+	COPY_SCALAR_FIELD(isCypherClause);
 	COPY_SCALAR_FIELD(jointype);
 	COPY_NODE_FIELD(joinaliasvars);
 	COPY_NODE_FIELD(functions);
@@ -3257,6 +3261,9 @@ _copyQuery(const Query *from)
 	COPY_NODE_FIELD(dijkstraEndId);
 	COPY_NODE_FIELD(dijkstraEdgeId);
 	COPY_NODE_FIELD(dijkstraLimit);
+	COPY_SCALAR_FIELD(dijkstraLabel);
+	COPY_STRING_FIELD(dijkstraWeightKey);
+	COPY_SCALAR_FIELD(dijkstraDirection);
 	COPY_NODE_FIELD(shortestpathEndIdLeft);
 	COPY_NODE_FIELD(shortestpathEndIdRight);
 	COPY_NODE_FIELD(shortestpathTableOidLeft);
@@ -1073,6 +1073,9 @@ _equalQuery(const Query *a, const Query *b)
 	COMPARE_NODE_FIELD(dijkstraEndId);
 	COMPARE_NODE_FIELD(dijkstraEdgeId);
 	COMPARE_NODE_FIELD(dijkstraLimit);
+	COMPARE_SCALAR_FIELD(dijkstraLabel);
+	COMPARE_STRING_FIELD(dijkstraWeightKey);
+	COMPARE_SCALAR_FIELD(dijkstraDirection);
 	COMPARE_NODE_FIELD(shortestpathEndIdLeft);
 	COMPARE_NODE_FIELD(shortestpathEndIdRight);
 	COMPARE_NODE_FIELD(shortestpathTableOidLeft);
@@ -2751,6 +2754,7 @@ _equalRangeTblEntry(const RangeTblEntry *a, const RangeTblEntry *b)
 	COMPARE_NODE_FIELD(subquery);
 	COMPARE_SCALAR_FIELD(security_barrier);
 	COMPARE_SCALAR_FIELD(isVLE);
+	COMPARE_SCALAR_FIELD(isCypherClause);
 	COMPARE_SCALAR_FIELD(jointype);
 	COMPARE_NODE_FIELD(joinaliasvars);
 	COMPARE_NODE_FIELD(functions);
@@ -1079,6 +1079,9 @@ _outDijkstra(StringInfo str, const Dijkstra *node)
 	WRITE_NODE_FIELD(source);
 	WRITE_NODE_FIELD(target);
 	WRITE_NODE_FIELD(limit);
+	WRITE_OID_FIELD(elabel);
+	WRITE_STRING_FIELD(weight_key);
+	WRITE_INT_FIELD(direction);
 }
 
 static void
@@ -3227,6 +3230,9 @@ _outQuery(StringInfo str, const Query *node)
 	WRITE_NODE_FIELD(dijkstraEndId);
 	WRITE_NODE_FIELD(dijkstraEdgeId);
 	WRITE_NODE_FIELD(dijkstraLimit);
+	WRITE_OID_FIELD(dijkstraLabel);
+	WRITE_STRING_FIELD(dijkstraWeightKey);
+	WRITE_INT_FIELD(dijkstraDirection);
 	
 	WRITE_NODE_FIELD(shortestpathEndIdLeft);
 	WRITE_NODE_FIELD(shortestpathEndIdRight);
@@ -3384,6 +3390,7 @@ _outRangeTblEntry(StringInfo str, const RangeTblEntry *node)
 			WRITE_NODE_FIELD(subquery);
 			WRITE_BOOL_FIELD(security_barrier);
 			WRITE_BOOL_FIELD(isVLE);
+			WRITE_BOOL_FIELD(isCypherClause);
 			break;
 		case RTE_JOIN:
 			WRITE_ENUM_FIELD(jointype, JoinType);
@@ -281,6 +281,9 @@ _readQuery(void)
 	READ_NODE_FIELD(dijkstraEndId);
 	READ_NODE_FIELD(dijkstraEdgeId);
 	READ_NODE_FIELD(dijkstraLimit);
+	READ_OID_FIELD(dijkstraLabel);
+	READ_STRING_FIELD(dijkstraWeightKey);
+	READ_INT_FIELD(dijkstraDirection);
 	READ_NODE_FIELD(shortestpathEndIdLeft);
 	READ_NODE_FIELD(shortestpathEndIdRight);
 	READ_NODE_FIELD(shortestpathTableOidLeft);
@@ -1392,6 +1395,7 @@ _readRangeTblEntry(void)
 			READ_NODE_FIELD(subquery);
 			READ_BOOL_FIELD(security_barrier);
 			READ_BOOL_FIELD(isVLE);
+			READ_BOOL_FIELD(isCypherClause);
 			break;
 		case RTE_JOIN:
 			READ_ENUM_FIELD(jointype, JoinType);
@@ -2431,6 +2435,9 @@ _readDijkstra(void)
 	READ_NODE_FIELD(source);
 	READ_NODE_FIELD(target);
 	READ_NODE_FIELD(limit);
+	READ_OID_FIELD(elabel);
+	READ_STRING_FIELD(weight_key);
+	READ_INT_FIELD(direction);
 
 	READ_DONE();
 }
@@ -175,8 +175,12 @@ static bool match_boolean_index_clause(Node *clause, int indexcol,
 static bool match_special_index_operator(Expr *clause,
 							 Oid opfamily, Oid idxcollation,
 							 bool indexkey_on_left);
+static Node *get_cypher_access_indexkey(Node *operand, int indexcol,
+						   IndexOptInfo *index);
 static Expr *expand_boolean_index_clause(Node *clause, int indexcol,
 							IndexOptInfo *index);
+static Expr *expand_cypher_access_clause(Expr *clause, int indexcol,
+							IndexOptInfo *index);
 static List *expand_indexqual_opclause(RestrictInfo *rinfo,
 						  Oid opfamily, Oid idxcollation);
 static RestrictInfo *expand_indexqual_rowcompare(RestrictInfo *rinfo,
@@ -2412,6 +2416,23 @@ match_clause_to_indexcol(IndexOptInfo *index,
 		return false;
 	}
 
+	/*
+	 * A Cypher property access, like n.key > $v, can use an index on
+	 * (properties -> 'key'). See expand_cypher_access_clause().
+	 */
+	if (plain_op && IndexCollMatchesExprColl(idxcollation, expr_coll))
+	{
+		if (get_cypher_access_indexkey(leftop, indexcol, index) != NULL &&
+			!bms_is_member(index_relid, right_relids) &&
+			!contain_volatile_functions(rightop))
+			return is_indexable_operator(expr_op, opfamily, true);
+
+		if (get_cypher_access_indexkey(rightop, indexcol, index) != NULL &&
+			!bms_is_member(index_relid, left_relids) &&
+			!contain_volatile_functions(leftop))
+			return is_indexable_operator(expr_op, opfamily, false);
+	}
+
 	return false;
 }
 
@@ -2926,7 +2947,9 @@ ec_member_matches_indexcol(PlannerInfo *root, RelOptInfo *rel,
 	if (!IndexCollMatchesExprColl(curCollation, ec->ec_collation))
 		return false;
 
-	return match_index_to_operand((Node *) em->em_expr, indexcol, index);
+	return (match_index_to_operand((Node *) em->em_expr, indexcol, index) ||
+			get_cypher_access_indexkey((Node *) em->em_expr, indexcol,
+									   index) != NULL);
 }
 
 /*
@@ -3236,6 +3259,48 @@ match_index_to_operand(Node *operand,
 	return false;
 }
 
+/*
+ * get_cypher_access_indexkey()
+ *	  If the operand is a Cypher property access, like properties.'key', and
+ *	  the index column is the same property taken with the jsonb -> operator,
+ *	  like (properties -> 'key'), return the index expression.
+ *
+ * They are not interchangeable because the former yields NULL for JSON null
+ * while the latter yields jsonb 'null'. But whenever the former is not NULL
+ * they are equal, so a clause on the former implies the same clause on the
+ * latter and the index can be scanned with it.
+ */
+static Node *
+get_cypher_access_indexkey(Node *operand, int indexcol, IndexOptInfo *index)
+{
+	ListCell   *indexpr_item;
+	int			i;
+	Node	   *indexkey;
+
+	if (operand == NULL || !IsA(operand, CypherAccessExpr) ||
+		index->indexkeys[indexcol] != 0)
+		return NULL;
+
+	indexpr_item = list_head(index->indexprs);
+	for (i = 0; i < indexcol; i++)
+	{
+		if (index->indexkeys[i] == 0)
+		{
+			if (indexpr_item == NULL)
+				elog(ERROR, "wrong number of index expressions");
+			indexpr_item = lnext(indexpr_item);
+		}
+	}
+	if (indexpr_item == NULL)
+		elog(ERROR, "wrong number of index expressions");
+	indexkey = (Node *) lfirst(indexpr_item);
+
+	if (!cypher_access_matches_field_path(operand, indexkey))
+		return NULL;
+
+	return indexkey;
+}
+
 /****************************************************************************
  *			----  ROUTINES FOR "SPECIAL" INDEXABLE OPERATORS  ----
  ****************************************************************************/
@@ -3563,6 +3628,17 @@ expand_indexqual_conditions(IndexOptInfo *index,
 		 */
 		if (is_opclause(clause))
 		{
+			Expr	   *accessqual;
+
+			accessqual = expand_cypher_access_clause(clause, indexcol, index);
+			if (accessqual)
+			{
+				indexquals = lappend(indexquals,
+									 make_simple_restrictinfo(accessqual));
+				indexqualcols = lappend_int(indexqualcols, indexcol);
+				continue;
+			}
+
 			indexquals = list_concat(indexquals,
 									 expand_indexqual_opclause(rinfo,
 															   curFamily,
@@ -3664,6 +3740,42 @@ expand_boolean_index_clause(Node *clause,
 	return NULL;
 }
 
+/*
+ * expand_cypher_access_clause
+ *	  Convert a clause recognized by match_clause_to_indexcol() as a Cypher
+ *	  property access on an index on the jsonb -> operator into the same
+ *	  clause on the index expression.
+ *
+ * The original clause is not an indexqual, so it stays as a filter and
+ * rejects rows whose property is JSON null.
+ *
+ * Returns NULL if the clause isn't such a clause.
+ */
+static Expr *
+expand_cypher_access_clause(Expr *clause, int indexcol, IndexOptInfo *index)
+{
+	OpExpr	   *opexpr = (OpExpr *) clause;
+	Node	   *leftop = get_leftop(clause);
+	Node	   *rightop = get_rightop(clause);
+	Node	   *indexkey;
+	OpExpr	   *result;
+
+	if ((indexkey = get_cypher_access_indexkey(leftop, indexcol, index)))
+		leftop = copyObject(indexkey);
+	else if ((indexkey = get_cypher_access_indexkey(rightop, indexcol, index)))
+		rightop = copyObject(indexkey);
+	else
+		return NULL;
+
+	result = (OpExpr *) make_opclause(opexpr->opno, opexpr->opresulttype,
+									  opexpr->opretset, (Expr *) leftop,
+									  (Expr *) rightop, opexpr->opcollid,
+									  opexpr->inputcollid);
+	result->opfuncid = opexpr->opfuncid;
+
+	return (Expr *) result;
+}
+
 /*
  * expand_indexqual_opclause --- expand a single indexqual condition
  *		that is an operator clause
@@ -4337,6 +4337,9 @@ create_dijkstra_plan(PlannerInfo *root, DijkstraPath *best_path)
 						 subplan, best_path->weight, best_path->weight_out,
 						 end_id, edge_id, best_path->source,
 						 best_path->target, best_path->limit);
+	plan->elabel = root->parse->dijkstraLabel;
+	plan->weight_key = root->parse->dijkstraWeightKey;
+	plan->direction = root->parse->dijkstraDirection;
 
 	copy_generic_path_info(&plan->plan, &best_path->path);
 
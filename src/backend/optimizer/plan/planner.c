@@ -1102,10 +1102,13 @@ preprocess_expression(PlannerInfo *root, Node *expr, int kind)
 	expr = eval_const_expressions(root, expr);
 
 	/*
-	 * If it's a qual or havingQual, canonicalize it.
+	 * If it's a qual or havingQual, compare promoted properties of labels on
+	 * their columns and canonicalize it.
 	 */
 	if (kind == EXPRKIND_QUAL)
 	{
+		expr = rewrite_promoted_properties(root, expr);
+
 		expr = (Node *) canonicalize_qual((Expr *) expr, false);
 
 #ifdef OPTIMIZER_DEBUG
@@ -28,6 +28,7 @@
 #include "nodes/nodeFuncs.h"
 #include "optimizer/clauses.h"
 #include "optimizer/cost.h"
+#include "optimizer/paths.h"
 #include "optimizer/placeholder.h"
 #include "optimizer/prep.h"
 #include "optimizer/subselect.h"
@@ -69,6 +70,9 @@ static Node *pull_up_subqueries_recurse(PlannerInfo *root, Node *jtnode,
 						   JoinExpr *lowest_nulling_outer_join,
 						   AppendRelInfo *containing_appendrel,
 						   bool deletion_ok);
+static bool is_cypher_clause_subquery(PlannerInfo *root, Node *jtnode);
+static void splice_cypher_clause_fromexprs(FromExpr *f,
+							   List *cypher_children);
 static Node *pull_up_simple_subquery(PlannerInfo *root, Node *jtnode,
 						RangeTblEntry *rte,
 						JoinExpr *lowest_outer_join,
@@ -737,6 +741,7 @@ pull_up_subqueries_recurse(PlannerInfo *root, Node *jtnode,
 	{
 		FromExpr   *f = (FromExpr *) jtnode;
 		bool		have_undeleted_child = false;
+		List	   *cypher_children = NIL;
 		ListCell   *l;
 
 		Assert(containing_appendrel == NULL);
@@ -765,6 +770,9 @@ pull_up_subqueries_recurse(PlannerInfo *root, Node *jtnode,
 										   have_undeleted_child ||
 										   lnext(l) != NULL ||
 										   f == root->parse->jointree);
+			bool		is_cypher_clause;
+
+			is_cypher_clause = is_cypher_clause_subquery(root, lfirst(l));
 
 			lfirst(l) = pull_up_subqueries_recurse(root, lfirst(l),
 												   lowest_outer_join,
@@ -773,6 +781,10 @@ pull_up_subqueries_recurse(PlannerInfo *root, Node *jtnode,
 												   sub_deletion_ok);
 			if (lfirst(l) != NULL)
 				have_undeleted_child = true;
+
+			if (is_cypher_clause && lfirst(l) != NULL &&
+				IsA(lfirst(l), FromExpr))
+				cypher_children = lappend(cypher_children, lfirst(l));
 		}
 
 		if (deletion_ok && !have_undeleted_child)
@@ -781,6 +793,9 @@ pull_up_subqueries_recurse(PlannerInfo *root, Node *jtnode,
 			root->hasDeletedRTEs = true;	/* probably is set already */
 			return NULL;
 		}
+
+		if (cypher_children != NIL)
+			splice_cypher_clause_fromexprs(f, cypher_children);
 	}
 	else if (IsA(jtnode, JoinExpr))
 	{
@@ -861,6 +876,72 @@ pull_up_subqueries_recurse(PlannerInfo *root, Node *jtnode,
 	return jtnode;
 }
 
+/*
+ * is_cypher_clause_subquery
+ *	  Is the jointree node a reference to the subquery of a Cypher clause?
+ */
+static bool
+is_cypher_clause_subquery(PlannerInfo *root, Node *jtnode)
+{
+	RangeTblEntry *rte;
+
+	if (!IsA(jtnode, RangeTblRef))
+		return false;
+
+	rte = rt_fetch(((RangeTblRef *) jtnode)->rtindex, root->parse->rtable);
+
+	return (rte->rtekind == RTE_SUBQUERY && rte->isCypherClause);
+}
+
+/*
+ * splice_cypher_clause_fromexprs
+ *	  Merge the FROM lists of pulled-up Cypher clause subqueries into the
+ *	  FROM list that contains them.
+ *
+ * A Cypher statement is transformed into a chain of subqueries, one for each
+ * clause, so its relations end up in nested FROM lists once the subqueries
+ * are pulled up. deconstruct_jointree() then keeps the relations of a clause
+ * together whenever the whole statement exceeds from_collapse_limit, and the
+ * join search cannot reorder them across clause boundaries. The nesting
+ * carries no meaning for inner joins, so we flatten it here, as long as the
+ * merged list still gets an exhaustive join search (below geqo_threshold).
+ *
+ * This is called after all children of `f` are processed, so replacing its
+ * FROM list does not confuse the Var replacement done for pulled-up
+ * subqueries.
+ */
+static void
+splice_cypher_clause_fromexprs(FromExpr *f, List *cypher_children)
+{
+	int			nitems = list_length(f->fromlist);
+	List	   *newfromlist = NIL;
+	ListCell   *l;
+
+	foreach(l, f->fromlist)
+	{
+		Node	   *child = lfirst(l);
+
+		if (child != NULL && list_member_ptr(cypher_children, child))
+		{
+			FromExpr   *cf = (FromExpr *) child;
+			int			newnitems = nitems - 1 + list_length(cf->fromlist);
+
+			if (newnitems < geqo_threshold)
+			{
+				newfromlist = list_concat(newfromlist,
+										  list_copy(cf->fromlist));
+				f->quals = make_and_qual(f->quals, cf->quals);
+				nitems = newnitems;
+				continue;
+			}
+		}
+
+		newfromlist = lappend(newfromlist, child);
+	}
+
+	f->fromlist = newfromlist;
+}
+
 /*
  * pull_up_simple_subquery
  *		Attempt to pull up a single simple subquery.
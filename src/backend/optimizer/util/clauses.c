@@ -19,6 +19,8 @@
 
 #include "postgres.h"
 
+#include "ag_const.h"
+#include "access/heapam.h"
 #include "access/htup_details.h"
 #include "catalog/pg_aggregate.h"
 #include "catalog/pg_class.h"
@@ -41,14 +43,18 @@
 #include "parser/parse_agg.h"
 #include "parser/parse_coerce.h"
 #include "parser/parse_func.h"
+#include "parser/parsetree.h"
 #include "rewrite/rewriteManip.h"
 #include "tcop/tcopprot.h"
 #include "utils/acl.h"
 #include "utils/builtins.h"
+#include "utils/cypher_funcs.h"
 #include "utils/datum.h"
 #include "utils/fmgroids.h"
+#include "utils/graph.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
+#include "utils/numeric.h"
 #include "utils/syscache.h"
 #include "utils/typcache.h"
 
@@ -126,6 +132,13 @@ static List *simplify_and_arguments(List *args,
 					   eval_const_expressions_context *context,
 					   bool *haveNull, bool *forceFalse);
 static Node *simplify_boolean_equality(Oid opno, List *args);
+static Expr *simplify_graphpath_accessor(Oid funcid, List *args);
+static Node *rewrite_promoted_properties_mutator(Node *node,
+									PlannerInfo *root);
+static Expr *rewrite_promoted_property_comparison(PlannerInfo *root,
+									 OpExpr *opexpr);
+static AttrNumber get_promoted_property_attnum(Oid relid, const char *key);
+static bool get_jsonb_scalar_const(Node *node, JsonbValue *jv);
 static Expr *simplify_function(Oid funcid,
 				  Oid result_type, int32 result_typmod,
 				  Oid result_collid, Oid input_collid, List **args_p,
@@ -2802,6 +2815,10 @@ eval_const_expressions_mutator(Node *node,
 				if (simple)		/* successfully simplified it */
 					return (Node *) simple;
 
+				simple = simplify_graphpath_accessor(expr->funcid, args);
+				if (simple)
+					return (Node *) simple;
+
 				/*
 				 * The expression cannot be simplified any further, so build
 				 * and return a replacement FuncExpr node using the
@@ -4289,6 +4306,56 @@ simplify_boolean_equality(Oid opno, List *args)
 	return NULL;
 }
 
+/*
+ * Subroutine for eval_const_expressions: simplify accessors of a graph path
+ *
+ * A graph path of a MATCH pattern is ROW(vertices, edges)::graphpath. If the
+ * query asks only for length(), vertices() or edges() of it (this happens
+ * after the subquery that makes the path is pulled up), take the array out of
+ * the RowExpr so that the path is never built.  This saves copying every
+ * vertex and edge of the path into a new composite datum and deforming it
+ * again.  Returns NULL if the call cannot be simplified.
+ */
+static Expr *
+simplify_graphpath_accessor(Oid funcid, List *args)
+{
+	RowExpr    *rowexpr;
+	Node	   *vertices;
+	Node	   *edges;
+
+	if (funcid != F_GRAPHPATH_LENGTH &&
+		funcid != F_GRAPHPATH_VERTICES && funcid != F_GRAPHPATH_NODES &&
+		funcid != F_GRAPHPATH_EDGES && funcid != F_GRAPHPATH_RELATIONSHIPS)
+		return NULL;
+
+	Assert(list_length(args) == 1);
+	rowexpr = (RowExpr *) linitial(args);
+	if (!IsA(rowexpr, RowExpr) ||
+		rowexpr->row_typeid != GRAPHPATHOID ||
+		list_length(rowexpr->args) != Natts_graphpath)
+		return NULL;
+
+	vertices = list_nth(rowexpr->args, Anum_graphpath_vertices - 1);
+	edges = list_nth(rowexpr->args, Anum_graphpath_edges - 1);
+
+	switch (funcid)
+	{
+		case F_GRAPHPATH_LENGTH:
+			return (Expr *) makeFuncExpr(F__EDGE_LENGTH, JSONBOID,
+										 list_make1(edges),
+										 InvalidOid, InvalidOid,
+										 COERCE_EXPLICIT_CALL);
+		case F_GRAPHPATH_VERTICES:
+		case F_GRAPHPATH_NODES:
+			return (Expr *) vertices;
+		case F_GRAPHPATH_EDGES:
+		case F_GRAPHPATH_RELATIONSHIPS:
+			return (Expr *) edges;
+		default:
+			return NULL;
+	}
+}
+
 /*
  * Subroutine for eval_const_expressions: try to simplify a function call
  * (which might originally have been an operator; we don't care)
@@ -5616,3 +5683,337 @@ tlist_matches_coltypelist(List *tlist, List *coltypelist)
 
 	return true;
 }
+
+/*
+ * rewrite_promoted_properties
+ *
+ * Replace comparisons between a property of a label and a constant, like
+ * `n.age > 30`, with the same comparisons on the column that the property
+ * is promoted to (see ALTER VLABEL ... PROMOTE PROPERTY). Then the
+ * comparisons can use indexes and statistics of the column, and they are
+ * cheaper than comparing jsonb values. The column always holds the property
+ * converted exactly, so the results are the same.
+ */
+Node *
+rewrite_promoted_properties(PlannerInfo *root, Node *node)
+{
+	return rewrite_promoted_properties_mutator(node, root);
+}
+
+static Node *
+rewrite_promoted_properties_mutator(Node *node, PlannerInfo *root)
+{
+	if (node == NULL)
+		return NULL;
+
+	/* subqueries are planned separately */
+	if (IsA(node, Query))
+		return node;
+
+	if (IsA(node, OpExpr))
+	{
+		Expr	   *newexpr;
+
+		newexpr = rewrite_promoted_property_comparison(root, (OpExpr *) node);
+		if (newexpr != NULL)
+			return (Node *) newexpr;
+	}
+
+	return expression_tree_mutator(node, rewrite_promoted_properties_mutator,
+								   (void *) root);
+}
+
+static Expr *
+rewrite_promoted_property_comparison(PlannerInfo *root, OpExpr *opexpr)
+{
+	Node	   *larg;
+	Node	   *rarg;
+	CypherAccessExpr *access;
+	Node	   *other;
+	bool		propleft;
+	Const	   *keyconst;
+	char	   *key;
+	Var		   *prop_map;
+	RangeTblEntry *rte;
+	AttrNumber	propattnum;
+	AttrNumber	attnum;
+	Oid			typid;
+	int32		typmod;
+	Oid			collid;
+	JsonbValue	jv;
+	Datum		value;
+	char	   *opname;
+	int			strategy;
+	bool		negate = false;
+	TypeCacheEntry *typentry;
+	Oid			opno;
+	Expr	   *result;
+	int16		typlen;
+	bool		typbyval;
+
+	if (list_length(opexpr->args) != 2)
+		return NULL;
+
+	larg = linitial(opexpr->args);
+	rarg = lsecond(opexpr->args);
+	if (exprType(larg) != JSONBOID || exprType(rarg) != JSONBOID)
+		return NULL;
+
+	if (IsA(larg, CypherAccessExpr))
+	{
+		access = (CypherAccessExpr *) larg;
+		other = rarg;
+		propleft = true;
+	}
+	else if (IsA(rarg, CypherAccessExpr))
+	{
+		access = (CypherAccessExpr *) rarg;
+		other = larg;
+		propleft = false;
+	}
+	else
+	{
+		return NULL;
+	}
+
+	/* properties.'key' of a label */
+	if (!IsA(access->arg, Var) || list_length(access->path) != 1)
+		return NULL;
+	keyconst = (Const *) linitial(access->path);
+	if (!IsA(keyconst, Const) || keyconst->consttype != TEXTOID ||
+		keyconst->constisnull)
+		return NULL;
+
+	prop_map = (Var *) access->arg;
+	if (prop_map->varlevelsup != 0 || IS_SPECIAL_VARNO(prop_map->varno))
+		return NULL;
+
+	rte = planner_rt_fetch(prop_map->varno, root);
+	if (rte->rtekind != RTE_RELATION ||
+		!OidIsValid(get_relid_laboid(rte->relid)))
+		return NULL;
+
+	propattnum = get_attnum(rte->relid, AG_ELEM_PROP_MAP);
+	if (prop_map->varattno != propattnum)
+		return NULL;
+
+	key = TextDatumGetCString(keyconst->constvalue);
+	attnum = get_promoted_property_attnum(rte->relid, key);
+	if (attnum == InvalidAttrNumber)
+		return NULL;
+
+	get_atttypetypmodcoll(rte->relid, attnum, &typid, &typmod, &collid);
+	if (!PropertyTypeIsPromotable(typid) || typmod != -1)
+		return NULL;
+
+	if (!get_jsonb_scalar_const(other, &jv) ||
+		!JsonbScalarToPropertyDatum(&jv, typid, &value))
+		return NULL;
+
+	/* the column goes to the left */
+	opname = get_opname(opexpr->opno);
+	if (opname == NULL)
+		return NULL;
+	if (strcmp(opname, "=") == 0)
+		strategy = BTEqualStrategyNumber;
+	else if (strcmp(opname, "<>") == 0)
+	{
+		strategy = BTEqualStrategyNumber;
+		negate = true;
+	}
+	else if (strcmp(opname, "<") == 0)
+		strategy = propleft ? BTLessStrategyNumber : BTGreaterStrategyNumber;
+	else if (strcmp(opname, "<=") == 0)
+		strategy = propleft ? BTLessEqualStrategyNumber :
+							  BTGreaterEqualStrategyNumber;
+	else if (strcmp(opname, ">") == 0)
+		strategy = propleft ? BTGreaterStrategyNumber : BTLessStrategyNumber;
+	else if (strcmp(opname, ">=") == 0)
+		strategy = propleft ? BTGreaterEqualStrategyNumber :
+							  BTLessEqualStrategyNumber;
+	else
+		return NULL;
+
+	typentry = lookup_type_cache(typid, TYPECACHE_BTREE_OPFAMILY);
+	if (!OidIsValid(typentry->btree_opf))
+		return NULL;
+
+	opno = get_opfamily_member(typentry->btree_opf, typentry->btree_opintype,
+							   typentry->btree_opintype, strategy);
+	if (negate && OidIsValid(opno))
+		opno = get_negator(opno);
+	if (!OidIsValid(opno))
+		return NULL;
+
+	get_typlenbyval(typid, &typlen, &typbyval);
+
+	result = make_opclause(opno, BOOLOID, false,
+						   (Expr *) makeVar(prop_map->varno, attnum, typid,
+											typmod, collid, 0),
+						   (Expr *) makeConst(typid, typmod, collid, typlen,
+											  value, false, typbyval),
+						   InvalidOid, collid);
+	set_opfuncid((OpExpr *) result);
+
+	return result;
+}
+
+/* get the column that the property `key` of the label is promoted to */
+static AttrNumber
+get_promoted_property_attnum(Oid relid, const char *key)
+{
+	Relation	rel;
+	List	   *promoted;
+	ListCell   *lc;
+	AttrNumber	attnum = InvalidAttrNumber;
+
+	/* the planner already holds a lock on the label */
+	rel = heap_open(relid, NoLock);
+	promoted = RelationGetPromotedProperties(rel);
+	heap_close(rel, NoLock);
+
+	foreach(lc, promoted)
+	{
+		PromotedProperty *prop = lfirst(lc);
+
+		if (strcmp(prop->key, key) == 0)
+		{
+			attnum = prop->attnum;
+			break;
+		}
+	}
+
+	return attnum;
+}
+
+/* get the scalar of a jsonb constant, including to_jsonb(constant) */
+static bool
+get_jsonb_scalar_const(Node *node, JsonbValue *jv)
+{
+	if (IsA(node, Const))
+	{
+		Const	   *c = (Const *) node;
+		Jsonb	   *j;
+
+		if (c->constisnull)
+			return false;
+
+		j = DatumGetJsonbP(c->constvalue);
+		if (!JB_ROOT_IS_SCALAR(j))
+			return false;
+
+		*jv = *getIthJsonbValueFromContainer(&j->root, 0);
+		return true;
+	}
+
+	if (IsA(node, FuncExpr) && ((FuncExpr *) node)->funcid == F_TO_JSONB)
+	{
+		Const	   *c = (Const *) linitial(((FuncExpr *) node)->args);
+
+		if (!IsA(c, Const) || c->constisnull)
+			return false;
+
+		switch (c->consttype)
+		{
+			case INT2OID:
+				jv->type = jbvNumeric;
+				jv->val.numeric =
+					int64_to_numeric(DatumGetInt16(c->constvalue));
+				return true;
+			case INT4OID:
+				jv->type = jbvNumeric;
+				jv->val.numeric =
+					int64_to_numeric(DatumGetInt32(c->constvalue));
+				return true;
+			case INT8OID:
+				jv->type = jbvNumeric;
+				jv->val.numeric =
+					int64_to_numeric(DatumGetInt64(c->constvalue));
+				return true;
+			case NUMERICOID:
+				/* to_jsonb() makes NaN a string */
+				if (numeric_is_nan(DatumGetNumeric(c->constvalue)))
+					return false;
+				jv->type = jbvNumeric;
+				jv->val.numeric = DatumGetNumeric(c->constvalue);
+				return true;
+			case TEXTOID:
+				jv->type = jbvString;
+				jv->val.string.val = TextDatumGetCString(c->constvalue);
+				jv->val.string.len = strlen(jv->val.string.val);
+				return true;
+			case BOOLOID:
+				jv->type = jbvBool;
+				jv->val.boolean = DatumGetBool(c->constvalue);
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * cypher_access_matches_field_path
+ *
+ * Is `node` a Cypher property access, like properties.'a'.'b', that reads the
+ * same value as `expr`, like (properties -> 'a') -> 'b'? The only difference
+ * between them is that the former yields SQL NULL for JSON null. So, if the
+ * former is not NULL, they are equal.
+ */
+bool
+cypher_access_matches_field_path(Node *node, Node *expr)
+{
+	CypherAccessExpr *access;
+	int			i;
+
+	if (node == NULL || !IsA(node, CypherAccessExpr))
+		return false;
+	access = (CypherAccessExpr *) node;
+	if (access->path == NIL)
+		return false;
+
+	/* walk down `expr` from the last key of the path */
+	for (i = list_length(access->path) - 1; i >= 0; i--)
+	{
+		Const	   *key = (Const *) list_nth(access->path, i);
+		List	   *args;
+		Const	   *fieldkey;
+
+		if (!IsA(key, Const) || key->consttype != TEXTOID ||
+			key->constisnull)
+			return false;
+
+		if (IsA(expr, OpExpr))
+		{
+			OpExpr	   *opexpr = (OpExpr *) expr;
+
+			set_opfuncid(opexpr);
+			if (opexpr->opfuncid != F_JSONB_OBJECT_FIELD)
+				return false;
+			args = opexpr->args;
+		}
+		else if (IsA(expr, FuncExpr) &&
+				 ((FuncExpr *) expr)->funcid == F_JSONB_OBJECT_FIELD)
+		{
+			args = ((FuncExpr *) expr)->args;
+		}
+		else
+		{
+			return false;
+		}
+
+		fieldkey = (Const *) lsecond(args);
+		if (!IsA(fieldkey, Const) || fieldkey->consttype != TEXTOID ||
+			fieldkey->constisnull)
+			return false;
+		if (strcmp(TextDatumGetCString(key->constvalue),
+				   TextDatumGetCString(fieldkey->constvalue)) != 0)
+			return false;
+
+		expr = linitial(args);
+	}
+
+	return equal(expr, access->arg);
+}
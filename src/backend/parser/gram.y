@@ -753,7 +753,8 @@ static Node *wrapCypherWithSelect(Node *stmt);
 
 	PARALLEL PARSER PARTIAL PARTITION PASSING PASSWORD PLACING PLANS POLICY
 	POSITION PRECEDING PRECISION PRESERVE PREPARE PREPARED PRIMARY
-	PRIOR PRIVILEGES PROCEDURAL PROCEDURE PROCEDURES PROGRAM PROPERTY PUBLICATION
+	PRIOR PRIVILEGES PROCEDURAL PROCEDURE PROCEDURES PROGRAM PROMOTE PROPERTY
+	PUBLICATION
 
 	QUOTE
 
@@ -15455,6 +15456,7 @@ unreserved_keyword:
 			| PROCEDURE
 			| PROCEDURES
 			| PROGRAM
+			| PROMOTE
 			| PROPERTY
 			| PUBLICATION
 			| QUOTE
@@ -15991,6 +15993,25 @@ alter_label_cmd:
 					n->subtype = AT_DisableIndex;
 					$$ = (Node *)n;
 				}
+			/*
+			 * ALTER VLABEL <name> PROMOTE PROPERTY <key> AS <type>
+			 *
+			 * <key> is an identifier, so it is folded to lower case unless it
+			 * is double-quoted; quote it to promote a camelCase property.
+			 */
+			| PROMOTE PROPERTY ColId AS Typename
+				{
+					AlterTableCmd *n = makeNode(AlterTableCmd);
+					ColumnDef *def = makeNode(ColumnDef);
+					def->colname = $3;
+					def->typeName = $5;
+					def->is_local = true;
+					def->location = @3;
+					n->subtype = AT_PromoteProperty;
+					n->name = $3;
+					n->def = (Node *) def;
+					$$ = (Node *)n;
+				}
 		;
 
 CreateConstraintStmt:
@@ -37,6 +37,7 @@
 #include "parser/parse_cypher_expr.h"
 #include "parser/parse_expr.h"
 #include "parser/parse_func.h"
+#include "parser/parse_graph.h"
 #include "parser/parse_oper.h"
 #include "parser/parse_relation.h"
 #include "parser/parse_target.h"
@@ -162,13 +163,39 @@ transformCypherExprRecurse(ParseState *pstate, Node *expr)
 			{
 				SubLink	   *sublink = (SubLink *) expr;
 				CypherGenericExpr *cexpr;
+				Node	   *probe = NULL;
+				Node	   *result;
+				CoalesceExpr *coalesce;
+
+				/*
+				 * An EXISTS pattern that asks for a path between two vertices
+				 * is answered by the reachability index of a graph projection
+				 * if there is a usable one, and by the pattern otherwise.
+				 */
+				if (sublink->subLinkType == EXISTS_SUBLINK &&
+					IsA(sublink->subselect, CypherSubPattern))
+				{
+					CypherSubPattern *subpat;
+
+					subpat = (CypherSubPattern *) sublink->subselect;
+					probe = transformCypherReachability(pstate, subpat);
+				}
 
 				cexpr = makeNode(CypherGenericExpr);
 				cexpr->expr = sublink->testexpr;
 
 				sublink->testexpr = (Node *) cexpr;
 
-				return transformExpr(pstate, expr, pstate->p_expr_kind);
+				result = transformExpr(pstate, expr, pstate->p_expr_kind);
+				if (probe == NULL)
+					return result;
+
+				coalesce = makeNode(CoalesceExpr);
+				coalesce->coalescetype = BOOLOID;
+				coalesce->args = list_make2(probe, result);
+				coalesce->location = sublink->location;
+
+				return (Node *) coalesce;
 			}
 		case T_A_Indirection:
 			return transformIndirection(pstate, (A_Indirection *) expr);
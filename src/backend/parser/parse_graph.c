@@ -47,13 +47,13 @@
 #include "utils/builtins.h"
 #include "utils/fmgroids.h"
 #include "utils/graph.h"
+#include "utils/graphprojection.h"
 #include "utils/lsyscache.h"
 #include "utils/rel.h"
 #include "utils/snapmgr.h"
 #include "utils/syscache.h"
 #include "utils/typcache.h"
 
-#define CYPHER_SUBQUERY_ALIAS	"_"
 #define CYPHER_OPTMATCH_ALIAS	"_o"
 #define CYPHER_MERGEMATCH_ALIAS	"_m"
 #define CYPHER_DELETEJOIN_ALIAS	"_d"
@@ -360,6 +360,9 @@ static Node *makeColumnRef(List *fields);
 static A_Const *makeNullAConst(void);
 static bool IsNullAConst(Node *arg);
 
+/* EXISTS - reachability */
+static Node *makeReachabilityEndpoint(ParseState *pstate, CypherNode *cnode);
+
 /* utils */
 static char *genUniqueName(void);
 static List *repairTargetListCollations(List *targetList);
@@ -431,6 +434,106 @@ transformCypherSubPattern(ParseState *pstate, CypherSubPattern *subpat)
 	return qry;
 }
 
+/*
+ * transformCypherReachability
+ *		Make reachable_index() for an EXISTS pattern that only asks whether
+ *		a path of one or more edges of a label leads from a bound vertex to
+ *		another, such as (a)-[:knows*]->(b).
+ *
+ * This returns NULL if the pattern is not of that form or if no graph
+ * projection of the label has a reachability index. reachable_index() gives
+ * NULL if the projection is not usable for the query, so the caller keeps
+ * the pattern to fall back to.
+ */
+Node *
+transformCypherReachability(ParseState *pstate, CypherSubPattern *subpat)
+{
+	CypherPath *cpath;
+	CypherRel  *crel;
+	A_Indices  *indices;
+	Node	   *start;
+	Node	   *end;
+	char	   *typname;
+	int			typloc;
+	Oid			elabel;
+	Const	   *labconst;
+
+	if (subpat->kind != CSP_EXISTS || list_length(subpat->pattern) != 1)
+		return NULL;
+
+	cpath = linitial(subpat->pattern);
+	if (cpath->kind != CPATH_NORMAL || cpath->variable != NULL ||
+		list_length(cpath->chain) != 3)
+		return NULL;
+
+	crel = lsecond(cpath->chain);
+	if (crel->variable != NULL || list_length(crel->types) > 1 ||
+		crel->only || crel->prop_map != NULL || crel->varlen == NULL)
+		return NULL;
+	if (crel->direction != CYPHER_REL_DIR_LEFT &&
+		crel->direction != CYPHER_REL_DIR_RIGHT)
+		return NULL;
+
+	indices = (A_Indices *) crel->varlen;
+	if (((A_Const *) indices->lidx)->val.val.ival != 1 ||
+		indices->uidx != NULL)
+		return NULL;
+
+	start = makeReachabilityEndpoint(pstate, linitial(cpath->chain));
+	end = makeReachabilityEndpoint(pstate, lthird(cpath->chain));
+	if (start == NULL || end == NULL)
+		return NULL;
+
+	getCypherRelType(crel, &typname, &typloc);
+	if (!labelExist(pstate, typname, typloc, LABEL_KIND_EDGE, false))
+		return NULL;
+
+	elabel = get_labname_laboid(typname, get_graph_path_oid());
+	if (!GraphReachabilityExists(elabel))
+		return NULL;
+
+	labconst = makeConst(OIDOID, -1, InvalidOid, sizeof(Oid),
+						 ObjectIdGetDatum(elabel), false, true);
+
+	if (crel->direction == CYPHER_REL_DIR_LEFT)
+	{
+		Node	   *tmp = start;
+
+		start = end;
+		end = tmp;
+	}
+
+	return (Node *) makeFuncExpr(F_REACHABLE_INDEX, BOOLOID,
+								 list_make3(start, end, labconst),
+								 InvalidOid, InvalidOid,
+								 COERCE_EXPLICIT_CALL);
+}
+
+/* the id of a vertex bound outside the pattern, or NULL if it is not */
+static Node *
+makeReachabilityEndpoint(ParseState *pstate, CypherNode *cnode)
+{
+	char	   *varname = getCypherName(cnode->variable);
+	Node	   *col;
+	Var		   *var;
+
+	if (varname == NULL || cnode->label != NULL || cnode->prop_map != NULL)
+		return NULL;
+
+	col = colNameToVar(pstate, varname, false,
+					   getCypherNameLoc(cnode->variable));
+	if (col == NULL || !IsA(col, Var) || exprType(col) != VERTEXOID)
+		return NULL;
+
+	/* the id of a future vertex is not known until it is resolved */
+	var = (Var *) col;
+	if (findFutureVertex(pstate, var->varno, var->varattno,
+						 var->varlevelsup) != NULL)
+		return NULL;
+
+	return getExprField((Expr *) col, AG_ELEM_ID);
+}
+
 Query *
 transformCypherProjection(ParseState *pstate, CypherClause *clause)
 {
@@ -1107,7 +1210,7 @@ transformCypherUnwindClause(ParseState *pstate, CypherClause *clause)
 		 * This is the best because we don't know the actual value in the jsonb
 		 * value at this point.
 		 */
-		funcname = "jsonb_array_elements";
+		funcname = "cypher_unwind";
 	}
 	else if (type_is_array(type))
 	{
@@ -5840,6 +5943,7 @@ transformClauseBy(ParseState *pstate, Node *clause, TransformMethod transform)
 
 	alias = makeAliasNoDup(CYPHER_SUBQUERY_ALIAS, NIL);
 	rte = transformClauseImpl(pstate, clause, transform, alias);
+	rte->isCypherClause = true;
 	addRTEtoJoinlist(pstate, rte, true);
 
 	return rte;
@@ -29,6 +29,7 @@
 #include "parser/parse_shortestpath.h"
 #include "parser/parse_target.h"
 #include "utils/builtins.h"
+#include "utils/lsyscache.h"
 
 #define SP_COLNAME_VIDS		"vids"
 #define SP_COLNAME_EIDS		"eids"
@@ -77,6 +78,7 @@ static RangeTblEntry *makeDijkstraEdgeQuery(ParseState *pstate, CypherPath *cpat
 static Node *makeDijkstraEdgeUnion(char *elabel_name, char *row_name);
 static Node *makeDijkstraEdge(char *elabel_name, char *row_name,
 							  CypherRel *crel);
+static void setDijkstraProjection(Query *qry, CypherPath *cpath);
 
 /* parse node */
 static Alias *makeAliasNoDup(char *aliasname, List *colnames);
@@ -1443,6 +1445,8 @@ makeDijkstraFrom(ParseState *parentParseState, CypherPath *cpath)
 	qry->dijkstraLimit = transformCypherLimit(pstate, cpath->limit,
 											  EXPR_KIND_LIMIT, "LIMIT");
 
+	setDijkstraProjection(qry, cpath);
+
 	qry->rtable = pstate->p_rtable;
 	qry->jointree = makeFromExpr(pstate->p_joinlist, qual);
 
@@ -1616,6 +1620,40 @@ makeDijkstraEdge(char *elabel_name, char *row_name, CypherRel *crel)
 	return (Node *) sel;
 }
 
+/*
+ * If the edges and their weights can come from a graph projection, record
+ * what the executor needs to look for one. That is the case if there is no
+ * qual and the weight is a property of the edges, like `e.weight`.
+ */
+static void
+setDijkstraProjection(Query *qry, CypherPath *cpath)
+{
+	CypherRel  *crel = lsecond(cpath->chain);
+	char	   *elabel_name;
+	char	   *row_name;
+	ColumnRef  *cref;
+
+	qry->dijkstraLabel = InvalidOid;
+	qry->dijkstraWeightKey = NULL;
+	qry->dijkstraDirection = crel->direction;
+
+	if (cpath->qual != NULL || !IsA(cpath->weight, ColumnRef))
+		return;
+
+	row_name = getCypherName(crel->variable);
+	cref = (ColumnRef *) cpath->weight;
+	if (row_name == NULL || list_length(cref->fields) != 2 ||
+		!IsA(linitial(cref->fields), String) ||
+		!IsA(lsecond(cref->fields), String) ||
+		strcmp(strVal(linitial(cref->fields)), row_name) != 0)
+		return;
+
+	getCypherRelType(crel, &elabel_name, NULL);
+	qry->dijkstraLabel = get_labname_laboid(elabel_name, get_graph_path_oid());
+	if (OidIsValid(qry->dijkstraLabel))
+		qry->dijkstraWeightKey = pstrdup(strVal(lsecond(cref->fields)));
+}
+
 /* TODO: Remove */
 
 static void
@@ -155,6 +155,7 @@ static List *makeEdgeIndex(RangeVar *label);
 static bool isLabelKind(RangeVar *label, char labkind);
 static void transformLabelIdDefinition(CreateStmtContext *cxt, ColumnDef *col);
 static CommentStmt *makeComment(ObjectType type, RangeVar *name, char *desc);
+static Constraint *makePromotedPropertyCheck(ColumnDef *def);
 static Node *prop_ref_mutator(Node *node);
 static ObjectType getLabelObjectType(char *labname, Oid graphid);
 static bool figure_prop_index_colname_walker(Node *node, char **colname);
@@ -4490,6 +4491,7 @@ transformLabelIdDefinition(CreateStmtContext *cxt, ColumnDef *col)
 	DefElem	   *maxval;
 	List	   *attnamelist;
 	DefElem	   *ownedby;
+	DefElem	   *cache;
 	AlterSeqStmt *altseqstmt;
 	char	   *qname;
 	A_Const	   *relname;
@@ -4537,7 +4539,9 @@ transformLabelIdDefinition(CreateStmtContext *cxt, ColumnDef *col)
 	ownedby = makeDefElem("owned_by", (Node *) attnamelist, -1);
 	altseqstmt = makeNode(AlterSeqStmt);
 	altseqstmt->sequence = makeRangeVar(snamespace, sname, -1);
-	altseqstmt->options = list_make2(maxval, ownedby);
+	cache = makeDefElem("cache", (Node *) makeInteger(AG_LABEL_ID_SEQ_CACHE),
+						-1);
+	altseqstmt->options = list_make3(maxval, ownedby, cache);
 
 	cxt->alist = lappend(cxt->alist, altseqstmt);
 
@@ -4653,6 +4657,29 @@ transformAlterLabelStmt(AlterTableStmt *stmt)
 					newcmds = lappend(newcmds, cmd);
 					break;
 				}
+			case AT_PromoteProperty:
+				{
+					ColumnDef  *def = (ColumnDef *) cmd->def;
+					AlterTableCmd *addcol;
+					AlterTableCmd *addcheck;
+
+					/*
+					 * Add a column for the property, fill it with the values
+					 * of the property, and keep them the same.
+					 */
+					addcol = makeNode(AlterTableCmd);
+					addcol->subtype = AT_AddColumn;
+					addcol->def = (Node *) copyObject(def);
+
+					addcheck = makeNode(AlterTableCmd);
+					addcheck->subtype = AT_AddConstraint;
+					addcheck->def = (Node *) makePromotedPropertyCheck(def);
+
+					newcmds = lappend(newcmds, addcol);
+					newcmds = lappend(newcmds, cmd);
+					newcmds = lappend(newcmds, addcheck);
+					break;
+				}
 			default:
 				newcmds = lappend(newcmds, cmd);
 				break;
@@ -4663,6 +4690,59 @@ transformAlterLabelStmt(AlterTableStmt *stmt)
 	return result;
 }
 
+/*
+ * CHECK (key IS NOT DISTINCT FROM promote_property(properties, 'key', NULL::type))
+ *
+ * This keeps the promoted column of a label consistent with the property
+ * even if the label is modified with SQL.
+ */
+static Constraint *
+makePromotedPropertyCheck(ColumnDef *def)
+{
+	ColumnRef  *col;
+	ColumnRef  *prop_map;
+	A_Const    *key;
+	A_Const    *nullconst;
+	TypeCast   *typednull;
+	FuncCall   *promoted;
+	Constraint *check;
+
+	col = makeNode(ColumnRef);
+	col->fields = list_make1(makeString(def->colname));
+	col->location = -1;
+
+	prop_map = makeNode(ColumnRef);
+	prop_map->fields = list_make1(makeString(AG_ELEM_PROP_MAP));
+	prop_map->location = -1;
+
+	key = makeNode(A_Const);
+	key->val.type = T_String;
+	key->val.val.str = def->colname;
+	key->location = -1;
+
+	nullconst = makeNode(A_Const);
+	nullconst->val.type = T_Null;
+	nullconst->location = -1;
+
+	typednull = makeNode(TypeCast);
+	typednull->arg = (Node *) nullconst;
+	typednull->typeName = copyObject(def->typeName);
+	typednull->location = -1;
+
+	promoted = makeFuncCall(SystemFuncName("promote_property"),
+							list_make3(prop_map, key, typednull), -1);
+
+	check = makeNode(Constraint);
+	check->contype = CONSTR_CHECK;
+	check->location = -1;
+	check->raw_expr = (Node *) makeSimpleA_Expr(AEXPR_NOT_DISTINCT, "=",
+												(Node *) col,
+												(Node *) promoted, -1);
+	check->initially_valid = true;
+
+	return check;
+}
+
 /*
  * transformCreateConstraintStmt - parse analysis for CREATE CONSTRAINT
  *
@@ -68,6 +68,7 @@
 #include "utils/catcache.h"
 #include "utils/fmgroids.h"
 #include "utils/guc.h"
+#include "utils/labelcache.h"
 #include "utils/memutils.h"
 #include "utils/ps_status.h"
 #include "utils/rel.h"
@@ -3666,6 +3667,9 @@ pgstat_get_wait_ipc(WaitEventIPC w)
 		case WAIT_EVENT_EXECUTE_GATHER:
 			event_name = "ExecuteGather";
 			break;
+		case WAIT_EVENT_GRAPH_ALGORITHM_ITERATING:
+			event_name = "GraphAlgorithm/Iterating";
+			break;
 		case WAIT_EVENT_HASH_BATCH_ALLOCATING:
 			event_name = "Hash/Batch/Allocating";
 			break;
@@ -4715,6 +4719,9 @@ pgstat_get_tab_entry(PgStat_StatDBEntry *dbentry, Oid tableoid, bool create)
 		result->changes_since_analyze = 0;
 		result->blocks_fetched = 0;
 		result->blocks_hit = 0;
+		result->graph_expanded = 0;
+		result->graph_merge_matched = 0;
+		result->graph_merge_created = 0;
 		result->vacuum_timestamp = 0;
 		result->vacuum_count = 0;
 		result->autovac_vacuum_timestamp = 0;
@@ -5846,6 +5853,9 @@ pgstat_recv_tabstat(PgStat_MsgTabstat *msg, int len)
 			tabentry->changes_since_analyze = tabmsg->t_counts.t_changed_tuples;
 			tabentry->blocks_fetched = tabmsg->t_counts.t_blocks_fetched;
 			tabentry->blocks_hit = tabmsg->t_counts.t_blocks_hit;
+			tabentry->graph_expanded = tabmsg->t_counts.t_graph_expanded;
+			tabentry->graph_merge_matched = tabmsg->t_counts.t_graph_merge_matched;
+			tabentry->graph_merge_created = tabmsg->t_counts.t_graph_merge_created;
 
 			tabentry->vacuum_timestamp = 0;
 			tabentry->vacuum_count = 0;
@@ -5879,6 +5889,9 @@ pgstat_recv_tabstat(PgStat_MsgTabstat *msg, int len)
 			tabentry->changes_since_analyze += tabmsg->t_counts.t_changed_tuples;
 			tabentry->blocks_fetched += tabmsg->t_counts.t_blocks_fetched;
 			tabentry->blocks_hit += tabmsg->t_counts.t_blocks_hit;
+			tabentry->graph_expanded += tabmsg->t_counts.t_graph_expanded;
+			tabentry->graph_merge_matched += tabmsg->t_counts.t_graph_merge_matched;
+			tabentry->graph_merge_created += tabmsg->t_counts.t_graph_merge_created;
 		}
 
 		/* Clamp n_live_tuples in case of negative delta_live_tuples */
@@ -6680,6 +6693,45 @@ agstat_drop_graph(const char *graphname)
 	heap_close(ag_graphmeta, RowExclusiveLock);
 }
 
+/*
+ * agstat_count_vertex_expand - count a vertex expanded by a graph traversal
+ *
+ * The count goes to the table of the label of the vertex, which is looked up
+ * in the given graph.
+ */
+void
+agstat_count_vertex_expand(Oid graphoid, Graphid vid)
+{
+	LabelCacheEntry *entry;
+	PgStat_TableStatus *pgstat_info;
+
+	if (pgStatSock == PGINVALID_SOCKET || !pgstat_track_counts ||
+		!OidIsValid(graphoid))
+		return;
+
+	entry = LookupLabelCache(graphoid, GraphidGetLabid(vid), false);
+	if (entry == NULL)
+		return;
+
+	pgstat_info = get_tabstat_entry(entry->relid, false);
+	pgstat_info->t_counts.t_graph_expanded++;
+}
+
+/*
+ * agstat_count_merge_match - count an element of a pattern matched by MERGE
+ */
+void
+agstat_count_merge_match(Oid relid)
+{
+	PgStat_TableStatus *pgstat_info;
+
+	if (pgStatSock == PGINVALID_SOCKET || !pgstat_track_counts)
+		return;
+
+	pgstat_info = get_tabstat_entry(relid, false);
+	pgstat_info->t_counts.t_graph_merge_matched++;
+}
+
 /* ----------
  * AtEOXact_AgStat
  *
@@ -71,6 +71,7 @@
 #include "tcop/pquery.h"
 #include "tcop/tcopprot.h"
 #include "tcop/utility.h"
+#include "utils/cypherplancache.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/ps_status.h"
@@ -1004,6 +1005,7 @@ exec_simple_query(const char *query_string)
 		char		completionTag[COMPLETION_TAG_BUFSIZE];
 		List	   *querytree_list,
 				   *plantree_list;
+		CachedPlan *cplan = NULL;
 		Portal		portal;
 		DestReceiver *receiver;
 		int16		format;
@@ -1069,11 +1071,26 @@ exec_simple_query(const char *query_string)
 		 */
 		oldcontext = MemoryContextSwitchTo(MessageContext);
 
-		querytree_list = pg_analyze_and_rewrite(parsetree, query_string,
-												NULL, 0, NULL);
+		/*
+		 * Cypher statements can reuse the plan made for the same statement
+		 * before.  See cypherplancache.c.
+		 */
+		if (cypher_plan_cache_size > 0 && IsA(parsetree->stmt, CypherStmt))
+		{
+			CachedPlanSource *psrc;
+
+			psrc = GetCypherPlanSource(parsetree, query_string, commandTag);
+			cplan = GetCachedPlan(psrc, NULL, false, NULL);
+			plantree_list = cplan->stmt_list;
+		}
+		else
+		{
+			querytree_list = pg_analyze_and_rewrite(parsetree, query_string,
+													NULL, 0, NULL);
 
-		plantree_list = pg_plan_queries(querytree_list,
-										CURSOR_OPT_PARALLEL_OK, NULL);
+			plantree_list = pg_plan_queries(querytree_list,
+											CURSOR_OPT_PARALLEL_OK, NULL);
+		}
 
 		/* Done with the snapshot used for parsing/planning */
 		if (snapshot_set)
@@ -1092,15 +1109,15 @@ exec_simple_query(const char *query_string)
 
 		/*
 		 * We don't have to copy anything into the portal, because everything
-		 * we are passing here is in MessageContext, which will outlive the
-		 * portal anyway.
+		 * we are passing here is in MessageContext or in the cached plan,
+		 * which will outlive the portal anyway.
 		 */
 		PortalDefineQuery(portal,
 						  NULL,
 						  query_string,
 						  commandTag,
 						  plantree_list,
-						  NULL);
+						  cplan);
 
 		/*
 		 * Start the portal.  No parameters here.
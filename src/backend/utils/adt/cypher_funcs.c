@@ -19,8 +19,12 @@
 #include "funcapi.h"
 #include "utils/builtins.h"
 #include "utils/cypher_funcs.h"
+#include "utils/datum.h"
+#include "utils/fmgroids.h"
 #include "utils/jsonb.h"
 #include "utils/memutils.h"
+#include "utils/numeric.h"
+#include "utils/rel.h"
 #include <string.h>
 
 /* global variable - see postgres.c*/
@@ -1215,6 +1219,256 @@ jsonb_string_regex(PG_FUNCTION_ARGS)
 	PG_RETURN_NULL();
 }
 
+/*
+ * Promoted properties
+ *
+ * A property of a label can be promoted to a typed column of the label
+ * (ALTER VLABEL ... PROMOTE PROPERTY). The column always holds the value of
+ * the property converted by the functions below, so comparisons of the
+ * property with a constant can be done on the column instead. Only types
+ * that order their values the same way jsonb does are allowed.
+ */
+
+/*
+ * Get the promoted properties of the label `rel`. They are read from the
+ * CHECK constraints that PROMOTE PROPERTY adds,
+ *
+ *   CHECK (col IS NOT DISTINCT FROM promote_property(properties, 'key', ...))
+ *
+ * so other columns that may have been added to the label are not mistaken for
+ * promoted properties.
+ */
+List *
+RelationGetPromotedProperties(Relation rel)
+{
+	TupleConstr *constr = RelationGetDescr(rel)->constr;
+	List	   *result = NIL;
+	int			i;
+
+	if (constr == NULL)
+		return NIL;
+
+	for (i = 0; i < constr->num_check; i++)
+	{
+		Node	   *expr;
+		DistinctExpr *distinct;
+		Var		   *col;
+		FuncExpr   *func;
+		Const	   *key;
+		PromotedProperty *prop;
+
+		expr = stringToNode(constr->check[i].ccbin);
+		if (!IsA(expr, BoolExpr) ||
+			((BoolExpr *) expr)->boolop != NOT_EXPR)
+			continue;
+
+		distinct = (DistinctExpr *) linitial(((BoolExpr *) expr)->args);
+		if (!IsA(distinct, DistinctExpr) || list_length(distinct->args) != 2)
+			continue;
+
+		col = (Var *) linitial(distinct->args);
+		func = (FuncExpr *) lsecond(distinct->args);
+		if (!IsA(col, Var) || !IsA(func, FuncExpr) ||
+			func->funcid != F_PROMOTE_PROPERTY)
+			continue;
+
+		key = (Const *) lsecond(func->args);
+		if (!IsA(key, Const) || key->constisnull)
+			continue;
+
+		prop = palloc(sizeof(*prop));
+		prop->attnum = col->varattno;
+		prop->key = TextDatumGetCString(key->constvalue);
+		result = lappend(result, prop);
+	}
+
+	return result;
+}
+
+bool
+PropertyTypeIsPromotable(Oid typid)
+{
+	switch (typid)
+	{
+		case INT2OID:
+		case INT4OID:
+		case INT8OID:
+		case NUMERICOID:
+		case TEXTOID:
+		case BOOLOID:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Convert the scalar `jv` to a value of `typid`. Returns false if `jv` cannot
+ * be represented exactly.
+ */
+bool
+JsonbScalarToPropertyDatum(JsonbValue *jv, Oid typid, Datum *result)
+{
+	int64		i;
+
+	switch (typid)
+	{
+		case INT2OID:
+			if (jv->type != jbvNumeric ||
+				!numeric_is_int64(jv->val.numeric, &i) ||
+				i < PG_INT16_MIN || i > PG_INT16_MAX)
+				return false;
+			*result = Int16GetDatum((int16) i);
+			return true;
+		case INT4OID:
+			if (jv->type != jbvNumeric ||
+				!numeric_is_int64(jv->val.numeric, &i) ||
+				i < PG_INT32_MIN || i > PG_INT32_MAX)
+				return false;
+			*result = Int32GetDatum((int32) i);
+			return true;
+		case INT8OID:
+			if (jv->type != jbvNumeric ||
+				!numeric_is_int64(jv->val.numeric, &i))
+				return false;
+			*result = Int64GetDatum(i);
+			return true;
+		case NUMERICOID:
+			if (jv->type != jbvNumeric)
+				return false;
+			*result = datumCopy(NumericGetDatum(jv->val.numeric), false, -1);
+			return true;
+		case TEXTOID:
+			if (jv->type != jbvString)
+				return false;
+			*result = PointerGetDatum(
+						cstring_to_text_with_len(jv->val.string.val,
+												 jv->val.string.len));
+			return true;
+		case BOOLOID:
+			if (jv->type != jbvBool)
+				return false;
+			*result = BoolGetDatum(jv->val.boolean);
+			return true;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Get the value of the promoted property `key` from `props`. A missing
+ * property is NULL.
+ */
+Datum
+getPromotedPropertyDatum(Jsonb *props, const char *key, Oid typid,
+						 bool *isnull)
+{
+	JsonbValue	kv;
+	JsonbValue *jv;
+	Datum		result;
+
+	kv.type = jbvString;
+	kv.val.string.val = (char *) key;
+	kv.val.string.len = strlen(key);
+
+	jv = findJsonbValueFromContainer(&props->root, JB_FOBJECT, &kv);
+	if (jv == NULL)
+	{
+		*isnull = true;
+		return (Datum) 0;
+	}
+
+	if (!JsonbScalarToPropertyDatum(jv, typid, &result))
+		ereport(ERROR,
+				(errcode(ERRCODE_DATATYPE_MISMATCH),
+				 errmsg("property \"%s\" cannot be stored as %s",
+						key, format_type_be(typid))));
+
+	*isnull = false;
+	return result;
+}
+
+/*
+ * promote_property(properties, key, NULL::type) computes promoted columns in
+ * ALTER VLABEL ... PROMOTE PROPERTY and their CHECK constraints.
+ */
+Datum
+promote_property(PG_FUNCTION_ARGS)
+{
+	Jsonb	   *props;
+	char	   *key;
+	Oid			typid;
+	Datum		result;
+	bool		isnull;
+
+	if (PG_ARGISNULL(0) || PG_ARGISNULL(1))
+		PG_RETURN_NULL();
+
+	props = PG_GETARG_JSONB_P(0);
+	key = text_to_cstring(PG_GETARG_TEXT_PP(1));
+	typid = get_fn_expr_argtype(fcinfo->flinfo, 2);
+
+	if (!JB_ROOT_IS_OBJECT(props))
+		PG_RETURN_NULL();
+
+	result = getPromotedPropertyDatum(props, key, typid, &isnull);
+	if (isnull)
+		PG_RETURN_NULL();
+
+	PG_RETURN_DATUM(result);
+}
+
+/*
+ * Elements of a list for UNWIND.
+ *
+ * jsonb_array_elements() puts all the elements into a tuplestore before
+ * returning the first one. This returns them one by one straight from the
+ * list, so UNWIND of a large list neither copies the whole list nor spills
+ * it to disk, and stops early under LIMIT.
+ */
+Datum
+cypher_unwind(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	JsonbArrayIterator *it;
+	JsonbValue *elem;
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		MemoryContext oldcontext;
+		Jsonb	   *list;
+
+		funcctx = SRF_FIRSTCALL_INIT();
+		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		/* the list must stay until the last element is returned */
+		list = PG_GETARG_JSONB_P(0);
+		if (JB_ROOT_IS_SCALAR(list))
+			ereport(ERROR,
+					(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+					 errmsg("cannot extract elements from a scalar")));
+		else if (!JB_ROOT_IS_ARRAY(list))
+			ereport(ERROR,
+					(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+					 errmsg("cannot extract elements from an object")));
+
+		it = palloc(sizeof(*it));
+		JsonbArrayIteratorInit(it, &list->root);
+		funcctx->user_fctx = it;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+	it = (JsonbArrayIterator *) funcctx->user_fctx;
+
+	elem = JsonbArrayIteratorNext(it);
+	if (elem != NULL)
+		SRF_RETURN_NEXT(funcctx, JsonbPGetDatum(JsonbValueToJsonb(elem)));
+
+	SRF_RETURN_DONE(funcctx);
+}
+
 /*
  * Function to return a row containing the columns for the respective values
  * of insertVertex, insertEdge, deleteVertex, deleteEdge, and updateProperty.
@@ -10,6 +10,7 @@
 
 #include "postgres.h"
 
+#include "common/int.h"
 #include "utils/builtins.h"
 #include "utils/cypher_ops.h"
 #include "utils/datum.h"
@@ -19,6 +20,8 @@
 #include "utils/numeric.h"
 
 static Jsonb *jnumber_op(PGFunction f, Jsonb *l, Jsonb *r);
+static Jsonb *jnumber_compute(PGFunction f, Numeric l, Numeric r);
+static bool int64_op(PGFunction f, int64 l, int64 r, int64 *result);
 static Jsonb *numeric_to_jnumber(Numeric n);
 static void ereport_op(PGFunction f, Jsonb *l, Jsonb *r);
 static void ereport_op_str(const char *op, Jsonb *l, Jsonb *r);
@@ -111,11 +114,8 @@ jsonb_add(PG_FUNCTION_ARGS)
 	}
 	else if (ljv->type == jbvNumeric && rjv->type == jbvNumeric)
 	{
-		n = DirectFunctionCall2(numeric_add,
-								NumericGetDatum(ljv->val.numeric),
-								NumericGetDatum(rjv->val.numeric));
-
-		PG_RETURN_JSONB_P(numeric_to_jnumber(DatumGetNumeric(n)));
+		PG_RETURN_JSONB_P(jnumber_compute(numeric_add, ljv->val.numeric,
+										  rjv->val.numeric));
 	}
 	else
 	{
@@ -175,33 +175,61 @@ jsonb_uminus(PG_FUNCTION_ARGS)
 static Jsonb *
 jnumber_op(PGFunction f, Jsonb *l, Jsonb *r)
 {
-	FunctionCallInfoData fcinfo;
 	JsonbValue *jv;
-	Datum		n;
+	Numeric		ln = NULL;
 
 	AssertArg(r != NULL);
 
 	if (!((l == NULL || JB_ROOT_IS_SCALAR(l)) && JB_ROOT_IS_SCALAR(r)))
 		ereport_op(f, l, r);
 
-	InitFunctionCallInfoData(fcinfo, NULL, 0, InvalidOid, NULL, NULL);
-
 	if (l != NULL)
 	{
 		jv = getIthJsonbValueFromContainer(&l->root, 0);
 		if (jv->type != jbvNumeric)
 			ereport_op(f, l, r);
 
-		fcinfo.arg[fcinfo.nargs] = NumericGetDatum(jv->val.numeric);
-		fcinfo.argnull[fcinfo.nargs] = false;
-		fcinfo.nargs++;
+		ln = jv->val.numeric;
 	}
 
 	jv = getIthJsonbValueFromContainer(&r->root, 0);
 	if (jv->type != jbvNumeric)
 		ereport_op(f, l, r);
 
-	fcinfo.arg[fcinfo.nargs] = NumericGetDatum(jv->val.numeric);
+	return jnumber_compute(f, ln, jv->val.numeric);
+}
+
+/*
+ * Apply f to numbers l (NULL for unary operators) and r.
+ *
+ * Most numbers in graph data are integers. If both operands are integers that
+ * fit in int64, compute the result in int64 and fall back to Numeric only if
+ * it overflows or is not an integer.
+ */
+static Jsonb *
+jnumber_compute(PGFunction f, Numeric l, Numeric r)
+{
+	FunctionCallInfoData fcinfo;
+	int64		li = 0;
+	int64		ri;
+	int64		res;
+	Datum		n;
+
+	if ((l == NULL || numeric_is_int64(l, &li)) &&
+		numeric_is_int64(r, &ri) &&
+		int64_op(f, li, ri, &res))
+		return numeric_to_jnumber(int64_to_numeric(res));
+
+	InitFunctionCallInfoData(fcinfo, NULL, 0, InvalidOid, NULL, NULL);
+
+	if (l != NULL)
+	{
+		fcinfo.arg[fcinfo.nargs] = NumericGetDatum(l);
+		fcinfo.argnull[fcinfo.nargs] = false;
+		fcinfo.nargs++;
+	}
+
+	fcinfo.arg[fcinfo.nargs] = NumericGetDatum(r);
 	fcinfo.argnull[fcinfo.nargs] = false;
 	fcinfo.nargs++;
 
@@ -222,15 +250,88 @@ jnumber_op(PGFunction f, Jsonb *l, Jsonb *r)
 	return numeric_to_jnumber(DatumGetNumeric(n));
 }
 
-static Jsonb *
-numeric_to_jnumber(Numeric n)
+/*
+ * Compute f on int64 operands. Returns false if the result would differ from
+ * the Numeric one (overflow, division by zero, inexact division, negative
+ * or large exponent) so that the caller falls back to Numeric and its error
+ * reporting.
+ */
+static bool
+int64_op(PGFunction f, int64 l, int64 r, int64 *result)
 {
-	JsonbValue	jv;
+	if (f == numeric_add)
+		return !pg_add_s64_overflow(l, r, result);
+	else if (f == numeric_sub)
+		return !pg_sub_s64_overflow(l, r, result);
+	else if (f == numeric_mul)
+		return !pg_mul_s64_overflow(l, r, result);
+	else if (f == numeric_div)
+	{
+		/*
+		 * numeric_div() rounds the quotient before it is truncated, so only
+		 * exact quotients are guaranteed to be the same.
+		 */
+		if (r == 0 || (r == -1 && l == PG_INT64_MIN) || l % r != 0)
+			return false;
+		*result = l / r;
+		return true;
+	}
+	else if (f == numeric_mod)
+	{
+		if (r == 0)
+			return false;
+		/* avoid INT64_MIN % -1 */
+		*result = (r == -1 ? 0 : l % r);
+		return true;
+	}
+	else if (f == numeric_power)
+	{
+		int64		base = l;
+		int64		val = 1;
+
+		/*
+		 * Any base other than 0, 1 and -1 overflows int64 well before 64.
+		 * Larger exponents are left to numeric_power(), which does not
+		 * treat them as integers (it errors on a negative base, for one).
+		 */
+		if (r < 0 || r > 64)
+			return false;
+
+		/* exponentiation by squaring */
+		while (r > 0)
+		{
+			if (r & 1)
+			{
+				if (pg_mul_s64_overflow(val, base, &val))
+					return false;
+			}
+			r >>= 1;
+			if (r > 0 && pg_mul_s64_overflow(base, base, &base))
+				return false;
+		}
+		*result = val;
+		return true;
+	}
+	else if (f == numeric_uplus)
+	{
+		*result = r;
+		return true;
+	}
+	else if (f == numeric_uminus)
+	{
+		if (r == PG_INT64_MIN)
+			return false;
+		*result = -r;
+		return true;
+	}
 
-	jv.type = jbvNumeric;
-	jv.val.numeric = n;
+	return false;
+}
 
-	return JsonbValueToJsonb(&jv);
+static Jsonb *
+numeric_to_jnumber(Numeric n)
+{
+	return NumericToJsonb(n);
 }
 
 static void
@@ -18,7 +18,6 @@
 #include "catalog/ag_label.h"
 #include "catalog/namespace.h"
 #include "catalog/pg_type.h"
-#include "catalog/pg_inherits.h"
 #include "executor/spi.h"
 #include "funcapi.h"
 #include "libpq/libpq.h"
@@ -28,6 +27,7 @@
 #include "utils/builtins.h"
 #include "utils/graph.h"
 #include "utils/jsonb.h"
+#include "utils/labelcache.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/regproc.h"
@@ -37,6 +37,11 @@
 #define GRAPHID_FMTSTR			"%hu." UINT64_FORMAT
 #define GRAPHID_BUFLEN			32	/* "65535.281474976710655" */
 
+typedef struct LabidCacheData {
+	char	   *labname;
+	uint16		labid;
+} LabidCacheData;
+
 typedef struct LabelOutData {
 	uint16		label_labid;
 	NameData	label;
@@ -53,7 +58,6 @@ typedef enum EdgeVertexKind {
 } EdgeVertexKind;
 
 typedef struct LabelsOutData {
-	MemoryContext mctx;
 	uint16		label_labid;
 	Jsonb	   *labels;
 } LabelsOutData;
@@ -70,7 +74,13 @@ static void get_elem_type_output(ArrayMetaState *state, Oid elem_type,
 static Datum array_iter_next_(array_iter *it, bool *isnull, int idx,
 							  ArrayMetaState *state);
 static void deform_tuple(HeapTupleHeader tuphdr, Datum *values, bool *isnull);
+static void deform_vertex(HeapTupleHeader vertex, Datum *values, bool *isnull);
+static void deform_edge(HeapTupleHeader edge, Datum *values, bool *isnull);
+static void send_properties(StringInfo buf, Datum prop_map);
+static Datum recv_properties(StringInfo buf);
+static Datum makeInvalidTidDatum(void);
 static Datum tuple_getattr(HeapTupleHeader tuphdr, int attnum);
+static Datum elem_getattr(HeapTupleHeader tuphdr, int attnum);
 static Datum getEdgeVertex(HeapTupleHeader edge, EdgeVertexKind evk);
 static LabelsOutData *cache_labels(FmgrInfo *flinfo, uint16 labid);
 static Datum makeArrayTypeDatum(Datum *elems, int nelem, Oid type);
@@ -195,20 +205,44 @@ graphid_locid(PG_FUNCTION_ARGS)
 	PG_RETURN_INT64(GraphidGetLocid(id));
 }
 
+/*
+ * graph_labid() is used in the DEFAULT expression of the id column of every
+ * label, so it is called for each element being created. The argument is
+ * always a constant, so resolve it once and keep the result in fn_extra.
+ */
 Datum
 graph_labid(PG_FUNCTION_ARGS)
 {
 	char	   *labname = PG_GETARG_CSTRING(0);
+	LabidCacheData *my_extra;
 	List	   *names;
 	RangeVar   *rv;
 	Oid			graphoid;
 	uint16		labid;
 
+	my_extra = (LabidCacheData *) fcinfo->flinfo->fn_extra;
+	if (my_extra != NULL && strcmp(my_extra->labname, labname) == 0)
+		PG_RETURN_INT32((int32) my_extra->labid);
+
 	names = stringToQualifiedNameList(labname);
 	rv = makeRangeVarFromNameList(names);
 	graphoid = get_graphname_oid(rv->schemaname);
 	labid = get_labname_labid(rv->relname, graphoid);
 
+	if (my_extra == NULL)
+	{
+		fcinfo->flinfo->fn_extra = MemoryContextAllocZero(
+										fcinfo->flinfo->fn_mcxt,
+										sizeof(*my_extra));
+		my_extra = (LabidCacheData *) fcinfo->flinfo->fn_extra;
+	}
+	else
+	{
+		pfree(my_extra->labname);
+	}
+	my_extra->labname = MemoryContextStrdup(fcinfo->flinfo->fn_mcxt, labname);
+	my_extra->labid = labid;
+
 	PG_RETURN_INT32((int32) labid);
 }
 
@@ -416,16 +450,7 @@ vertex_out(PG_FUNCTION_ARGS)
 	LabelOutData *my_extra;
 	StringInfoData si;
 
-	deform_tuple(vertex, values, isnull);
-
-	if (isnull[Anum_vertex_id - 1])
-		ereport(ERROR,
-				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
-				 errmsg("id in vertex cannot be NULL")));
-	if (isnull[Anum_vertex_properties - 1])
-		ereport(ERROR,
-				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
-				 errmsg("properties in vertex cannot be NULL")));
+	deform_vertex(vertex, values, isnull);
 
 	id = DatumGetGraphid(values[Anum_vertex_id - 1]);
 	prop_map = DatumGetJsonbP(values[Anum_vertex_properties - 1]);
@@ -453,6 +478,62 @@ _vertex_out(PG_FUNCTION_ARGS)
 	PG_RETURN_CSTRING(si.data);
 }
 
+/*
+ * Binary I/O of graph types
+ *
+ * vertex    : id, label, properties
+ * edge      : id, label, start, end, properties
+ * graphpath : nlabels, (labid, label) * nlabels,
+ *             nvertices, (id, properties) * nvertices,
+ *             nedges, (id, start, end, properties) * nedges
+ *
+ * id, start and end are int8, labid is int2, nlabels, nvertices and nedges
+ * are int4, and label is a null-terminated string. properties is int4 length
+ * followed by the binary format of jsonb (version 1). Elements in graphpath
+ * do not carry their label because the label ID is a part of the id; the
+ * names of all labels in the graphpath are sent once, up front instead.
+ *
+ * The tid of vertex and edge is not sent since it is meaningful only within
+ * the backend; it is set to an invalid one on input. Label names are ignored
+ * on input.
+ */
+Datum
+vertex_recv(PG_FUNCTION_ARGS)
+{
+	StringInfo	buf = (StringInfo) PG_GETARG_POINTER(0);
+	Datum		id;
+	Datum		prop_map;
+
+	id = GraphidGetDatum((Graphid) pq_getmsgint64(buf));
+	(void) pq_getmsgstring(buf);
+	prop_map = recv_properties(buf);
+
+	PG_RETURN_DATUM(makeGraphVertexDatum(id, prop_map,
+										 makeInvalidTidDatum()));
+}
+
+Datum
+vertex_send(PG_FUNCTION_ARGS)
+{
+	HeapTupleHeader vertex = PG_GETARG_HEAPTUPLEHEADER(0);
+	Datum		values[Natts_vertex];
+	bool		isnull[Natts_vertex];
+	LabelOutData *my_extra;
+	StringInfoData buf;
+
+	deform_vertex(vertex, values, isnull);
+
+	my_extra = cache_label(fcinfo->flinfo,
+						   GraphidGetLabid(values[Anum_vertex_id - 1]));
+
+	pq_begintypsend(&buf);
+	pq_sendint64(&buf, DatumGetGraphid(values[Anum_vertex_id - 1]));
+	pq_sendstring(&buf, NameStr(my_extra->label));
+	send_properties(&buf, values[Anum_vertex_properties - 1]);
+
+	PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
+}
+
 Datum
 vertex_label(PG_FUNCTION_ARGS)
 {
@@ -504,7 +585,7 @@ vtojb(PG_FUNCTION_ARGS)
 {
 	HeapTupleHeader vertex = PG_GETARG_HEAPTUPLEHEADER(0);
 
-	PG_RETURN_DATUM(tuple_getattr(vertex, Anum_vertex_properties));
+	PG_RETURN_DATUM(elem_getattr(vertex, Anum_vertex_properties));
 }
 
 Datum
@@ -572,24 +653,7 @@ edge_out(PG_FUNCTION_ARGS)
 	LabelOutData *my_extra;
 	StringInfoData si;
 
-	deform_tuple(edge, values, isnull);
-
-	if (isnull[Anum_edge_id - 1])
-		ereport(ERROR,
-				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
-				 errmsg("id in edge cannot be NULL")));
-	if (isnull[Anum_edge_start - 1])
-		ereport(ERROR,
-				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
-				 errmsg("start in edge cannot be NULL")));
-	if (isnull[Anum_edge_end - 1])
-		ereport(ERROR,
-				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
-				 errmsg("end in edge cannot be NULL")));
-	if (isnull[Anum_edge_properties - 1])
-		ereport(ERROR,
-				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
-				 errmsg("properties in edge cannot be NULL")));
+	deform_edge(edge, values, isnull);
 
 	id = DatumGetGraphid(values[Anum_edge_id - 1]);
 	prop_map = DatumGetJsonbP(values[Anum_edge_properties - 1]);
@@ -621,6 +685,49 @@ _edge_out(PG_FUNCTION_ARGS)
 	PG_RETURN_CSTRING(si.data);
 }
 
+Datum
+edge_recv(PG_FUNCTION_ARGS)
+{
+	StringInfo	buf = (StringInfo) PG_GETARG_POINTER(0);
+	Datum		id;
+	Datum		start;
+	Datum		end;
+	Datum		prop_map;
+
+	id = GraphidGetDatum((Graphid) pq_getmsgint64(buf));
+	(void) pq_getmsgstring(buf);
+	start = GraphidGetDatum((Graphid) pq_getmsgint64(buf));
+	end = GraphidGetDatum((Graphid) pq_getmsgint64(buf));
+	prop_map = recv_properties(buf);
+
+	PG_RETURN_DATUM(makeGraphEdgeDatum(id, start, end, prop_map,
+									   makeInvalidTidDatum()));
+}
+
+Datum
+edge_send(PG_FUNCTION_ARGS)
+{
+	HeapTupleHeader edge = PG_GETARG_HEAPTUPLEHEADER(0);
+	Datum		values[Natts_edge];
+	bool		isnull[Natts_edge];
+	LabelOutData *my_extra;
+	StringInfoData buf;
+
+	deform_edge(edge, values, isnull);
+
+	my_extra = cache_label(fcinfo->flinfo,
+						   GraphidGetLabid(values[Anum_edge_id - 1]));
+
+	pq_begintypsend(&buf);
+	pq_sendint64(&buf, DatumGetGraphid(values[Anum_edge_id - 1]));
+	pq_sendstring(&buf, NameStr(my_extra->label));
+	pq_sendint64(&buf, DatumGetGraphid(values[Anum_edge_start - 1]));
+	pq_sendint64(&buf, DatumGetGraphid(values[Anum_edge_end - 1]));
+	send_properties(&buf, values[Anum_edge_properties - 1]);
+
+	PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
+}
+
 Datum
 edge_label(PG_FUNCTION_ARGS)
 {
@@ -658,7 +765,7 @@ etojb(PG_FUNCTION_ARGS)
 {
 	HeapTupleHeader edge = PG_GETARG_HEAPTUPLEHEADER(0);
 
-	PG_RETURN_DATUM(tuple_getattr(edge, Anum_edge_properties));
+	PG_RETURN_DATUM(elem_getattr(edge, Anum_edge_properties));
 }
 
 Datum
@@ -715,20 +822,22 @@ edge_ge(PG_FUNCTION_ARGS)
 	PG_RETURN_DATUM(DirectFunctionCall2(graphid_ge, id1, id2) >= 0);
 }
 
+/*
+ * The last label is kept in fn_extra. Other labels are fetched from the
+ * backend-local label cache, so that rows of many labels are cheap as well.
+ */
 static LabelOutData *
 cache_label(FmgrInfo *flinfo, uint16 labid)
 {
-	MemoryContext oldMemoryContext;
 	LabelOutData *my_extra;
 
 	AssertArg(flinfo != NULL);
 
-	oldMemoryContext = MemoryContextSwitchTo(flinfo->fn_mcxt);
-
 	my_extra = (LabelOutData *) flinfo->fn_extra;
 	if (my_extra == NULL)
 	{
-		flinfo->fn_extra = palloc(sizeof(*my_extra));
+		flinfo->fn_extra = MemoryContextAlloc(flinfo->fn_mcxt,
+											  sizeof(*my_extra));
 		my_extra = (LabelOutData *) flinfo->fn_extra;
 		my_extra->label_labid = 0;
 		MemSetLoop(NameStr(my_extra->label), '\0', sizeof(my_extra->label));
@@ -736,19 +845,16 @@ cache_label(FmgrInfo *flinfo, uint16 labid)
 
 	if (my_extra->label_labid != labid)
 	{
-		Oid			graphoid = get_graph_path_oid();
-		char	   *label;
+		LabelCacheEntry *entry;
 
-		label = get_labid_labname(graphoid, labid);
-		if (label == NULL)
+		entry = LookupLabelCache(get_graph_path_oid(), labid, false);
+		if (entry == NULL)
 			elog(ERROR, "cache lookup failed for label %hu", labid);
 
 		my_extra->label_labid = labid;
-		strncpy(NameStr(my_extra->label), label, sizeof(my_extra->label));
+		namecpy(&my_extra->label, &entry->labname);
 	}
 
-	MemoryContextSwitchTo(oldMemoryContext);
-
 	return my_extra;
 }
 
@@ -875,6 +981,236 @@ graphpath_out(PG_FUNCTION_ARGS)
 	PG_RETURN_CSTRING(si.data);
 }
 
+Datum
+graphpath_recv(PG_FUNCTION_ARGS)
+{
+	StringInfo	buf = (StringInfo) PG_GETARG_POINTER(0);
+	int			nlabels;
+	int			nvertices;
+	int			nedges;
+	Datum	   *vertices;
+	Datum	   *edges;
+	int			i;
+
+	nlabels = pq_getmsgint(buf, 4);
+	if (nlabels < 0 || nlabels > GRAPHID_LABID_MAX + 1)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_BINARY_REPRESENTATION),
+				 errmsg("invalid number of labels: %d", nlabels)));
+	for (i = 0; i < nlabels; i++)
+	{
+		(void) pq_getmsgint(buf, 2);
+		(void) pq_getmsgstring(buf);
+	}
+
+	nvertices = pq_getmsgint(buf, 4);
+	if (nvertices < 0 || nvertices > (buf->len - buf->cursor))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_BINARY_REPRESENTATION),
+				 errmsg("invalid number of vertices: %d", nvertices)));
+	vertices = palloc(sizeof(*vertices) * nvertices);
+	for (i = 0; i < nvertices; i++)
+	{
+		Datum		id;
+		Datum		prop_map;
+
+		id = GraphidGetDatum((Graphid) pq_getmsgint64(buf));
+		prop_map = recv_properties(buf);
+
+		vertices[i] = makeGraphVertexDatum(id, prop_map,
+										   makeInvalidTidDatum());
+	}
+
+	nedges = pq_getmsgint(buf, 4);
+	if (nedges < 0 || nedges > (buf->len - buf->cursor))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_BINARY_REPRESENTATION),
+				 errmsg("invalid number of edges: %d", nedges)));
+	if (nedges != (nvertices > 0 ? nvertices - 1 : 0))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_BINARY_REPRESENTATION),
+				 errmsg("the numbers of vertices and edges are mismatched")));
+	edges = palloc(sizeof(*edges) * (nedges + 1));
+	for (i = 0; i < nedges; i++)
+	{
+		Datum		id;
+		Datum		start;
+		Datum		end;
+		Datum		prop_map;
+
+		id = GraphidGetDatum((Graphid) pq_getmsgint64(buf));
+		start = GraphidGetDatum((Graphid) pq_getmsgint64(buf));
+		end = GraphidGetDatum((Graphid) pq_getmsgint64(buf));
+		prop_map = recv_properties(buf);
+
+		edges[i] = makeGraphEdgeDatum(id, start, end, prop_map,
+									  makeInvalidTidDatum());
+	}
+
+	PG_RETURN_DATUM(makeGraphpathDatum(vertices, nvertices, edges, nedges));
+}
+
+Datum
+graphpath_send(PG_FUNCTION_ARGS)
+{
+	Datum		vertices_datum;
+	Datum		edges_datum;
+	Datum	   *vertices;
+	Datum	   *edges;
+	bool	   *vnulls;
+	bool	   *enulls;
+	int			nvertices;
+	int			nedges;
+	Bitmapset  *labids = NULL;
+	Oid			graphoid;
+	int			labid;
+	StringInfoData buf;
+	int			i;
+
+	getGraphpathArrays(PG_GETARG_DATUM(0), &vertices_datum, &edges_datum);
+
+	deconstruct_array(DatumGetArrayTypeP(vertices_datum), VERTEXOID,
+					  -1, false, 'd', &vertices, &vnulls, &nvertices);
+	deconstruct_array(DatumGetArrayTypeP(edges_datum), EDGEOID,
+					  -1, false, 'd', &edges, &enulls, &nedges);
+
+	/* deform elements once and collect labels */
+	for (i = 0; i < nvertices; i++)
+	{
+		Datum	   *values = palloc(sizeof(*values) * Natts_vertex);
+		bool		isnull[Natts_vertex];
+
+		if (vnulls[i])
+			ereport(ERROR,
+					(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+					 errmsg("vertex in graphpath cannot be NULL")));
+
+		deform_vertex(DatumGetHeapTupleHeader(vertices[i]), values, isnull);
+		labids = bms_add_member(labids,
+								GraphidGetLabid(values[Anum_vertex_id - 1]));
+		vertices[i] = PointerGetDatum(values);
+	}
+	for (i = 0; i < nedges; i++)
+	{
+		Datum	   *values = palloc(sizeof(*values) * Natts_edge);
+		bool		isnull[Natts_edge];
+
+		if (enulls[i])
+			ereport(ERROR,
+					(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+					 errmsg("edge in graphpath cannot be NULL")));
+
+		deform_edge(DatumGetHeapTupleHeader(edges[i]), values, isnull);
+		labids = bms_add_member(labids,
+								GraphidGetLabid(values[Anum_edge_id - 1]));
+		edges[i] = PointerGetDatum(values);
+	}
+
+	pq_begintypsend(&buf);
+
+	pq_sendint32(&buf, bms_num_members(labids));
+	graphoid = (labids == NULL ? InvalidOid : get_graph_path_oid());
+	labid = -1;
+	while ((labid = bms_next_member(labids, labid)) >= 0)
+	{
+		LabelCacheEntry *entry;
+
+		entry = LookupLabelCache(graphoid, (uint16) labid, false);
+		if (entry == NULL)
+			elog(ERROR, "cache lookup failed for label %d", labid);
+
+		pq_sendint16(&buf, (uint16) labid);
+		pq_sendstring(&buf, NameStr(entry->labname));
+	}
+
+	pq_sendint32(&buf, nvertices);
+	for (i = 0; i < nvertices; i++)
+	{
+		Datum	   *values = (Datum *) DatumGetPointer(vertices[i]);
+
+		pq_sendint64(&buf, DatumGetGraphid(values[Anum_vertex_id - 1]));
+		send_properties(&buf, values[Anum_vertex_properties - 1]);
+	}
+
+	pq_sendint32(&buf, nedges);
+	for (i = 0; i < nedges; i++)
+	{
+		Datum	   *values = (Datum *) DatumGetPointer(edges[i]);
+
+		pq_sendint64(&buf, DatumGetGraphid(values[Anum_edge_id - 1]));
+		pq_sendint64(&buf, DatumGetGraphid(values[Anum_edge_start - 1]));
+		pq_sendint64(&buf, DatumGetGraphid(values[Anum_edge_end - 1]));
+		send_properties(&buf, values[Anum_edge_properties - 1]);
+	}
+
+	PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
+}
+
+static void
+send_properties(StringInfo buf, Datum prop_map)
+{
+	bytea	   *outputbytes;
+
+	outputbytes = DatumGetByteaPP(DirectFunctionCall1(jsonb_send, prop_map));
+	pq_sendint32(buf, VARSIZE_ANY_EXHDR(outputbytes));
+	pq_sendbytes(buf, VARDATA_ANY(outputbytes), VARSIZE_ANY_EXHDR(outputbytes));
+	pfree(outputbytes);
+}
+
+/* See record_recv() */
+static Datum
+recv_properties(StringInfo buf)
+{
+	int			itemlen;
+	StringInfoData item_buf;
+	char		csave;
+	Datum		prop_map;
+
+	itemlen = pq_getmsgint(buf, 4);
+	if (itemlen < 0 || itemlen > (buf->len - buf->cursor))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_BINARY_REPRESENTATION),
+				 errmsg("insufficient data left in message")));
+
+	/*
+	 * Rather than copying data around, we just set up a phony StringInfo
+	 * pointing to the correct portion of the input buffer. We assume we can
+	 * scribble on the input buffer so as to maintain the convention that
+	 * StringInfos have a trailing null.
+	 */
+	item_buf.data = &buf->data[buf->cursor];
+	item_buf.maxlen = itemlen + 1;
+	item_buf.len = itemlen;
+	item_buf.cursor = 0;
+
+	buf->cursor += itemlen;
+
+	csave = buf->data[buf->cursor];
+	buf->data[buf->cursor] = '\0';
+
+	prop_map = DirectFunctionCall1(jsonb_recv, PointerGetDatum(&item_buf));
+
+	if (item_buf.cursor != itemlen)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_BINARY_REPRESENTATION),
+				 errmsg("improper binary format in properties")));
+
+	buf->data[buf->cursor] = csave;
+
+	return prop_map;
+}
+
+static Datum
+makeInvalidTidDatum(void)
+{
+	ItemPointer tid;
+
+	tid = (ItemPointer) palloc(sizeof(ItemPointerData));
+	ItemPointerSetInvalid(tid);
+
+	return ItemPointerGetDatum(tid);
+}
+
 static void
 get_elem_type_output(ArrayMetaState *state, Oid elem_type, MemoryContext mctx)
 {
@@ -905,12 +1241,12 @@ _graphpath_length(PG_FUNCTION_ARGS)
 Datum
 graphpath_length(PG_FUNCTION_ARGS)
 {
-	Datum		edges_datum;
+	HeapTupleHeader	graphpath = PG_GETARG_HEAPTUPLEHEADER(0);
 	AnyArrayType *edges;
 	int			nedges;
 
-	edges_datum = DirectFunctionCall1(graphpath_edges, PG_GETARG_DATUM(0));
-	edges = DatumGetAnyArrayP(edges_datum);
+	/* vertices are not needed to count edges */
+	edges = DatumGetAnyArrayP(tuple_getattr(graphpath, Anum_graphpath_edges));
 	nedges = ArrayGetNItems(AARR_NDIM(edges), AARR_DIMS(edges));
 
 	PG_RETURN_JSONB_P(int_to_jsonb(nedges));
@@ -919,21 +1255,17 @@ graphpath_length(PG_FUNCTION_ARGS)
 Datum
 graphpath_vertices(PG_FUNCTION_ARGS)
 {
-	Datum vertices_datum;
-
-	getGraphpathArrays(PG_GETARG_DATUM(0), &vertices_datum, NULL);
+	HeapTupleHeader	graphpath = PG_GETARG_HEAPTUPLEHEADER(0);
 
-	PG_RETURN_DATUM(vertices_datum);
+	PG_RETURN_DATUM(tuple_getattr(graphpath, Anum_graphpath_vertices));
 }
 
 Datum
 graphpath_edges(PG_FUNCTION_ARGS)
 {
-	Datum edges_datum;
+	HeapTupleHeader	graphpath = PG_GETARG_HEAPTUPLEHEADER(0);
 
-	getGraphpathArrays(PG_GETARG_DATUM(0), NULL, &edges_datum);
-
-	PG_RETURN_DATUM(edges_datum);
+	PG_RETURN_DATUM(tuple_getattr(graphpath, Anum_graphpath_edges));
 }
 
 static void
@@ -955,6 +1287,44 @@ deform_tuple(HeapTupleHeader tuphdr, Datum *values, bool *isnull)
 	ReleaseTupleDesc(tupDesc);
 }
 
+static void
+deform_vertex(HeapTupleHeader vertex, Datum *values, bool *isnull)
+{
+	deform_tuple(vertex, values, isnull);
+
+	if (isnull[Anum_vertex_id - 1])
+		ereport(ERROR,
+				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+				 errmsg("id in vertex cannot be NULL")));
+	if (isnull[Anum_vertex_properties - 1])
+		ereport(ERROR,
+				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+				 errmsg("properties in vertex cannot be NULL")));
+}
+
+static void
+deform_edge(HeapTupleHeader edge, Datum *values, bool *isnull)
+{
+	deform_tuple(edge, values, isnull);
+
+	if (isnull[Anum_edge_id - 1])
+		ereport(ERROR,
+				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+				 errmsg("id in edge cannot be NULL")));
+	if (isnull[Anum_edge_start - 1])
+		ereport(ERROR,
+				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+				 errmsg("start in edge cannot be NULL")));
+	if (isnull[Anum_edge_end - 1])
+		ereport(ERROR,
+				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+				 errmsg("end in edge cannot be NULL")));
+	if (isnull[Anum_edge_properties - 1])
+		ereport(ERROR,
+				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+				 errmsg("properties in edge cannot be NULL")));
+}
+
 static Datum
 tuple_getattr(HeapTupleHeader tuphdr, int attnum)
 {
@@ -979,6 +1349,39 @@ tuple_getattr(HeapTupleHeader tuphdr, int attnum)
 	return attdat;
 }
 
+/*
+ * elem_getattr
+ *		Fetch id, start, end or properties of a vertex/edge.
+ *
+ * These attributes are graphid's followed by the properties, so their offsets
+ * in the tuple are fixed as long as there is no NULL. This allows comparison,
+ * hashing and property access of elements without looking up the row type
+ * and walking the tuple every time. The attributes after the properties
+ * (tid) must be fetched using tuple_getattr().
+ */
+static Datum
+elem_getattr(HeapTupleHeader tuphdr, int attnum)
+{
+	Oid			tupType = HeapTupleHeaderGetTypeId(tuphdr);
+	char	   *tp;
+
+	Assert(attnum <= (tupType == EDGEOID ? Anum_edge_properties :
+					  Anum_vertex_properties));
+
+	if ((tupType != VERTEXOID && tupType != EDGEOID) ||
+		(tuphdr->t_infomask & HEAP_HASNULL))
+		return tuple_getattr(tuphdr, attnum);
+
+	/* graphid is aligned on a double and the properties are a varlena */
+	tp = (char *) tuphdr + tuphdr->t_hoff + (attnum - 1) * sizeof(Graphid);
+
+	if ((tupType == VERTEXOID && attnum == Anum_vertex_properties) ||
+		(tupType == EDGEOID && attnum == Anum_edge_properties))
+		return PointerGetDatum(tp);
+
+	return GraphidGetDatum(*((Graphid *) tp));
+}
+
 Datum
 edge_start_vertex(PG_FUNCTION_ARGS)
 {
@@ -1011,7 +1414,7 @@ getEdgeVertex(HeapTupleHeader edge, EdgeVertexKind evk)
 
 	snprintf(sqlcmd, sizeof(sqlcmd), querystr, get_graph_path(false));
 
-	values[0] = tuple_getattr(edge, attnum);
+	values[0] = elem_getattr(edge, attnum);
 
 	if (SPI_connect() != SPI_OK_CONNECT)
 		elog(ERROR, "SPI_connect failed");
@@ -1053,90 +1456,39 @@ vertex_labels(PG_FUNCTION_ARGS)
 static LabelsOutData *
 cache_labels(FmgrInfo *flinfo, uint16 labid)
 {
-	MemoryContext oldMemoryContext;
 	LabelsOutData *my_extra;
 
 	AssertArg(flinfo != NULL);
 
-	oldMemoryContext = MemoryContextSwitchTo(flinfo->fn_mcxt);
-
 	my_extra = (LabelsOutData *) flinfo->fn_extra;
 	if (my_extra == NULL)
 	{
-		flinfo->fn_extra = palloc(sizeof(*my_extra));
+		flinfo->fn_extra = MemoryContextAlloc(flinfo->fn_mcxt,
+											  sizeof(*my_extra));
 		my_extra = (LabelsOutData *) flinfo->fn_extra;
-		my_extra->mctx = AllocSetContextCreate(CurrentMemoryContext,
-											   "vertex_labels() cache",
-											   ALLOCSET_DEFAULT_SIZES);
 		my_extra->label_labid = 0;
 		my_extra->labels = NULL;
 	}
 
 	if (my_extra->label_labid != labid)
 	{
-		MemoryContext funcMemoryContext;
-		Oid			graphoid;
-		Oid			label_relid;
-		List	   *ancestor_relids;
-		JsonbParseState *jpstate = NULL;
-		ListCell   *li;
-		JsonbValue *labels;
-
-		if (my_extra->labels != NULL)
-			pfree(my_extra->labels);
-		MemoryContextReset(my_extra->mctx);
-
-		funcMemoryContext = MemoryContextSwitchTo(my_extra->mctx);
-
-		graphoid = get_graph_path_oid();
-
-		/* get relation IDs of ancestor labels */
-		label_relid = get_labid_relid(graphoid, labid);
-		ancestor_relids = find_all_ancestors(label_relid, AccessShareLock);
-
-		pushJsonbValue(&jpstate, WJB_BEGIN_ARRAY, NULL);
-
-		foreach(li, ancestor_relids)
-		{
-			Oid			ancestor_relid = lfirst_oid(li);
-			HeapTuple	tp;
-			char	   *ancestor_labname;
-
-			tp = SearchSysCache1(LABELRELID, ObjectIdGetDatum(ancestor_relid));
-			if (HeapTupleIsValid(tp))
-			{
-				Form_ag_label labtup = (Form_ag_label) GETSTRUCT(tp);
+		LabelCacheEntry *entry;
+		Jsonb	   *labels;
 
-				ancestor_labname = pstrdup(NameStr(labtup->labname));
-
-				ReleaseSysCache(tp);
-			}
-			else
-			{
-				elog(ERROR, "cache lookup failed for label %u", ancestor_relid);
-			}
-
-			if (strcmp(ancestor_labname, "ag_vertex") != 0)
-			{
-				JsonbValue	jv;
-
-				jv.type = jbvString;
-				jv.val.string.len = strlen(ancestor_labname);
-				jv.val.string.val = ancestor_labname;
-
-				pushJsonbValue(&jpstate, WJB_ELEM, &jv);
-			}
-		}
-
-		labels = pushJsonbValue(&jpstate, WJB_END_ARRAY, NULL);
+		entry = LookupLabelCache(get_graph_path_oid(), labid, true);
+		if (entry == NULL)
+			elog(ERROR, "cache lookup failed for label %hu", labid);
 
-		MemoryContextSwitchTo(funcMemoryContext);
+		/* copy it since the cache entry can be flushed at any time */
+		labels = MemoryContextAlloc(flinfo->fn_mcxt, VARSIZE(entry->labels));
+		memcpy(labels, entry->labels, VARSIZE(entry->labels));
 
-		my_extra->labels = JsonbValueToJsonb(labels);
+		if (my_extra->labels != NULL)
+			pfree(my_extra->labels);
+		my_extra->label_labid = labid;
+		my_extra->labels = labels;
 	}
 
-	MemoryContextSwitchTo(oldMemoryContext);
-
 	return my_extra;
 }
 
@@ -1145,7 +1497,7 @@ getVertexIdDatum(Datum datum)
 {
 	HeapTupleHeader	tuphdr = DatumGetHeapTupleHeader(datum);
 
-	return tuple_getattr(tuphdr, Anum_vertex_id);
+	return elem_getattr(tuphdr, Anum_vertex_id);
 }
 
 Datum
@@ -1153,7 +1505,7 @@ getVertexPropDatum(Datum datum)
 {
 	HeapTupleHeader	tuphdr = DatumGetHeapTupleHeader(datum);
 
-	return tuple_getattr(tuphdr, Anum_vertex_properties);
+	return elem_getattr(tuphdr, Anum_vertex_properties);
 }
 
 Datum
@@ -1169,7 +1521,7 @@ getEdgeIdDatum(Datum datum)
 {
 	HeapTupleHeader	tuphdr = DatumGetHeapTupleHeader(datum);
 
-	return tuple_getattr(tuphdr, Anum_edge_id);
+	return elem_getattr(tuphdr, Anum_edge_id);
 }
 
 Datum
@@ -1177,7 +1529,7 @@ getEdgeStartDatum(Datum datum)
 {
 	HeapTupleHeader	tuphdr = DatumGetHeapTupleHeader(datum);
 
-	return tuple_getattr(tuphdr, Anum_edge_start);
+	return elem_getattr(tuphdr, Anum_edge_start);
 }
 
 Datum
@@ -1185,7 +1537,7 @@ getEdgeEndDatum(Datum datum)
 {
 	HeapTupleHeader	tuphdr = DatumGetHeapTupleHeader(datum);
 
-	return tuple_getattr(tuphdr, Anum_edge_end);
+	return elem_getattr(tuphdr, Anum_edge_end);
 }
 
 Datum
@@ -1193,7 +1545,7 @@ getEdgePropDatum(Datum datum)
 {
 	HeapTupleHeader	tuphdr = DatumGetHeapTupleHeader(datum);
 
-	return tuple_getattr(tuphdr, Anum_edge_properties);
+	return elem_getattr(tuphdr, Anum_edge_properties);
 }
 
 Datum
@@ -0,0 +1,1375 @@
+/*
+ * graphalgo.c
+ *	  Built-in graph algorithms.
+ *
+ * The algorithms here load the edges of a label into a CSR (see
+ * graphprojection.c) and run over it in memory. Work is split into blocks
+ * of consecutive vertices that the participants, which are the backend and
+ * its parallel workers, claim one at a time. Algorithms that iterate move
+ * from one step to the next all together through a barrier, so a step sees
+ * the complete result of the step before it.
+ *
+ * Copyright (c) 2016 by Bitnine Global, Inc.
+ *
+ * IDENTIFICATION
+ *	  src/backend/utils/adt/graphalgo.c
+ */
+
+#include "postgres.h"
+
+#include <math.h>
+
+#include "access/parallel.h"
+#include "access/xact.h"
+#include "catalog/pg_type.h"
+#include "catalog/ag_graph_fn.h"
+#include "catalog/ag_label.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "optimizer/cost.h"
+#include "pgstat.h"
+#include "port/atomics.h"
+#include "storage/barrier.h"
+#include "utils/array.h"
+#include "utils/builtins.h"
+#include "utils/graphalgo.h"
+#include "utils/graphprojection.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/snapmgr.h"
+
+/* number of vertices in a unit of work */
+#define GRAPH_ALGO_BLOCK_SIZE	4096
+
+#define GRAPH_ALGO_NBLOCKS(nvertices) \
+	(((nvertices) + GRAPH_ALGO_BLOCK_SIZE - 1) / GRAPH_ALGO_BLOCK_SIZE)
+
+/* DSM keys of the CSR and of the chunks of memory an algorithm asks for */
+#define PARALLEL_KEY_CSR			UINT64CONST(0xA000000000000001)
+#define PARALLEL_KEY_CHUNK(n)		(UINT64CONST(0xA000000000000100) + (n))
+
+/* chunks of PageRank: shared state, score, contrib, dangling */
+#define PAGERANK_NCHUNKS	4
+/* chunks of WCC: shared state, parent */
+#define WCC_NCHUNKS			2
+/* chunks of triangle counting: shared state, fwd_off, fwd_adj, triangles */
+#define TRIANGLE_NCHUNKS	4
+/* chunks of random walks: shared state, starts, walks, lengths */
+#define RANDOMWALK_NCHUNKS	4
+
+/*
+ * A run of a graph algorithm. The chunks of memory and the CSR are in the DSM
+ * segment of the parallel context if parallel workers help, or in local
+ * memory otherwise.
+ */
+typedef struct GraphAlgoRun
+{
+	ParallelContext *pcxt;		/* NULL if the backend works alone */
+	GraphCSRData *data;			/* the CSR the participants work on */
+	Size	   *sizes;			/* size of each chunk */
+	int			nchunks;
+} GraphAlgoRun;
+
+/* state shared by the participants of a graph algorithm */
+typedef struct GraphAlgoShared
+{
+	Barrier		barrier;
+	int			nphases;
+	int64		nvertices;
+	int64		nblocks;
+	/* next block to claim, for even and odd phases */
+	pg_atomic_uint64 next_block[2];
+} GraphAlgoShared;
+
+typedef struct PageRankShared
+{
+	GraphAlgoShared algo;
+	float8		damping;
+} PageRankShared;
+
+/* what a participant of PageRank works on */
+typedef struct PageRankState
+{
+	PageRankShared *shared;
+	GraphCSR	csr;
+	float8	   *score;			/* score of each vertex */
+	float8	   *contrib;		/* score / out-degree of each vertex */
+	float8	   *dangling;		/* sum of scores of sinks in each block */
+} PageRankState;
+
+/* what a participant of WCC works on */
+typedef struct WccState
+{
+	GraphAlgoShared *shared;
+	GraphCSR	csr;
+	pg_atomic_uint32 *parent;	/* union-find forest over vertex ordinals */
+} WccState;
+
+/*
+ * What a participant of triangle counting works on. The forward neighbors of
+ * a vertex are its neighbors that come after it in the order of degree, in
+ * the order of their ordinals.
+ */
+typedef struct TriangleState
+{
+	GraphAlgoShared *shared;
+	int64	   *fwd_off;		/* nvertices + 1 offsets into fwd_adj */
+	uint32	   *fwd_adj;
+	pg_atomic_uint64 *triangles;	/* triangles of each vertex */
+} TriangleState;
+
+typedef struct RandomWalkShared
+{
+	GraphAlgoShared algo;		/* the work items are the start vertices */
+	int32		walk_length;
+	int32		walks_per_vertex;
+	uint64		seed;
+} RandomWalkShared;
+
+/*
+ * What a participant of random walks works on. Walk w of start vertex s is
+ * walks[(s * walks_per_vertex + w) * (walk_length + 1)] onwards, which are
+ * the ordinals of the vertices it visits, and its number of vertices is
+ * lengths[s * walks_per_vertex + w].
+ */
+typedef struct RandomWalkState
+{
+	RandomWalkShared *shared;
+	GraphCSR	csr;
+	int64	   *starts;			/* ordinal of each start vertex, or -1 */
+	uint32	   *walks;
+	uint32	   *lengths;
+} RandomWalkState;
+
+static int	graph_algo_nworkers(int64 nblocks);
+static void graph_algo_begin(GraphAlgoRun *run, const char *function_name,
+				 int64 nvertices, GraphCSRData *data, Size *sizes,
+				 int nchunks);
+static void *graph_algo_alloc(GraphAlgoRun *run, int chunk);
+static void *graph_algo_lookup(shm_toc *toc, int chunk);
+static void graph_algo_launch(GraphAlgoRun *run);
+static void *graph_algo_result(GraphAlgoRun *run, void *chunk, Size size);
+static void graph_algo_end(GraphAlgoRun *run);
+static void graph_algo_init_shared(GraphAlgoShared *shared, int nphases,
+					   int64 nvertices);
+static int64 graph_algo_next_block(GraphAlgoShared *shared, int phase,
+					  int64 *start, int64 *end);
+static int	graph_algo_end_phase(GraphAlgoShared *shared, int phase);
+static Oid	get_algo_graph_oid(FunctionCallInfo fcinfo, int argno);
+static Oid	get_algo_label_oid(FunctionCallInfo fcinfo, int argno,
+				   Oid graphid, char labkind);
+static Tuplestorestate *begin_algo_srf(FunctionCallInfo fcinfo,
+			   TupleDesc *tupdesc);
+static float8 *pagerank_compute(GraphCSRData *data, int iterations,
+				 float8 damping);
+static void pagerank_participate(PageRankState *state);
+static Oid *get_algo_label_oids(FunctionCallInfo fcinfo, int argno,
+					Oid graphid, int *nlabels);
+static void wcc_participate(WccState *state);
+static uint32 uf_find(pg_atomic_uint32 *parent, uint32 x);
+static uint64 *triangle_compute(FunctionCallInfo fcinfo, GraphCSR *csr,
+				 uint32 **degree);
+static int64 undirected_neighbors(GraphCSR *csr, int64 v, uint32 *buf);
+static void triangle_participate(TriangleState *state);
+static void uf_union(pg_atomic_uint32 *parent, uint32 x, uint32 y);
+static void random_walk_participate(RandomWalkState *state);
+static uint64 random_walk_next(uint64 *state);
+
+/*
+ * Decide how many parallel workers to use for nblocks blocks of work.
+ */
+static int
+graph_algo_nworkers(int64 nblocks)
+{
+	if (IsInParallelMode() || max_parallel_workers_per_gather <= 0)
+		return 0;
+
+	return (int) Min((int64) max_parallel_workers_per_gather, nblocks - 1);
+}
+
+/*
+ * Set up a run of a graph algorithm over nvertices vertices. If there are
+ * enough of them, parallel workers that start at function_name will share
+ * the work. data is the CSR for the workers, or NULL if they do not need it.
+ */
+static void
+graph_algo_begin(GraphAlgoRun *run, const char *function_name,
+				 int64 nvertices, GraphCSRData *data, Size *sizes,
+				 int nchunks)
+{
+	int			nworkers;
+	int			i;
+
+	run->pcxt = NULL;
+	run->data = data;
+	run->sizes = sizes;
+	run->nchunks = nchunks;
+
+	nworkers = graph_algo_nworkers(GRAPH_ALGO_NBLOCKS(nvertices));
+	if (nworkers <= 0)
+		return;
+
+	EnterParallelMode();
+	run->pcxt = CreateParallelContext("postgres", function_name, nworkers,
+									  true);
+
+	if (data != NULL)
+		shm_toc_estimate_chunk(&run->pcxt->estimator, graph_csr_size(data));
+	for (i = 0; i < nchunks; i++)
+		shm_toc_estimate_chunk(&run->pcxt->estimator, sizes[i]);
+	shm_toc_estimate_keys(&run->pcxt->estimator, nchunks + 1);
+
+	InitializeParallelDSM(run->pcxt);
+
+	/* if no DSM segment was available, work alone */
+	if (run->pcxt->seg == NULL)
+	{
+		DestroyParallelContext(run->pcxt);
+		ExitParallelMode();
+		run->pcxt = NULL;
+		return;
+	}
+
+	if (data == NULL)
+		return;
+
+	run->data = shm_toc_allocate(run->pcxt->toc, graph_csr_size(data));
+	memcpy(run->data, data, graph_csr_size(data));
+	shm_toc_insert(run->pcxt->toc, PARALLEL_KEY_CSR, run->data);
+}
+
+static void *
+graph_algo_alloc(GraphAlgoRun *run, int chunk)
+{
+	void	   *ptr;
+
+	Assert(chunk < run->nchunks);
+
+	if (run->pcxt == NULL)
+		return MemoryContextAllocHuge(CurrentMemoryContext,
+									  Max(run->sizes[chunk], 1));
+
+	ptr = shm_toc_allocate(run->pcxt->toc, run->sizes[chunk]);
+	shm_toc_insert(run->pcxt->toc, PARALLEL_KEY_CHUNK(chunk), ptr);
+
+	return ptr;
+}
+
+static void *
+graph_algo_lookup(shm_toc *toc, int chunk)
+{
+	return shm_toc_lookup(toc, PARALLEL_KEY_CHUNK(chunk), false);
+}
+
+static void
+graph_algo_launch(GraphAlgoRun *run)
+{
+	if (run->pcxt != NULL)
+		LaunchParallelWorkers(run->pcxt);
+}
+
+/*
+ * Wait for the parallel workers to finish and return a chunk, or the part of
+ * it of the given size, in local memory.
+ */
+static void *
+graph_algo_result(GraphAlgoRun *run, void *chunk, Size size)
+{
+	void	   *result;
+
+	if (run->pcxt == NULL)
+		return chunk;
+
+	WaitForParallelWorkersToFinish(run->pcxt);
+
+	result = MemoryContextAllocHuge(CurrentMemoryContext, Max(size, 1));
+	memcpy(result, chunk, size);
+
+	return result;
+}
+
+static void
+graph_algo_end(GraphAlgoRun *run)
+{
+	if (run->pcxt == NULL)
+		return;
+
+	WaitForParallelWorkersToFinish(run->pcxt);
+	DestroyParallelContext(run->pcxt);
+	ExitParallelMode();
+	run->pcxt = NULL;
+}
+
+static void
+graph_algo_init_shared(GraphAlgoShared *shared, int nphases, int64 nvertices)
+{
+	BarrierInit(&shared->barrier, 0);
+	shared->nphases = nphases;
+	shared->nvertices = nvertices;
+	shared->nblocks = GRAPH_ALGO_NBLOCKS(nvertices);
+	pg_atomic_init_u64(&shared->next_block[0], 0);
+	pg_atomic_init_u64(&shared->next_block[1], 0);
+}
+
+/*
+ * Claim the next block of vertices to work on in the phase. Returns the
+ * number of the block and sets [*start, *end) to its vertices, or returns -1
+ * if there are no more blocks.
+ */
+static int64
+graph_algo_next_block(GraphAlgoShared *shared, int phase, int64 *start,
+					  int64 *end)
+{
+	uint64		block;
+
+	block = pg_atomic_fetch_add_u64(&shared->next_block[phase % 2], 1);
+	if (block >= (uint64) shared->nblocks)
+		return -1;
+
+	*start = (int64) block * GRAPH_ALGO_BLOCK_SIZE;
+	*end = Min(*start + GRAPH_ALGO_BLOCK_SIZE, shared->nvertices);
+
+	return (int64) block;
+}
+
+/*
+ * Wait for the other participants to finish the phase and return the next
+ * one.
+ */
+static int
+graph_algo_end_phase(GraphAlgoShared *shared, int phase)
+{
+	/*
+	 * Everybody is done with the blocks of this phase, so the counter can be
+	 * reused by the phase after the next one. The next phase uses the other
+	 * counter and may be running already.
+	 */
+	if (BarrierArriveAndWait(&shared->barrier,
+							 WAIT_EVENT_GRAPH_ALGORITHM_ITERATING))
+		pg_atomic_write_u64(&shared->next_block[phase % 2], 0);
+
+	return phase + 1;
+}
+
+static Oid
+get_algo_graph_oid(FunctionCallInfo fcinfo, int argno)
+{
+	char	   *graphname;
+	Oid			graphid;
+
+	if (PG_ARGISNULL(argno))
+		return get_graph_path_oid();
+
+	graphname = text_to_cstring(PG_GETARG_TEXT_PP(argno));
+	graphid = get_graphname_oid(graphname);
+	if (!OidIsValid(graphid))
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_OBJECT),
+				 errmsg("graph \"%s\" does not exist", graphname)));
+
+	return graphid;
+}
+
+/*
+ * Look up the label that an argument names. A null vertex label means all
+ * vertices at the ends of the edges.
+ */
+static Oid
+get_algo_label_oid(FunctionCallInfo fcinfo, int argno, Oid graphid,
+				   char labkind)
+{
+	if (PG_ARGISNULL(argno))
+	{
+		if (labkind == LABEL_KIND_EDGE)
+			ereport(ERROR,
+					(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+					 errmsg("edge label must not be null")));
+		return InvalidOid;
+	}
+
+	return get_graph_label_oid(text_to_cstring(PG_GETARG_TEXT_PP(argno)),
+							   graphid, labkind);
+}
+
+static Tuplestorestate *
+begin_algo_srf(FunctionCallInfo fcinfo, TupleDesc *tupdesc)
+{
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	Tuplestorestate *tupstore;
+	MemoryContext oldcxt;
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not allowed in this context")));
+	if (get_call_result_type(fcinfo, NULL, tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	oldcxt = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = *tupdesc;
+	MemoryContextSwitchTo(oldcxt);
+
+	return tupstore;
+}
+
+/*
+ * pagerank(graph, vertex_label, edge_label, iterations, damping)
+ *		Compute the PageRank of the vertices over the edges of a label.
+ *
+ * Each iteration gives every vertex (1 - damping) / N plus damping times the
+ * scores that flow into it. A vertex passes its score to the end vertices of
+ * its outgoing edges in equal shares, and a vertex without outgoing edges
+ * passes it to all vertices.
+ */
+Datum
+pagerank(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupdesc;
+	Tuplestorestate *tupstore;
+	Oid			graphid;
+	Oid			vlabel;
+	Oid			elabel;
+	int32		iterations;
+	float8		damping;
+	GraphCSRData *data;
+	GraphCSR	csr;
+	float8	   *score;
+	int64		i;
+
+	if (PG_ARGISNULL(3) || PG_ARGISNULL(4))
+		ereport(ERROR,
+				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+				 errmsg("iterations and damping factor must not be null")));
+	iterations = PG_GETARG_INT32(3);
+	damping = PG_GETARG_FLOAT8(4);
+	if (iterations < 0 || iterations > INT_MAX / 2)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("number of iterations must be between 0 and %d",
+						INT_MAX / 2)));
+	if (isnan(damping) || damping < 0.0 || damping > 1.0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("damping factor must be between 0 and 1")));
+
+	graphid = get_algo_graph_oid(fcinfo, 0);
+	vlabel = get_algo_label_oid(fcinfo, 1, graphid, LABEL_KIND_VERTEX);
+	elabel = get_algo_label_oid(fcinfo, 2, graphid, LABEL_KIND_EDGE);
+
+	tupstore = begin_algo_srf(fcinfo, &tupdesc);
+
+	data = graph_csr_build(elabel, NULL, vlabel, GetActiveSnapshot());
+	graph_csr_init(&csr, data);
+
+	score = pagerank_compute(data, iterations, damping);
+
+	for (i = 0; i < csr.nvertices; i++)
+	{
+		Datum		values[2];
+		bool		nulls[2] = {false, false};
+
+		values[0] = GraphidGetDatum(csr.vertices[i]);
+		values[1] = Float8GetDatum(score[i]);
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+
+	pfree(score);
+	pfree(data);
+
+	return (Datum) 0;
+}
+
+/*
+ * Run the iterations of PageRank and return the scores of the vertices in
+ * the order of their ordinals.
+ */
+static float8 *
+pagerank_compute(GraphCSRData *data, int iterations, float8 damping)
+{
+	GraphAlgoRun run;
+	Size		sizes[PAGERANK_NCHUNKS];
+	PageRankState state;
+	GraphCSR	csr;
+	int64		nvertices;
+	int64		nblocks;
+	float8	   *score;
+	int64		i;
+
+	graph_csr_init(&csr, data);
+	nvertices = csr.nvertices;
+	nblocks = GRAPH_ALGO_NBLOCKS(nvertices);
+
+	sizes[0] = sizeof(PageRankShared);
+	sizes[1] = mul_size(nvertices, sizeof(float8));
+	sizes[2] = mul_size(nvertices, sizeof(float8));
+	sizes[3] = mul_size(nblocks, sizeof(float8));
+	graph_algo_begin(&run, "pagerank_parallel_main", nvertices, data, sizes,
+					 PAGERANK_NCHUNKS);
+
+	state.shared = graph_algo_alloc(&run, 0);
+	graph_csr_init(&state.csr, run.data);
+	state.score = graph_algo_alloc(&run, 1);
+	state.contrib = graph_algo_alloc(&run, 2);
+	state.dangling = graph_algo_alloc(&run, 3);
+
+	/* each iteration computes the shares first, and then pulls them */
+	graph_algo_init_shared(&state.shared->algo, iterations * 2, nvertices);
+	state.shared->damping = damping;
+	for (i = 0; i < nvertices; i++)
+		state.score[i] = 1.0 / nvertices;
+
+	graph_algo_launch(&run);
+	pagerank_participate(&state);
+
+	score = graph_algo_result(&run, state.score, sizes[1]);
+	graph_algo_end(&run);
+
+	return score;
+}
+
+/*
+ * Work on the iterations of PageRank until they are all done.
+ *
+ * Even phases compute the share of its score that each vertex passes along
+ * each outgoing edge, and the sum of the scores of the vertices without
+ * outgoing edges. Odd phases compute the new score of each vertex from the
+ * shares of its incoming edges. A block of vertices writes only its own
+ * scores, so no locking is needed, and the sums are added up in the order of
+ * the blocks so the result does not depend on the number of participants.
+ */
+static void
+pagerank_participate(PageRankState *state)
+{
+	GraphAlgoShared *algo = &state->shared->algo;
+	GraphCSR   *csr = &state->csr;
+	float8		damping = state->shared->damping;
+	float8	   *score = state->score;
+	float8	   *contrib = state->contrib;
+	int			phase;
+
+	phase = BarrierAttach(&algo->barrier);
+	while (phase < algo->nphases)
+	{
+		int64		block;
+		int64		start;
+		int64		end;
+		int64		v;
+
+		if (phase % 2 == 0)
+		{
+			while ((block = graph_algo_next_block(algo, phase,
+												  &start, &end)) >= 0)
+			{
+				float8		dangling = 0.0;
+
+				for (v = start; v < end; v++)
+				{
+					int64		degree = csr->out_off[v + 1] - csr->out_off[v];
+
+					if (degree > 0)
+					{
+						contrib[v] = score[v] / degree;
+					}
+					else
+					{
+						contrib[v] = 0.0;
+						dangling += score[v];
+					}
+				}
+				state->dangling[block] = dangling;
+
+				CHECK_FOR_INTERRUPTS();
+			}
+		}
+		else
+		{
+			float8		dangling = 0.0;
+			float8		base;
+
+			for (block = 0; block < algo->nblocks; block++)
+				dangling += state->dangling[block];
+			base = (1.0 - damping + damping * dangling) / algo->nvertices;
+
+			while (graph_algo_next_block(algo, phase, &start, &end) >= 0)
+			{
+				for (v = start; v < end; v++)
+				{
+					float8		sum = 0.0;
+					int64		i;
+
+					for (i = csr->in_off[v]; i < csr->in_off[v + 1]; i++)
+						sum += contrib[csr->in_adj[i]];
+					score[v] = base + damping * sum;
+				}
+
+				CHECK_FOR_INTERRUPTS();
+			}
+		}
+
+		phase = graph_algo_end_phase(algo, phase);
+	}
+	BarrierDetach(&algo->barrier);
+}
+
+/*
+ * Entry point of the parallel workers of PageRank.
+ */
+void
+pagerank_parallel_main(dsm_segment *seg, shm_toc *toc)
+{
+	PageRankState state;
+
+	state.shared = graph_algo_lookup(toc, 0);
+	graph_csr_init(&state.csr, shm_toc_lookup(toc, PARALLEL_KEY_CSR, false));
+	state.score = graph_algo_lookup(toc, 1);
+	state.contrib = graph_algo_lookup(toc, 2);
+	state.dangling = graph_algo_lookup(toc, 3);
+
+	pagerank_participate(&state);
+}
+
+/*
+ * Look up the edge labels that a text[] argument names.
+ */
+static Oid *
+get_algo_label_oids(FunctionCallInfo fcinfo, int argno, Oid graphid,
+					int *nlabels)
+{
+	Datum	   *elems;
+	bool	   *nulls;
+	int			nelems;
+	Oid		   *labels;
+	int			i;
+
+	if (PG_ARGISNULL(argno))
+		ereport(ERROR,
+				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+				 errmsg("edge labels must not be null")));
+
+	deconstruct_array(PG_GETARG_ARRAYTYPE_P(argno), TEXTOID, -1, false, 'i',
+					  &elems, &nulls, &nelems);
+	if (nelems == 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("at least one edge label is required")));
+
+	labels = palloc(sizeof(Oid) * nelems);
+	for (i = 0; i < nelems; i++)
+	{
+		if (nulls[i])
+			ereport(ERROR,
+					(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+					 errmsg("edge label must not be null")));
+
+		labels[i] = get_graph_label_oid(TextDatumGetCString(elems[i]),
+										graphid, LABEL_KIND_EDGE);
+	}
+
+	*nlabels = nelems;
+	return labels;
+}
+
+/*
+ * wcc(graph, edge_labels)
+ *		Find the weakly connected components of the graph that the edges of
+ *		the labels make.
+ *
+ * Each vertex at the end of an edge is returned with the smallest ID of the
+ * vertices in its component, which identifies the component.
+ */
+Datum
+wcc(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupdesc;
+	Tuplestorestate *tupstore;
+	Oid			graphid;
+	Oid		   *elabels;
+	int			nelabels;
+	GraphCSRData *data;
+	GraphCSR	csr;
+	GraphAlgoRun run;
+	Size		sizes[WCC_NCHUNKS];
+	WccState	state;
+	int64		nvertices;
+	pg_atomic_uint32 *parent;
+	int64		i;
+
+	graphid = get_algo_graph_oid(fcinfo, 0);
+	elabels = get_algo_label_oids(fcinfo, 1, graphid, &nelabels);
+
+	tupstore = begin_algo_srf(fcinfo, &tupdesc);
+
+	data = graph_csr_build_labels(elabels, nelabels, NULL, InvalidOid,
+								  GetActiveSnapshot());
+	graph_csr_init(&csr, data);
+	nvertices = csr.nvertices;
+
+	sizes[0] = sizeof(GraphAlgoShared);
+	sizes[1] = mul_size(nvertices, sizeof(pg_atomic_uint32));
+	graph_algo_begin(&run, "wcc_parallel_main", nvertices, data, sizes,
+					 WCC_NCHUNKS);
+
+	state.shared = graph_algo_alloc(&run, 0);
+	graph_csr_init(&state.csr, run.data);
+	state.parent = graph_algo_alloc(&run, 1);
+
+	graph_algo_init_shared(state.shared, 1, nvertices);
+	for (i = 0; i < nvertices; i++)
+		pg_atomic_init_u32(&state.parent[i], (uint32) i);
+
+	graph_algo_launch(&run);
+	wcc_participate(&state);
+
+	parent = graph_algo_result(&run, state.parent, sizes[1]);
+	graph_algo_end(&run);
+
+	for (i = 0; i < nvertices; i++)
+	{
+		Datum		values[2];
+		bool		nulls[2] = {false, false};
+
+		values[0] = GraphidGetDatum(csr.vertices[i]);
+		values[1] = GraphidGetDatum(csr.vertices[uf_find(parent, i)]);
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+
+	return (Datum) 0;
+}
+
+/*
+ * Merge the ends of the outgoing edges of each vertex in a single pass over
+ * the edges. Union-find needs no locks; see uf_union().
+ */
+static void
+wcc_participate(WccState *state)
+{
+	GraphAlgoShared *algo = state->shared;
+	GraphCSR   *csr = &state->csr;
+	int			phase;
+
+	phase = BarrierAttach(&algo->barrier);
+	while (phase < algo->nphases)
+	{
+		int64		start;
+		int64		end;
+		int64		v;
+
+		while (graph_algo_next_block(algo, phase, &start, &end) >= 0)
+		{
+			for (v = start; v < end; v++)
+			{
+				int64		i;
+
+				for (i = csr->out_off[v]; i < csr->out_off[v + 1]; i++)
+					uf_union(state->parent, (uint32) v, csr->out_adj[i]);
+			}
+
+			CHECK_FOR_INTERRUPTS();
+		}
+
+		phase = graph_algo_end_phase(algo, phase);
+	}
+	BarrierDetach(&algo->barrier);
+}
+
+/*
+ * Find the root of the tree of x, halving the path to it on the way.
+ *
+ * The parent of a vertex is never larger than the vertex and only ever gets
+ * smaller, so the root of a tree is its smallest vertex, and replacing a
+ * parent with the grandparent is safe even if another participant changes
+ * the parent at the same time.
+ */
+static uint32
+uf_find(pg_atomic_uint32 *parent, uint32 x)
+{
+	for (;;)
+	{
+		uint32		p = pg_atomic_read_u32(&parent[x]);
+		uint32		gp;
+
+		if (p == x)
+			return x;
+
+		gp = pg_atomic_read_u32(&parent[p]);
+		if (gp != p)
+			pg_atomic_compare_exchange_u32(&parent[x], &p, gp);
+		x = gp;
+	}
+}
+
+/*
+ * Merge the trees of x and y by making the larger root a child of the
+ * smaller one. If the larger root got a parent in the meantime, try again
+ * from the new roots.
+ */
+static void
+uf_union(pg_atomic_uint32 *parent, uint32 x, uint32 y)
+{
+	for (;;)
+	{
+		uint32		expected;
+
+		x = uf_find(parent, x);
+		y = uf_find(parent, y);
+		if (x == y)
+			return;
+
+		if (x < y)
+		{
+			uint32		tmp = x;
+
+			x = y;
+			y = tmp;
+		}
+
+		expected = x;
+		if (pg_atomic_compare_exchange_u32(&parent[x], &expected, y))
+			return;
+	}
+}
+
+/*
+ * Entry point of the parallel workers of WCC.
+ */
+void
+wcc_parallel_main(dsm_segment *seg, shm_toc *toc)
+{
+	WccState	state;
+
+	state.shared = graph_algo_lookup(toc, 0);
+	graph_csr_init(&state.csr, shm_toc_lookup(toc, PARALLEL_KEY_CSR, false));
+	state.parent = graph_algo_lookup(toc, 1);
+
+	wcc_participate(&state);
+}
+
+/*
+ * triangle_count(graph, edge_label)
+ *		Count the triangles in the graph that the edges of the label make.
+ *
+ * Edges are taken as undirected, and loops and multiple edges between the
+ * same vertices do not count.
+ */
+Datum
+triangle_count(PG_FUNCTION_ARGS)
+{
+	GraphCSR	csr;
+	uint32	   *degree;
+	uint64	   *triangles;
+	uint64		sum = 0;
+	int64		i;
+
+	triangles = triangle_compute(fcinfo, &csr, &degree);
+	for (i = 0; i < csr.nvertices; i++)
+		sum += triangles[i];
+
+	/* every triangle is counted once for each of its vertices */
+	PG_RETURN_INT64((int64) (sum / 3));
+}
+
+/*
+ * clustering_coefficient(graph, edge_label)
+ *		Return the number of triangles of each vertex and its local clustering
+ *		coefficient, which is the fraction of the pairs of its neighbors that
+ *		are adjacent.
+ */
+Datum
+clustering_coefficient(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupdesc;
+	Tuplestorestate *tupstore;
+	GraphCSR	csr;
+	uint32	   *degree;
+	uint64	   *triangles;
+	int64		i;
+
+	tupstore = begin_algo_srf(fcinfo, &tupdesc);
+
+	triangles = triangle_compute(fcinfo, &csr, &degree);
+	for (i = 0; i < csr.nvertices; i++)
+	{
+		Datum		values[3];
+		bool		nulls[3] = {false, false, false};
+		float8		coefficient = 0.0;
+
+		if (degree[i] > 1)
+			coefficient = (2.0 * triangles[i]) /
+				((float8) degree[i] * (degree[i] - 1));
+
+		values[0] = GraphidGetDatum(csr.vertices[i]);
+		values[1] = Int64GetDatum((int64) triangles[i]);
+		values[2] = Float8GetDatum(coefficient);
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+
+	return (Datum) 0;
+}
+
+/*
+ * Count the triangles of each vertex over the edge label that the arguments
+ * name. Sets *csr to the CSR of the label and *degree to the number of
+ * neighbors of each vertex.
+ *
+ * Each edge is directed from the vertex with the smaller degree to the one
+ * with the larger degree, so that no vertex has more than O(sqrt(E)) forward
+ * neighbors. A triangle u, v, w in that order is then found exactly once, as
+ * a common forward neighbor w of u and of its forward neighbor v.
+ */
+static uint64 *
+triangle_compute(FunctionCallInfo fcinfo, GraphCSR *csr, uint32 **degree)
+{
+	Oid			graphid;
+	Oid			elabel;
+	GraphCSRData *data;
+	int64		nvertices;
+	uint32	   *deg;
+	uint32	   *buf;
+	int64		maxdeg = 0;
+	GraphAlgoRun run;
+	Size		sizes[TRIANGLE_NCHUNKS];
+	TriangleState state;
+	pg_atomic_uint64 *shared_triangles;
+	uint64	   *triangles;
+	int64		nfwd;
+	int64		v;
+
+	graphid = get_algo_graph_oid(fcinfo, 0);
+	elabel = get_algo_label_oid(fcinfo, 1, graphid, LABEL_KIND_EDGE);
+
+	data = graph_csr_build(elabel, NULL, InvalidOid, GetActiveSnapshot());
+	graph_csr_init(csr, data);
+	nvertices = csr->nvertices;
+
+	deg = MemoryContextAllocHuge(CurrentMemoryContext,
+								 mul_size(Max(nvertices, 1), sizeof(uint32)));
+	for (v = 0; v < nvertices; v++)
+		maxdeg = Max(maxdeg, (csr->out_off[v + 1] - csr->out_off[v]) +
+					 (csr->in_off[v + 1] - csr->in_off[v]));
+	buf = MemoryContextAllocHuge(CurrentMemoryContext,
+								 mul_size(Max(maxdeg, 1), sizeof(uint32)));
+	for (v = 0; v < nvertices; v++)
+		deg[v] = (uint32) undirected_neighbors(csr, v, buf);
+
+	sizes[0] = sizeof(GraphAlgoShared);
+	sizes[1] = mul_size(nvertices + 1, sizeof(int64));
+	sizes[2] = mul_size(csr->nedges, sizeof(uint32));
+	sizes[3] = mul_size(nvertices, sizeof(pg_atomic_uint64));
+	graph_algo_begin(&run, "triangle_parallel_main", nvertices, NULL, sizes,
+					 TRIANGLE_NCHUNKS);
+
+	state.shared = graph_algo_alloc(&run, 0);
+	state.fwd_off = graph_algo_alloc(&run, 1);
+	state.fwd_adj = graph_algo_alloc(&run, 2);
+	state.triangles = graph_algo_alloc(&run, 3);
+
+	/* keep the neighbors that come after each vertex in the order of degree */
+	nfwd = 0;
+	for (v = 0; v < nvertices; v++)
+	{
+		int64		n = undirected_neighbors(csr, v, buf);
+		int64		i;
+
+		state.fwd_off[v] = nfwd;
+		for (i = 0; i < n; i++)
+		{
+			uint32		w = buf[i];
+
+			if (deg[w] > deg[v] || (deg[w] == deg[v] && w > v))
+				state.fwd_adj[nfwd++] = w;
+		}
+		pg_atomic_init_u64(&state.triangles[v], 0);
+	}
+	state.fwd_off[nvertices] = nfwd;
+	pfree(buf);
+
+	graph_algo_init_shared(state.shared, 1, nvertices);
+
+	graph_algo_launch(&run);
+	triangle_participate(&state);
+
+	shared_triangles = graph_algo_result(&run, state.triangles, sizes[3]);
+	triangles = MemoryContextAllocHuge(CurrentMemoryContext,
+									   mul_size(Max(nvertices, 1),
+												sizeof(uint64)));
+	for (v = 0; v < nvertices; v++)
+		triangles[v] = pg_atomic_read_u64(&shared_triangles[v]);
+	graph_algo_end(&run);
+
+	*degree = deg;
+	return triangles;
+}
+
+/*
+ * Store the neighbors of v, either way and other than v itself, in buf in
+ * the order of their ordinals and return the number of them. Both adjacency
+ * lists of v are sorted, so this merges them.
+ */
+static int64
+undirected_neighbors(GraphCSR *csr, int64 v, uint32 *buf)
+{
+	int64		i = csr->out_off[v];
+	int64		iend = csr->out_off[v + 1];
+	int64		j = csr->in_off[v];
+	int64		jend = csr->in_off[v + 1];
+	int64		n = 0;
+
+	while (i < iend || j < jend)
+	{
+		uint32		w;
+
+		if (j >= jend || (i < iend && csr->out_adj[i] <= csr->in_adj[j]))
+			w = csr->out_adj[i++];
+		else
+			w = csr->in_adj[j++];
+
+		if (w == (uint32) v || (n > 0 && buf[n - 1] == w))
+			continue;
+		buf[n++] = w;
+	}
+
+	return n;
+}
+
+/*
+ * Intersect the forward neighbors of each vertex u with those of each of its
+ * forward neighbors v. Both lists are sorted, so a merge finds the common
+ * ones. The merge advances by comparisons rather than by branches on them,
+ * which the CPU cannot predict for random neighbor lists.
+ */
+static void
+triangle_participate(TriangleState *state)
+{
+	GraphAlgoShared *algo = state->shared;
+	int64	   *fwd_off = state->fwd_off;
+	uint32	   *fwd_adj = state->fwd_adj;
+	int			phase;
+
+	phase = BarrierAttach(&algo->barrier);
+	while (phase < algo->nphases)
+	{
+		int64		start;
+		int64		end;
+		int64		u;
+
+		while (graph_algo_next_block(algo, phase, &start, &end) >= 0)
+		{
+			for (u = start; u < end; u++)
+			{
+				uint64		utriangles = 0;
+				int64		k;
+
+				for (k = fwd_off[u]; k < fwd_off[u + 1]; k++)
+				{
+					uint32		v = fwd_adj[k];
+					int64		i = fwd_off[u];
+					int64		iend = fwd_off[u + 1];
+					int64		j = fwd_off[v];
+					int64		jend = fwd_off[v + 1];
+					uint64		vtriangles = 0;
+
+					while (i < iend && j < jend)
+					{
+						uint32		a = fwd_adj[i];
+						uint32		b = fwd_adj[j];
+
+						if (a == b)
+						{
+							pg_atomic_fetch_add_u64(&state->triangles[a], 1);
+							vtriangles++;
+						}
+						i += (a <= b);
+						j += (b <= a);
+					}
+
+					if (vtriangles > 0)
+					{
+						pg_atomic_fetch_add_u64(&state->triangles[v],
+												vtriangles);
+						utriangles += vtriangles;
+					}
+				}
+
+				if (utriangles > 0)
+					pg_atomic_fetch_add_u64(&state->triangles[u], utriangles);
+			}
+
+			CHECK_FOR_INTERRUPTS();
+		}
+
+		phase = graph_algo_end_phase(algo, phase);
+	}
+	BarrierDetach(&algo->barrier);
+}
+
+/*
+ * Entry point of the parallel workers of triangle counting.
+ */
+void
+triangle_parallel_main(dsm_segment *seg, shm_toc *toc)
+{
+	TriangleState state;
+
+	state.shared = graph_algo_lookup(toc, 0);
+	state.fwd_off = graph_algo_lookup(toc, 1);
+	state.fwd_adj = graph_algo_lookup(toc, 2);
+	state.triangles = graph_algo_lookup(toc, 3);
+
+	triangle_participate(&state);
+}
+
+/*
+ * random_walks(graph, edge_label, start_vertices, walk_length,
+ *				walks_per_vertex)
+ *		Sample walks along the outgoing edges of a label.
+ *
+ * Each start vertex gets walks_per_vertex walks of up to walk_length steps.
+ * Each step moves to the end of an outgoing edge chosen uniformly at random,
+ * and a walk stops early at a vertex without outgoing edges. A null array of
+ * start vertices means all vertices at the ends of the edges. Every walk is
+ * returned as the array of the IDs of the vertices it visits.
+ *
+ * The steps pick offsets in the adjacency lists of the CSR, so a walk costs
+ * no more than a few memory accesses per step. Every walk has its own stream
+ * of random numbers that is derived from random(), so setseed() makes the
+ * walks repeatable no matter how many parallel workers take part.
+ */
+Datum
+random_walks(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupdesc;
+	Tuplestorestate *tupstore;
+	Oid			graphid;
+	Oid			elabel;
+	int32		walk_length;
+	int32		walks_per_vertex;
+	GraphCSRData *data;
+	GraphCSR	csr;
+	Graphid    *start_ids;
+	int64		nstarts;
+	int64		nwalks;
+	Size		sizes[RANDOMWALK_NCHUNKS];
+	GraphAlgoRun run;
+	RandomWalkState state;
+	uint32	   *walks;
+	uint32	   *lengths;
+	Datum	   *elems;
+	int64		i;
+
+	if (PG_ARGISNULL(3) || PG_ARGISNULL(4))
+		ereport(ERROR,
+				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+				 errmsg("walk length and number of walks must not be null")));
+	walk_length = PG_GETARG_INT32(3);
+	walks_per_vertex = PG_GETARG_INT32(4);
+	if (walk_length < 0 || walk_length == PG_INT32_MAX)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("walk length must be between 0 and %d",
+						PG_INT32_MAX - 1)));
+	if (walks_per_vertex < 1)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("number of walks per vertex must be positive")));
+
+	graphid = get_algo_graph_oid(fcinfo, 0);
+	elabel = get_algo_label_oid(fcinfo, 1, graphid, LABEL_KIND_EDGE);
+
+	tupstore = begin_algo_srf(fcinfo, &tupdesc);
+
+	data = graph_csr_build(elabel, NULL, InvalidOid, GetActiveSnapshot());
+	graph_csr_init(&csr, data);
+
+	if (PG_ARGISNULL(2))
+	{
+		start_ids = csr.vertices;
+		nstarts = csr.nvertices;
+	}
+	else
+	{
+		bool	   *nulls;
+		int			nelems;
+
+		deconstruct_array(PG_GETARG_ARRAYTYPE_P(2), GRAPHIDOID,
+						  sizeof(Graphid), FLOAT8PASSBYVAL, 'd',
+						  &elems, &nulls, &nelems);
+
+		start_ids = palloc(sizeof(Graphid) * Max(nelems, 1));
+		for (i = 0; i < nelems; i++)
+		{
+			if (nulls[i])
+				ereport(ERROR,
+						(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+						 errmsg("start vertex must not be null")));
+			start_ids[i] = DatumGetGraphid(elems[i]);
+		}
+		nstarts = nelems;
+	}
+	nwalks = nstarts * walks_per_vertex;
+
+	sizes[0] = sizeof(RandomWalkShared);
+	sizes[1] = mul_size(nstarts, sizeof(int64));
+	sizes[2] = mul_size(mul_size(nwalks, walk_length + 1), sizeof(uint32));
+	sizes[3] = mul_size(nwalks, sizeof(uint32));
+	graph_algo_begin(&run, "random_walks_parallel_main", nstarts, data, sizes,
+					 RANDOMWALK_NCHUNKS);
+
+	state.shared = graph_algo_alloc(&run, 0);
+	graph_csr_init(&state.csr, run.data);
+	state.starts = graph_algo_alloc(&run, 1);
+	state.walks = graph_algo_alloc(&run, 2);
+	state.lengths = graph_algo_alloc(&run, 3);
+
+	graph_algo_init_shared(&state.shared->algo, 1, nstarts);
+	state.shared->walk_length = walk_length;
+	state.shared->walks_per_vertex = walks_per_vertex;
+	state.shared->seed = ((uint64) random() << 32) ^ (uint64) random();
+	for (i = 0; i < nstarts; i++)
+		state.starts[i] = graph_csr_ordinal(&csr, start_ids[i]);
+
+	graph_algo_launch(&run);
+	random_walk_participate(&state);
+
+	walks = graph_algo_result(&run, state.walks, sizes[2]);
+	lengths = graph_algo_result(&run, state.lengths, sizes[3]);
+	graph_algo_end(&run);
+
+	elems = palloc(sizeof(Datum) * (walk_length + 1));
+	for (i = 0; i < nwalks; i++)
+	{
+		Datum		values[3];
+		bool		nulls[3] = {false, false, false};
+		uint32	   *walk = walks + i * (walk_length + 1);
+		uint32		j;
+
+		if (lengths[i] == 0)
+		{
+			/* the start vertex has no edges of the label */
+			elems[0] = GraphidGetDatum(start_ids[i / walks_per_vertex]);
+		}
+		else
+		{
+			for (j = 0; j < lengths[i]; j++)
+				elems[j] = GraphidGetDatum(csr.vertices[walk[j]]);
+		}
+
+		values[0] = GraphidGetDatum(start_ids[i / walks_per_vertex]);
+		values[1] = Int32GetDatum((int32) (i % walks_per_vertex) + 1);
+		values[2] = PointerGetDatum(construct_array(elems,
+													Max(lengths[i], 1),
+													GRAPHIDOID,
+													sizeof(Graphid),
+													FLOAT8PASSBYVAL, 'd'));
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+
+		pfree(DatumGetPointer(values[2]));
+	}
+
+	return (Datum) 0;
+}
+
+/*
+ * Walk from the start vertices of each block. A walk depends only on the
+ * seed and on its number, so it does not matter which participant takes it.
+ */
+static void
+random_walk_participate(RandomWalkState *state)
+{
+	GraphAlgoShared *algo = &state->shared->algo;
+	GraphCSR   *csr = &state->csr;
+	int32		walk_length = state->shared->walk_length;
+	int32		walks_per_vertex = state->shared->walks_per_vertex;
+	uint64		seed = state->shared->seed;
+	int			phase;
+
+	phase = BarrierAttach(&algo->barrier);
+	while (phase < algo->nphases)
+	{
+		int64		start;
+		int64		end;
+		int64		s;
+
+		while (graph_algo_next_block(algo, phase, &start, &end) >= 0)
+		{
+			for (s = start; s < end; s++)
+			{
+				int32		w;
+
+				for (w = 0; w < walks_per_vertex; w++)
+				{
+					int64		n = s * walks_per_vertex + w;
+					uint32	   *walk = state->walks + n * (walk_length + 1);
+					uint64		rng = seed ^ (uint64) n;
+					int64		v = state->starts[s];
+					uint32		len = 0;
+
+					/* mix the walk number in so that streams do not overlap */
+					rng = random_walk_next(&rng);
+
+					if (v >= 0)
+					{
+						walk[len++] = (uint32) v;
+						while (len <= (uint32) walk_length)
+						{
+							int64		off = csr->out_off[v];
+							int64		degree = csr->out_off[v + 1] - off;
+
+							if (degree == 0)
+								break;
+
+							v = csr->out_adj[off + (int64)
+											 (random_walk_next(&rng) %
+											  (uint64) degree)];
+							walk[len++] = (uint32) v;
+						}
+					}
+					state->lengths[n] = len;
+				}
+
+				CHECK_FOR_INTERRUPTS();
+			}
+		}
+
+		phase = graph_algo_end_phase(algo, phase);
+	}
+	BarrierDetach(&algo->barrier);
+}
+
+/*
+ * Advance a splitmix64 generator and return its next number.
+ */
+static uint64
+random_walk_next(uint64 *state)
+{
+	uint64		z;
+
+	z = (*state += UINT64CONST(0x9E3779B97F4A7C15));
+	z = (z ^ (z >> 30)) * UINT64CONST(0xBF58476D1CE4E5B9);
+	z = (z ^ (z >> 27)) * UINT64CONST(0x94D049BB133111EB);
+
+	return z ^ (z >> 31);
+}
+
+/*
+ * Entry point of the parallel workers of random walks.
+ */
+void
+random_walks_parallel_main(dsm_segment *seg, shm_toc *toc)
+{
+	RandomWalkState state;
+
+	state.shared = graph_algo_lookup(toc, 0);
+	graph_csr_init(&state.csr, shm_toc_lookup(toc, PARALLEL_KEY_CSR, false));
+	state.starts = graph_algo_lookup(toc, 1);
+	state.walks = graph_algo_lookup(toc, 2);
+	state.lengths = graph_algo_lookup(toc, 3);
+
+	random_walk_participate(&state);
+}
@@ -0,0 +1,1714 @@
+/*
+ * graphprojection.c
+ *	  Shared in-memory CSR projections of edge labels.
+ *
+ * A graph projection holds the edges of an edge label, and of the labels
+ * that inherit it, in compressed sparse row (CSR) form in a DSA area that
+ * all backends can map. Traversals can then scan adjacency lists in memory
+ * instead of going through the index and the heap of the label for every
+ * vertex they visit. Projections are built by graph_projection_create().
+ *
+ * A projection reflects the label as of the snapshot it was built with. The
+ * build takes a ShareLock on the label relations, which waits for writers in
+ * progress, before it takes the snapshot. A writer that comes later makes the
+ * projection stale through GraphProjectionRelationModified() before it can
+ * change anything. So, as long as a projection is valid, it has the contents
+ * of the label for every snapshot that sees the transactions the build
+ * snapshot saw as committed. Writes are not applied to projections; a stale
+ * one is ignored until graph_projection_refresh() builds it again.
+ *
+ * Projections are shared by all users, so only the owner of a label can
+ * build one, and a query uses a projection only if its user could read the
+ * label relations directly, without row-level security in the way. The
+ * total size of projections is limited by graph_projection_memory.
+ *
+ * Copyright (c) 2016 by Bitnine Global, Inc.
+ *
+ * IDENTIFICATION
+ *	  src/backend/utils/adt/graphprojection.c
+ */
+
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "access/xact.h"
+#include "catalog/ag_graph_fn.h"
+#include "catalog/ag_label.h"
+#include "catalog/pg_inherits.h"
+#include "catalog/pg_type.h"
+#include "executor/spi.h"
+#include "funcapi.h"
+#include "lib/ilist.h"
+#include "miscadmin.h"
+#include "storage/dsm.h"
+#include "storage/ipc.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "utils/acl.h"
+#include "utils/builtins.h"
+#include "utils/dsa.h"
+#include "utils/graphprojection.h"
+#include "utils/jsonb.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/rls.h"
+#include "utils/snapmgr.h"
+#include "utils/syscache.h"
+#include "utils/timestamp.h"
+#include "utils/tqual.h"
+
+#define MAX_GRAPH_PROJECTIONS		32
+#define GRAPH_PROJECTION_MAX_RELS	64
+
+/* arrays of GraphCSRData in the order they are laid out */
+#define CSR_VERTICES	0
+#define CSR_OUT_OFF		1
+#define CSR_OUT_ADJ		2
+#define CSR_OUT_EID		3
+#define CSR_OUT_WEIGHT	4
+#define CSR_IN_OFF		5
+#define CSR_IN_ADJ		6
+#define CSR_IN_EID		7
+#define CSR_IN_WEIGHT	8
+#define CSR_NUM_ARRAYS	9
+
+/* a CSR in one chunk of memory, the arrays follow the header */
+struct GraphCSRData
+{
+	int64		nvertices;
+	int64		nedges;
+	bool		has_weight;
+	Size		size;			/* size of the whole chunk */
+};
+
+typedef struct RawEdge
+{
+	Graphid		start;
+	Graphid		end;
+	Graphid		eid;
+	float8		weight;
+} RawEdge;
+
+typedef struct CSREdge
+{
+	uint32		src;
+	uint32		dst;
+	Graphid		eid;
+	float8		weight;
+} CSREdge;
+
+typedef struct GraphProjectionEntry
+{
+	bool		in_use;
+	bool		dropped;		/* free it when refcount drops to 0 */
+	bool		valid;			/* false if a label was written after build */
+	int			refcount;		/* number of scans using data */
+	Oid			dbid;
+	Oid			owner;
+	NameData	name;
+	Oid			graphid;
+	Oid			elabel;
+	Oid			vlabel;			/* InvalidOid if vertices are edge ends */
+	bool		has_weight;
+	NameData	weight_key;
+	int			nrels;			/* relations whose changes make it stale */
+	Oid			rels[GRAPH_PROJECTION_MAX_RELS];
+	TransactionId xmin;			/* build snapshot */
+	TransactionId xmax;
+	int			xcnt;
+	dsa_pointer xip;			/* TransactionId[xcnt] */
+	dsa_pointer data;			/* GraphCSRData */
+	dsa_pointer reach;			/* GraphReachData, or invalid */
+	int64		nvertices;
+	int64		nedges;
+	Size		size;
+	TimestampTz built;
+} GraphProjectionEntry;
+
+typedef struct GraphProjectionShared
+{
+	dsa_handle	area;			/* DSM_HANDLE_INVALID until the first build */
+	int			nentries;		/* number of entries in use */
+	GraphProjectionEntry entries[MAX_GRAPH_PROJECTIONS];
+} GraphProjectionShared;
+
+/*
+ * A pin of a projection by this backend. It is released when the memory
+ * context it lives in goes away, or at backend exit if that never happens.
+ */
+typedef struct GraphProjectionRef
+{
+	MemoryContextCallback cb;
+	dlist_node	node;			/* in HeldProjections */
+	GraphProjectionEntry *entry;	/* NULL once released */
+} GraphProjectionRef;
+
+/* GUC variable, in kB */
+int			graph_projection_memory = 1048576;
+
+static GraphProjectionShared *ProjShared = NULL;
+static dsa_area *ProjArea = NULL;
+static dlist_head HeldProjections = DLIST_STATIC_INIT(HeldProjections);
+static bool ProjExitCallbackRegistered = false;
+
+static Size csr_layout(int64 nvertices, int64 nedges, bool has_weight,
+		   Size *offsets);
+static RawEdge *fetch_edges(Oid elabel, const char *weight_key,
+			Snapshot snapshot, MemoryContext mcxt, int64 *nedges);
+static Graphid *fetch_vertices(Oid vlabel, Snapshot snapshot,
+			   MemoryContext mcxt, int64 *nvertices);
+static float8 jsonb_weight(Jsonb *jb);
+static char *label_relname(Oid laboid);
+static int64 sort_unique_graphids(Graphid *ids, int64 n);
+static int64 search_graphid(Graphid *ids, int64 n, Graphid id);
+static int	graphid_cmp(const void *a, const void *b);
+static int	csredge_out_cmp(const void *a, const void *b);
+static int	csredge_in_cmp(const void *a, const void *b);
+static dsa_area *get_projection_area(void);
+static GraphProjectionEntry *find_projection(const char *name);
+static void free_projection(GraphProjectionEntry *entry);
+static void unpin_projection(GraphProjectionEntry *entry);
+static void release_projection(void *arg);
+static void release_projections_at_exit(int code, Datum arg);
+static Size projection_memory_used(GraphProjectionEntry *except);
+static void check_projection_memory(const char *name, Size size,
+						GraphProjectionEntry *except);
+static bool projection_readable(Oid *rels, int nrels);
+static void check_label_owner(Oid laboid, Oid owner, const char *name);
+static bool snapshot_covers_projection(GraphProjectionEntry *entry,
+						   Snapshot snapshot);
+static bool rels_cover_label(GraphProjectionEntry *entry, List *rels);
+static GraphProjectionEntry *acquire_projection(Oid elabel,
+				   const char *weight_key, bool reach,
+				   Snapshot snapshot, MemoryContext mcxt);
+static void build_projection(const char *name, Oid owner, Oid graphid,
+				 Oid elabel, Oid vlabel, const char *weight_key,
+				 bool reachability, bool refresh);
+static char *text_to_name(text *t, const char *what);
+static Datum name_datum(const char *s, bool *isnull);
+
+/*
+ * Compute the offsets of the arrays in a GraphCSRData and its size.
+ */
+static Size
+csr_layout(int64 nvertices, int64 nedges, bool has_weight, Size *offsets)
+{
+	Size		size = MAXALIGN(sizeof(GraphCSRData));
+	int			i;
+
+	for (i = 0; i < CSR_NUM_ARRAYS; i++)
+	{
+		Size		len;
+
+		switch (i)
+		{
+			case CSR_VERTICES:
+				len = mul_size(nvertices, sizeof(Graphid));
+				break;
+			case CSR_OUT_OFF:
+			case CSR_IN_OFF:
+				len = mul_size(nvertices + 1, sizeof(int64));
+				break;
+			case CSR_OUT_ADJ:
+			case CSR_IN_ADJ:
+				len = mul_size(nedges, sizeof(uint32));
+				break;
+			case CSR_OUT_EID:
+			case CSR_IN_EID:
+				len = mul_size(nedges, sizeof(Graphid));
+				break;
+			default:
+				len = (has_weight ? mul_size(nedges, sizeof(float8)) : 0);
+				break;
+		}
+
+		offsets[i] = size;
+		size = add_size(size, MAXALIGN(len));
+	}
+
+	return size;
+}
+
+/*
+ * graph_csr_build
+ *		Build the CSR of an edge label as of the given snapshot.
+ *
+ * If weight_key is given, the property of edges named by it becomes their
+ * weight. It is converted the way DIJKSTRA() converts `e.key` and a missing
+ * or null property is 0. If vlabel is valid, the vertices are those of the
+ * vertex label, including the ones without edges, and edges between other
+ * vertices are left out. Otherwise, the vertices are the ends of the edges.
+ *
+ * The labels are read with SPI, so a large label is scanned by parallel
+ * workers. The result is allocated in the current memory context.
+ */
+GraphCSRData *
+graph_csr_build(Oid elabel, const char *weight_key, Oid vlabel,
+				Snapshot snapshot)
+{
+	return graph_csr_build_labels(&elabel, 1, weight_key, vlabel, snapshot);
+}
+
+/*
+ * graph_csr_build_labels
+ *		Build one CSR of the edges of several edge labels.
+ */
+GraphCSRData *
+graph_csr_build_labels(Oid *elabels, int nelabels, const char *weight_key,
+					   Oid vlabel, Snapshot snapshot)
+{
+	MemoryContext mcxt = CurrentMemoryContext;
+	RawEdge    *raw = NULL;
+	int64		nraw = 0;
+	Graphid    *vertices;
+	int64		nvertices;
+	CSREdge    *edges;
+	int64		nedges;
+	GraphCSRData *data;
+	GraphCSR	csr;
+	Size		offsets[CSR_NUM_ARRAYS];
+	Size		size;
+	int64		i;
+
+	Assert(nelabels > 0);
+
+	if (SPI_connect() != SPI_OK_CONNECT)
+		elog(ERROR, "SPI_connect failed");
+
+	for (i = 0; i < nelabels; i++)
+	{
+		RawEdge    *labraw;
+		int64		nlabraw;
+
+		labraw = fetch_edges(elabels[i], weight_key, snapshot, mcxt,
+							 &nlabraw);
+		if (raw == NULL)
+		{
+			raw = labraw;
+			nraw = nlabraw;
+			continue;
+		}
+
+		raw = repalloc_huge(raw, mul_size(Max(nraw + nlabraw, 1),
+										  sizeof(RawEdge)));
+		memcpy(raw + nraw, labraw, nlabraw * sizeof(RawEdge));
+		nraw += nlabraw;
+		pfree(labraw);
+	}
+
+	if (OidIsValid(vlabel))
+	{
+		vertices = fetch_vertices(vlabel, snapshot, mcxt, &nvertices);
+	}
+	else
+	{
+		vertices = MemoryContextAllocHuge(mcxt,
+										  mul_size(Max(nraw, 1) * 2,
+												   sizeof(Graphid)));
+		for (i = 0; i < nraw; i++)
+		{
+			vertices[i * 2] = raw[i].start;
+			vertices[i * 2 + 1] = raw[i].end;
+		}
+		nvertices = nraw * 2;
+	}
+
+	SPI_finish();
+
+	nvertices = sort_unique_graphids(vertices, nvertices);
+	if (nvertices > (int64) PG_UINT32_MAX)
+		ereport(ERROR,
+				(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+				 errmsg("too many vertices for a graph projection")));
+
+	/* replace the ends of the edges with their ordinals */
+	edges = MemoryContextAllocHuge(mcxt,
+								   mul_size(Max(nraw, 1), sizeof(CSREdge)));
+	nedges = 0;
+	for (i = 0; i < nraw; i++)
+	{
+		int64		src = search_graphid(vertices, nvertices, raw[i].start);
+		int64		dst = search_graphid(vertices, nvertices, raw[i].end);
+
+		if (src < 0 || dst < 0)
+			continue;
+
+		edges[nedges].src = (uint32) src;
+		edges[nedges].dst = (uint32) dst;
+		edges[nedges].eid = raw[i].eid;
+		edges[nedges].weight = raw[i].weight;
+		nedges++;
+	}
+	pfree(raw);
+
+	size = csr_layout(nvertices, nedges, weight_key != NULL, offsets);
+	data = MemoryContextAllocHuge(mcxt, size);
+	data->nvertices = nvertices;
+	data->nedges = nedges;
+	data->has_weight = (weight_key != NULL);
+	data->size = size;
+	graph_csr_init(&csr, data);
+
+	memcpy(csr.vertices, vertices, nvertices * sizeof(Graphid));
+	pfree(vertices);
+
+	CHECK_FOR_INTERRUPTS();
+
+	/* outgoing edges, ordered by their start and end vertices */
+	qsort(edges, nedges, sizeof(CSREdge), csredge_out_cmp);
+	memset(csr.out_off, 0, (nvertices + 1) * sizeof(int64));
+	for (i = 0; i < nedges; i++)
+	{
+		csr.out_off[edges[i].src + 1]++;
+		csr.out_adj[i] = edges[i].dst;
+		csr.out_eid[i] = edges[i].eid;
+		if (csr.out_weight != NULL)
+			csr.out_weight[i] = edges[i].weight;
+	}
+	for (i = 0; i < nvertices; i++)
+		csr.out_off[i + 1] += csr.out_off[i];
+
+	CHECK_FOR_INTERRUPTS();
+
+	/* incoming edges, ordered by their end and start vertices */
+	qsort(edges, nedges, sizeof(CSREdge), csredge_in_cmp);
+	memset(csr.in_off, 0, (nvertices + 1) * sizeof(int64));
+	for (i = 0; i < nedges; i++)
+	{
+		csr.in_off[edges[i].dst + 1]++;
+		csr.in_adj[i] = edges[i].src;
+		csr.in_eid[i] = edges[i].eid;
+		if (csr.in_weight != NULL)
+			csr.in_weight[i] = edges[i].weight;
+	}
+	for (i = 0; i < nvertices; i++)
+		csr.in_off[i + 1] += csr.in_off[i];
+
+	pfree(edges);
+
+	return data;
+}
+
+/*
+ * graph_csr_init
+ *		Set up a GraphCSR to access the arrays of a GraphCSRData.
+ */
+void
+graph_csr_init(GraphCSR *csr, GraphCSRData *data)
+{
+	Size		offsets[CSR_NUM_ARRAYS];
+	char	   *base = (char *) data;
+
+	csr_layout(data->nvertices, data->nedges, data->has_weight, offsets);
+
+	csr->nvertices = data->nvertices;
+	csr->nedges = data->nedges;
+	csr->vertices = (Graphid *) (base + offsets[CSR_VERTICES]);
+	csr->out_off = (int64 *) (base + offsets[CSR_OUT_OFF]);
+	csr->out_adj = (uint32 *) (base + offsets[CSR_OUT_ADJ]);
+	csr->out_eid = (Graphid *) (base + offsets[CSR_OUT_EID]);
+	csr->in_off = (int64 *) (base + offsets[CSR_IN_OFF]);
+	csr->in_adj = (uint32 *) (base + offsets[CSR_IN_ADJ]);
+	csr->in_eid = (Graphid *) (base + offsets[CSR_IN_EID]);
+	if (data->has_weight)
+	{
+		csr->out_weight = (float8 *) (base + offsets[CSR_OUT_WEIGHT]);
+		csr->in_weight = (float8 *) (base + offsets[CSR_IN_WEIGHT]);
+	}
+	else
+	{
+		csr->out_weight = NULL;
+		csr->in_weight = NULL;
+	}
+}
+
+Size
+graph_csr_size(GraphCSRData *data)
+{
+	return data->size;
+}
+
+/*
+ * graph_csr_ordinal
+ *		Return the ordinal of a vertex, or -1 if it is not in the CSR.
+ */
+int64
+graph_csr_ordinal(GraphCSR *csr, Graphid id)
+{
+	return search_graphid(csr->vertices, csr->nvertices, id);
+}
+
+/*
+ * Read the edges of an edge label and its children. SPI must be connected.
+ */
+static RawEdge *
+fetch_edges(Oid elabel, const char *weight_key, Snapshot snapshot,
+			MemoryContext mcxt, int64 *nedges)
+{
+	StringInfoData sql;
+	SPIPlanPtr	plan;
+	Oid			argtypes[1] = {TEXTOID};
+	Datum		values[1];
+	TupleDesc	tupdesc;
+	RawEdge    *edges;
+	uint64		n;
+	uint64		i;
+
+	initStringInfo(&sql);
+	appendStringInfo(&sql, "SELECT start, \"end\", id%s FROM %s",
+					 (weight_key != NULL ? ", properties -> $1" : ""),
+					 label_relname(elabel));
+
+	plan = SPI_prepare_cursor(sql.data, (weight_key != NULL ? 1 : 0),
+							  argtypes, CURSOR_OPT_PARALLEL_OK);
+	if (plan == NULL)
+		elog(ERROR, "SPI_prepare_cursor failed: %s",
+			 SPI_result_code_string(SPI_result));
+
+	if (weight_key != NULL)
+		values[0] = CStringGetTextDatum(weight_key);
+
+	if (SPI_execute_snapshot(plan, values, NULL, snapshot, InvalidSnapshot,
+							 true, false, 0) != SPI_OK_SELECT)
+		elog(ERROR, "SPI_execute_snapshot failed: %s", sql.data);
+
+	n = SPI_processed;
+	tupdesc = SPI_tuptable->tupdesc;
+	edges = MemoryContextAllocHuge(mcxt, mul_size(Max(n, 1),
+												  sizeof(RawEdge)));
+	for (i = 0; i < n; i++)
+	{
+		HeapTuple	tuple = SPI_tuptable->vals[i];
+		bool		isnull;
+		Datum		weight;
+
+		edges[i].start = DatumGetGraphid(SPI_getbinval(tuple, tupdesc, 1,
+													   &isnull));
+		edges[i].end = DatumGetGraphid(SPI_getbinval(tuple, tupdesc, 2,
+													 &isnull));
+		edges[i].eid = DatumGetGraphid(SPI_getbinval(tuple, tupdesc, 3,
+													 &isnull));
+		edges[i].weight = 0.0;
+		if (weight_key != NULL)
+		{
+			weight = SPI_getbinval(tuple, tupdesc, 4, &isnull);
+			if (!isnull)
+				edges[i].weight = jsonb_weight(DatumGetJsonbP(weight));
+		}
+	}
+
+	SPI_freetuptable(SPI_tuptable);
+	SPI_freeplan(plan);
+
+	*nedges = (int64) n;
+	return edges;
+}
+
+/*
+ * Read the IDs of the vertices of a vertex label and its children. SPI must
+ * be connected.
+ */
+static Graphid *
+fetch_vertices(Oid vlabel, Snapshot snapshot, MemoryContext mcxt,
+			   int64 *nvertices)
+{
+	StringInfoData sql;
+	SPIPlanPtr	plan;
+	Graphid    *vertices;
+	uint64		n;
+	uint64		i;
+
+	initStringInfo(&sql);
+	appendStringInfo(&sql, "SELECT id FROM %s", label_relname(vlabel));
+
+	plan = SPI_prepare_cursor(sql.data, 0, NULL, CURSOR_OPT_PARALLEL_OK);
+	if (plan == NULL)
+		elog(ERROR, "SPI_prepare_cursor failed: %s",
+			 SPI_result_code_string(SPI_result));
+
+	if (SPI_execute_snapshot(plan, NULL, NULL, snapshot, InvalidSnapshot,
+							 true, false, 0) != SPI_OK_SELECT)
+		elog(ERROR, "SPI_execute_snapshot failed: %s", sql.data);
+
+	n = SPI_processed;
+	vertices = MemoryContextAllocHuge(mcxt, mul_size(Max(n, 1),
+													 sizeof(Graphid)));
+	for (i = 0; i < n; i++)
+	{
+		bool		isnull;
+
+		vertices[i] = DatumGetGraphid(SPI_getbinval(SPI_tuptable->vals[i],
+													SPI_tuptable->tupdesc, 1,
+													&isnull));
+	}
+
+	SPI_freetuptable(SPI_tuptable);
+	SPI_freeplan(plan);
+
+	*nvertices = (int64) n;
+	return vertices;
+}
+
+/*
+ * Convert a property value to a weight like the explicit Cypher cast to
+ * double precision does.
+ */
+static float8
+jsonb_weight(Jsonb *jb)
+{
+	JsonbValue *jv;
+	char	   *str;
+
+	if (!JB_ROOT_IS_SCALAR(jb))
+		ereport(ERROR,
+				(errcode(ERRCODE_DATATYPE_MISMATCH),
+				 errmsg("cannot cast ... (not scalar)")));
+
+	jv = getIthJsonbValueFromContainer(&jb->root, 0);
+	switch (jv->type)
+	{
+		case jbvNull:
+			return 0.0;
+		case jbvString:
+			str = pnstrdup(jv->val.string.val, jv->val.string.len);
+			break;
+		case jbvNumeric:
+			return DatumGetFloat8(DirectFunctionCall1(numeric_float8,
+											NumericGetDatum(jv->val.numeric)));
+		case jbvBool:
+			str = (jv->val.boolean ? "true" : "false");
+			break;
+		default:
+			elog(ERROR, "unknown jsonb scalar type");
+			return 0.0;
+	}
+
+	return DatumGetFloat8(DirectFunctionCall1(float8in,
+											  CStringGetDatum(str)));
+}
+
+static char *
+label_relname(Oid laboid)
+{
+	Oid			relid = get_laboid_relid(laboid);
+
+	return quote_qualified_identifier(get_namespace_name(get_rel_namespace(relid)),
+									  get_rel_name(relid));
+}
+
+static int64
+sort_unique_graphids(Graphid *ids, int64 n)
+{
+	int64		i;
+	int64		j;
+
+	if (n <= 1)
+		return n;
+
+	qsort(ids, n, sizeof(Graphid), graphid_cmp);
+
+	for (i = 1, j = 1; i < n; i++)
+	{
+		if (ids[i] != ids[j - 1])
+			ids[j++] = ids[i];
+	}
+
+	return j;
+}
+
+static int64
+search_graphid(Graphid *ids, int64 n, Graphid id)
+{
+	int64		lo = 0;
+	int64		hi = n;
+
+	while (lo < hi)
+	{
+		int64		mid = lo + (hi - lo) / 2;
+
+		if (ids[mid] < id)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo < n && ids[lo] == id)
+		return lo;
+	return -1;
+}
+
+static int
+graphid_cmp(const void *a, const void *b)
+{
+	Graphid		x = *(const Graphid *) a;
+	Graphid		y = *(const Graphid *) b;
+
+	if (x < y)
+		return -1;
+	if (x > y)
+		return 1;
+	return 0;
+}
+
+static int
+csredge_out_cmp(const void *a, const void *b)
+{
+	const CSREdge *x = (const CSREdge *) a;
+	const CSREdge *y = (const CSREdge *) b;
+
+	if (x->src != y->src)
+		return (x->src < y->src ? -1 : 1);
+	if (x->dst != y->dst)
+		return (x->dst < y->dst ? -1 : 1);
+	return graphid_cmp(&x->eid, &y->eid);
+}
+
+static int
+csredge_in_cmp(const void *a, const void *b)
+{
+	const CSREdge *x = (const CSREdge *) a;
+	const CSREdge *y = (const CSREdge *) b;
+
+	if (x->dst != y->dst)
+		return (x->dst < y->dst ? -1 : 1);
+	if (x->src != y->src)
+		return (x->src < y->src ? -1 : 1);
+	return graphid_cmp(&x->eid, &y->eid);
+}
+
+Size
+GraphProjectionShmemSize(void)
+{
+	return sizeof(GraphProjectionShared);
+}
+
+void
+GraphProjectionShmemInit(void)
+{
+	bool		found;
+
+	ProjShared = (GraphProjectionShared *)
+		ShmemInitStruct("Graph Projections", GraphProjectionShmemSize(),
+						&found);
+	if (!found)
+	{
+		MemSet(ProjShared, 0, GraphProjectionShmemSize());
+		ProjShared->area = DSM_HANDLE_INVALID;
+	}
+}
+
+/*
+ * Attach to the DSA area of projections, creating it if no one has yet.
+ */
+static dsa_area *
+get_projection_area(void)
+{
+	MemoryContext oldcxt;
+
+	if (ProjArea != NULL)
+		return ProjArea;
+
+	oldcxt = MemoryContextSwitchTo(TopMemoryContext);
+	LWLockAcquire(GraphProjectionLock, LW_EXCLUSIVE);
+	if (ProjShared->area == DSM_HANDLE_INVALID)
+	{
+		ProjArea = dsa_create(LWTRANCHE_GRAPH_PROJECTION);
+		dsa_pin(ProjArea);
+		ProjShared->area = dsa_get_handle(ProjArea);
+	}
+	else
+	{
+		ProjArea = dsa_attach(ProjShared->area);
+	}
+	dsa_pin_mapping(ProjArea);
+	LWLockRelease(GraphProjectionLock);
+	MemoryContextSwitchTo(oldcxt);
+
+	return ProjArea;
+}
+
+/* The caller must hold GraphProjectionLock. */
+static GraphProjectionEntry *
+find_projection(const char *name)
+{
+	int			i;
+
+	for (i = 0; i < MAX_GRAPH_PROJECTIONS; i++)
+	{
+		GraphProjectionEntry *entry = &ProjShared->entries[i];
+
+		if (entry->in_use && !entry->dropped &&
+			entry->dbid == MyDatabaseId &&
+			strcmp(NameStr(entry->name), name) == 0)
+			return entry;
+	}
+
+	return NULL;
+}
+
+/*
+ * The caller must hold GraphProjectionLock exclusively and be attached to
+ * the DSA area.
+ */
+static void
+free_projection(GraphProjectionEntry *entry)
+{
+	Assert(ProjArea != NULL);
+	Assert(entry->refcount == 0);
+
+	dsa_free(ProjArea, entry->data);
+	if (DsaPointerIsValid(entry->reach))
+		dsa_free(ProjArea, entry->reach);
+	if (DsaPointerIsValid(entry->xip))
+		dsa_free(ProjArea, entry->xip);
+
+	MemSet(entry, 0, sizeof(*entry));
+	ProjShared->nentries--;
+}
+
+static void
+unpin_projection(GraphProjectionEntry *entry)
+{
+	LWLockAcquire(GraphProjectionLock, LW_EXCLUSIVE);
+	Assert(entry->refcount > 0);
+	entry->refcount--;
+	if (entry->dropped && entry->refcount == 0)
+		free_projection(entry);
+	LWLockRelease(GraphProjectionLock);
+}
+
+static void
+release_projection(void *arg)
+{
+	GraphProjectionRef *ref = (GraphProjectionRef *) arg;
+
+	/* already released at exit */
+	if (ref->entry == NULL)
+		return;
+
+	dlist_delete(&ref->node);
+	unpin_projection(ref->entry);
+	ref->entry = NULL;
+}
+
+/*
+ * Release the pins that are still held when the backend exits, which happens
+ * if it exits without resetting the memory contexts of the pins.
+ */
+static void
+release_projections_at_exit(int code, Datum arg)
+{
+	while (!dlist_is_empty(&HeldProjections))
+	{
+		GraphProjectionRef *ref;
+
+		ref = dlist_container(GraphProjectionRef, node,
+							  dlist_pop_head_node(&HeldProjections));
+		unpin_projection(ref->entry);
+		ref->entry = NULL;
+	}
+}
+
+/*
+ * Return the total size of the projections of all databases, but the given
+ * one. The caller must hold GraphProjectionLock.
+ */
+static Size
+projection_memory_used(GraphProjectionEntry *except)
+{
+	Size		used = 0;
+	int			i;
+
+	for (i = 0; i < MAX_GRAPH_PROJECTIONS; i++)
+	{
+		GraphProjectionEntry *entry = &ProjShared->entries[i];
+
+		if (entry->in_use && entry != except)
+			used = add_size(used, entry->size);
+	}
+
+	return used;
+}
+
+/*
+ * Raise an error if a projection of the given size would take the total size
+ * of projections over graph_projection_memory. except is a projection that
+ * the new one replaces. The caller must hold GraphProjectionLock.
+ */
+static void
+check_projection_memory(const char *name, Size size,
+						GraphProjectionEntry *except)
+{
+	Size		limit = (Size) graph_projection_memory * 1024;
+
+	if (add_size(projection_memory_used(except), size) <= limit)
+		return;
+
+	LWLockRelease(GraphProjectionLock);
+	ereport(ERROR,
+			(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+			 errmsg("graph projection \"%s\" does not fit in graph_projection_memory",
+					name),
+			 errdetail("The projection needs %zu bytes.", size),
+			 errhint("Drop graph projections that are not used, or increase graph_projection_memory.")));
+}
+
+/*
+ * Could the current user read all of the relations directly? Rows hidden by
+ * row-level security are in the projection, so a user that RLS applies to
+ * must not use it. A relation that has been dropped since the build makes
+ * the projection unusable as well.
+ */
+static bool
+projection_readable(Oid *rels, int nrels)
+{
+	int			i;
+
+	for (i = 0; i < nrels; i++)
+	{
+		if (!SearchSysCacheExists1(RELOID, ObjectIdGetDatum(rels[i])))
+			return false;
+		if (pg_class_aclcheck(rels[i], GetUserId(), ACL_SELECT) != ACLCHECK_OK)
+			return false;
+		if (check_enable_rls(rels[i], InvalidOid, true) == RLS_ENABLED)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Raise an error unless the current user owns the label or is a superuser.
+ * If the label is gone, the user must be the owner of the projection.
+ */
+static void
+check_label_owner(Oid laboid, Oid owner, const char *name)
+{
+	Oid			relid = get_laboid_relid(laboid);
+
+	if (superuser())
+		return;
+
+	if (OidIsValid(relid))
+	{
+		if (!pg_class_ownercheck(relid, GetUserId()))
+			ereport(ERROR,
+					(errcode(ERRCODE_INSUFFICIENT_PRIVILEGE),
+					 errmsg("must be owner of label \"%s\"",
+							get_rel_name(relid))));
+	}
+	else if (owner != GetUserId())
+	{
+		ereport(ERROR,
+				(errcode(ERRCODE_INSUFFICIENT_PRIVILEGE),
+				 errmsg("must be owner of graph projection \"%s\"", name)));
+	}
+}
+
+/*
+ * Does the snapshot see at least the transactions the build snapshot of the
+ * projection saw as committed? That is, is every transaction that the
+ * snapshot sees as running either running or not yet started for the build
+ * snapshot? The caller must hold GraphProjectionLock.
+ */
+static bool
+snapshot_covers_projection(GraphProjectionEntry *entry, Snapshot snapshot)
+{
+	TransactionId *xip = NULL;
+	int			i;
+	int			j;
+
+	if (!IsMVCCSnapshot(snapshot) || snapshot->takenDuringRecovery)
+		return false;
+	if (TransactionIdPrecedes(snapshot->xmax, entry->xmax))
+		return false;
+
+	if (entry->xcnt > 0)
+		xip = (TransactionId *) dsa_get_address(ProjArea, entry->xip);
+
+	for (i = 0; i < snapshot->xcnt; i++)
+	{
+		TransactionId xid = snapshot->xip[i];
+
+		if (!TransactionIdPrecedes(xid, entry->xmax))
+			continue;
+
+		for (j = 0; j < entry->xcnt; j++)
+		{
+			if (TransactionIdEquals(xip[j], xid))
+				break;
+		}
+		if (j == entry->xcnt)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Are all the relations of the edge label among those the projection was
+ * built from? A child label made after the build is not.
+ */
+static bool
+rels_cover_label(GraphProjectionEntry *entry, List *rels)
+{
+	ListCell   *lc;
+
+	foreach(lc, rels)
+	{
+		Oid			relid = lfirst_oid(lc);
+		int			i;
+
+		for (i = 0; i < entry->nrels; i++)
+		{
+			if (entry->rels[i] == relid)
+				break;
+		}
+		if (i == entry->nrels)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Find a projection of the edge label that is usable for the snapshot and
+ * readable by the current user, and pin it until mcxt is reset or deleted.
+ * If weight_key is given, the projection must have the property as weights.
+ * If need_reach is true, it must have a reachability index.
+ */
+static GraphProjectionEntry *
+acquire_projection(Oid elabel, const char *weight_key, bool need_reach,
+				   Snapshot snapshot, MemoryContext mcxt)
+{
+	List	   *rels;
+	GraphProjectionEntry *found = NULL;
+	GraphProjectionRef *ref;
+	Oid			found_rels[GRAPH_PROJECTION_MAX_RELS];
+	int			found_nrels = 0;
+	int			i;
+
+	if (ProjShared == NULL || ProjShared->nentries == 0)
+		return NULL;
+
+	rels = find_all_inheritors(get_laboid_relid(elabel), NoLock, NULL);
+
+	get_projection_area();
+
+	if (!ProjExitCallbackRegistered)
+	{
+		before_shmem_exit(release_projections_at_exit, 0);
+		ProjExitCallbackRegistered = true;
+	}
+
+	/* allocate it first, so that nothing can fail after the pin */
+	ref = MemoryContextAlloc(mcxt, sizeof(*ref));
+
+	LWLockAcquire(GraphProjectionLock, LW_EXCLUSIVE);
+	for (i = 0; i < MAX_GRAPH_PROJECTIONS; i++)
+	{
+		GraphProjectionEntry *entry = &ProjShared->entries[i];
+
+		if (!entry->in_use || entry->dropped || !entry->valid ||
+			entry->dbid != MyDatabaseId || entry->elabel != elabel ||
+			OidIsValid(entry->vlabel))
+			continue;
+		if (weight_key != NULL &&
+			(!entry->has_weight ||
+			 strcmp(NameStr(entry->weight_key), weight_key) != 0))
+			continue;
+		if (need_reach && !DsaPointerIsValid(entry->reach))
+			continue;
+		if (!snapshot_covers_projection(entry, snapshot) ||
+			!rels_cover_label(entry, rels))
+			continue;
+
+		/* take the newest one */
+		if (found == NULL || entry->built > found->built)
+			found = entry;
+	}
+	if (found != NULL)
+	{
+		found->refcount++;
+		found_nrels = found->nrels;
+		memcpy(found_rels, found->rels, sizeof(Oid) * found_nrels);
+	}
+	LWLockRelease(GraphProjectionLock);
+
+	list_free(rels);
+
+	if (found == NULL)
+	{
+		pfree(ref);
+		return NULL;
+	}
+
+	/* the catalogs are looked up while the entry is pinned, not locked */
+	if (!projection_readable(found_rels, found_nrels))
+	{
+		unpin_projection(found);
+		pfree(ref);
+		return NULL;
+	}
+
+	ref->entry = found;
+	ref->cb.func = release_projection;
+	ref->cb.arg = ref;
+	dlist_push_head(&HeldProjections, &ref->node);
+	MemoryContextRegisterResetCallback(mcxt, &ref->cb);
+
+	return found;
+}
+
+/*
+ * GetGraphProjection
+ *		Find a projection of the edge label that is usable for the snapshot.
+ *
+ * If weight_key is given, the projection must have the property as weights.
+ * On success, csr is set up to access the projection, which stays there
+ * until mcxt is reset or deleted, and *name is set to its name, allocated in
+ * mcxt.
+ */
+bool
+GetGraphProjection(Oid elabel, const char *weight_key, Snapshot snapshot,
+				   MemoryContext mcxt, GraphCSR *csr, char **name)
+{
+	GraphProjectionEntry *entry;
+
+	entry = acquire_projection(elabel, weight_key, false, snapshot, mcxt);
+	if (entry == NULL)
+		return false;
+
+	/* the data of a pinned entry does not change */
+	graph_csr_init(csr, dsa_get_address(ProjArea, entry->data));
+	*name = MemoryContextStrdup(mcxt, NameStr(entry->name));
+	return true;
+}
+
+/*
+ * GetGraphReachability
+ *		Same as GetGraphProjection() but also set up the reachability index
+ *		of the projection.
+ */
+bool
+GetGraphReachability(Oid elabel, Snapshot snapshot, MemoryContext mcxt,
+					 GraphCSR *csr, GraphReach *reach)
+{
+	GraphProjectionEntry *entry;
+
+	entry = acquire_projection(elabel, NULL, true, snapshot, mcxt);
+	if (entry == NULL)
+		return false;
+
+	graph_csr_init(csr, dsa_get_address(ProjArea, entry->data));
+	graph_reach_init(reach, dsa_get_address(ProjArea, entry->reach));
+	return true;
+}
+
+/*
+ * GraphReachabilityExists
+ *		Is there a projection of the edge label with a reachability index?
+ *
+ * The projection may not be usable when it comes to it, so this only tells
+ * whether it is worth trying GetGraphReachability() later.
+ */
+bool
+GraphReachabilityExists(Oid elabel)
+{
+	bool		found = false;
+	int			i;
+
+	if (ProjShared == NULL || ProjShared->nentries == 0)
+		return false;
+
+	LWLockAcquire(GraphProjectionLock, LW_SHARED);
+	for (i = 0; i < MAX_GRAPH_PROJECTIONS; i++)
+	{
+		GraphProjectionEntry *entry = &ProjShared->entries[i];
+
+		if (entry->in_use && !entry->dropped &&
+			entry->dbid == MyDatabaseId && entry->elabel == elabel &&
+			!OidIsValid(entry->vlabel) && DsaPointerIsValid(entry->reach))
+		{
+			found = true;
+			break;
+		}
+	}
+	LWLockRelease(GraphProjectionLock);
+
+	return found;
+}
+
+/*
+ * GraphProjectionRelationModified
+ *		Make the projections built from the relation stale.
+ *
+ * This is called before the relation is modified.
+ */
+void
+GraphProjectionRelationModified(Oid relid)
+{
+	bool		found = false;
+	int			i;
+	int			j;
+
+	if (ProjShared == NULL || ProjShared->nentries == 0)
+		return;
+
+	LWLockAcquire(GraphProjectionLock, LW_SHARED);
+	for (i = 0; i < MAX_GRAPH_PROJECTIONS && !found; i++)
+	{
+		GraphProjectionEntry *entry = &ProjShared->entries[i];
+
+		if (!entry->in_use || !entry->valid || entry->dbid != MyDatabaseId)
+			continue;
+
+		for (j = 0; j < entry->nrels; j++)
+		{
+			if (entry->rels[j] == relid)
+			{
+				found = true;
+				break;
+			}
+		}
+	}
+	LWLockRelease(GraphProjectionLock);
+
+	if (!found)
+		return;
+
+	LWLockAcquire(GraphProjectionLock, LW_EXCLUSIVE);
+	for (i = 0; i < MAX_GRAPH_PROJECTIONS; i++)
+	{
+		GraphProjectionEntry *entry = &ProjShared->entries[i];
+
+		if (!entry->in_use || entry->dbid != MyDatabaseId)
+			continue;
+
+		for (j = 0; j < entry->nrels; j++)
+		{
+			if (entry->rels[j] == relid)
+			{
+				entry->valid = false;
+				break;
+			}
+		}
+	}
+	LWLockRelease(GraphProjectionLock);
+}
+
+/*
+ * get_graph_label_oid
+ *		Look up a label of the given kind in a graph, or raise an error.
+ */
+Oid
+get_graph_label_oid(const char *labname, Oid graphid, char labkind)
+{
+	HeapTuple	tuple;
+	Form_ag_label labtup;
+	Oid			laboid;
+
+	tuple = SearchSysCache2(LABELNAMEGRAPH, CStringGetDatum(labname),
+							ObjectIdGetDatum(graphid));
+	if (!HeapTupleIsValid(tuple))
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_OBJECT),
+				 errmsg("%s label \"%s\" does not exist",
+						(labkind == LABEL_KIND_VERTEX ? "vertex" : "edge"),
+						labname)));
+
+	labtup = (Form_ag_label) GETSTRUCT(tuple);
+	if (labtup->labkind != labkind)
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("label \"%s\" is %s label", labname,
+						(labtup->labkind == LABEL_KIND_VERTEX ?
+						 "vertex" : "edge"))));
+
+	laboid = HeapTupleGetOid(tuple);
+	ReleaseSysCache(tuple);
+
+	return laboid;
+}
+
+/*
+ * Build a projection and install it under the name. If refresh is true, it
+ * replaces the projection that has the name.
+ */
+static void
+build_projection(const char *name, Oid owner, Oid graphid, Oid elabel,
+				 Oid vlabel, const char *weight_key, bool reachability,
+				 bool refresh)
+{
+	List	   *rels;
+	ListCell   *lc;
+	Snapshot	snapshot;
+	GraphCSRData *data;
+	GraphReachData *reach = NULL;
+	Size		csr_size;
+	Size		reach_size = 0;
+	Size		xip_size;
+	Size		size;
+	dsa_area   *area;
+	dsa_pointer dp;
+	dsa_pointer reach_dp = InvalidDsaPointer;
+	dsa_pointer xip_dp = InvalidDsaPointer;
+	GraphProjectionEntry *old;
+	GraphProjectionEntry *entry = NULL;
+	int			i;
+
+	/*
+	 * The labels may have been modified by this transaction before the
+	 * projection existed, and other snapshots do not see those changes.
+	 */
+	if (TransactionIdIsValid(GetTopTransactionIdIfAny()))
+		ereport(ERROR,
+				(errcode(ERRCODE_ACTIVE_SQL_TRANSACTION),
+				 errmsg("cannot build graph projection in a transaction that has modified data")));
+
+	/* wait for writers in progress and keep new ones out until we are done */
+	rels = find_all_inheritors(get_laboid_relid(elabel), ShareLock, NULL);
+	if (OidIsValid(vlabel))
+		rels = list_concat_unique_oid(rels,
+									  find_all_inheritors(get_laboid_relid(vlabel),
+														  ShareLock, NULL));
+	if (list_length(rels) > GRAPH_PROJECTION_MAX_RELS)
+		ereport(ERROR,
+				(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+				 errmsg("too many labels for graph projection \"%s\"", name)));
+
+	/* the projection must not be a view of the label filtered for its owner */
+	foreach(lc, rels)
+	{
+		Oid			relid = lfirst_oid(lc);
+
+		if (check_enable_rls(relid, InvalidOid, false) == RLS_ENABLED)
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("cannot build graph projection \"%s\" of label \"%s\" with row-level security",
+							name, get_rel_name(relid))));
+	}
+
+	snapshot = RegisterSnapshot(GetLatestSnapshot());
+
+	/* build everything in local memory first, this may take a while */
+	data = graph_csr_build(elabel, weight_key, vlabel, snapshot);
+	csr_size = graph_csr_size(data);
+	if (reachability)
+	{
+		GraphCSR	csr;
+
+		graph_csr_init(&csr, data);
+		reach = graph_reach_build(&csr);
+		reach_size = graph_reach_size(reach);
+	}
+	size = add_size(csr_size, reach_size);
+	xip_size = mul_size(snapshot->xcnt, sizeof(TransactionId));
+
+	area = get_projection_area();
+
+	/* fail early, before the copy to shared memory */
+	LWLockAcquire(GraphProjectionLock, LW_SHARED);
+	check_projection_memory(name, size,
+							(refresh ? find_projection(name) : NULL));
+	LWLockRelease(GraphProjectionLock);
+
+	/*
+	 * The chunks are not freed if an ERROR is raised before the projection
+	 * owns them, and the area is pinned, so they would stay until the server
+	 * restarts. Allocate them all without anything in between that may raise
+	 * one, and free them on every way out below.
+	 */
+	dp = dsa_allocate_extended(area, csr_size,
+							   DSA_ALLOC_HUGE | DSA_ALLOC_NO_OOM);
+	if (reach != NULL)
+		reach_dp = dsa_allocate_extended(area, reach_size,
+										 DSA_ALLOC_HUGE | DSA_ALLOC_NO_OOM);
+	if (xip_size > 0)
+		xip_dp = dsa_allocate_extended(area, xip_size, DSA_ALLOC_NO_OOM);
+	if (!DsaPointerIsValid(dp) ||
+		(reach != NULL && !DsaPointerIsValid(reach_dp)) ||
+		(xip_size > 0 && !DsaPointerIsValid(xip_dp)))
+	{
+		if (DsaPointerIsValid(dp))
+			dsa_free(area, dp);
+		if (DsaPointerIsValid(reach_dp))
+			dsa_free(area, reach_dp);
+		if (DsaPointerIsValid(xip_dp))
+			dsa_free(area, xip_dp);
+		ereport(ERROR,
+				(errcode(ERRCODE_OUT_OF_MEMORY),
+				 errmsg("out of shared memory"),
+				 errdetail("Failed on request of size %zu.",
+						   add_size(size, xip_size))));
+	}
+
+	memcpy(dsa_get_address(area, dp), data, csr_size);
+	if (reach != NULL)
+		memcpy(dsa_get_address(area, reach_dp), reach, reach_size);
+	if (xip_size > 0)
+		memcpy(dsa_get_address(area, xip_dp), snapshot->xip, xip_size);
+
+	LWLockAcquire(GraphProjectionLock, LW_EXCLUSIVE);
+
+	old = find_projection(name);
+	if ((old != NULL) == refresh)
+	{
+		/* the old one does not count, it goes away with its last scan */
+		if (add_size(projection_memory_used(old), size) >
+			(Size) graph_projection_memory * 1024)
+		{
+			dsa_free(area, dp);
+			if (DsaPointerIsValid(reach_dp))
+				dsa_free(area, reach_dp);
+			if (DsaPointerIsValid(xip_dp))
+				dsa_free(area, xip_dp);
+			check_projection_memory(name, size, old);
+		}
+
+		if (old != NULL && old->refcount == 0)
+		{
+			/* nobody uses the old one, reuse its slot */
+			free_projection(old);
+			entry = old;
+			old = NULL;
+		}
+		else
+		{
+			for (i = 0; i < MAX_GRAPH_PROJECTIONS; i++)
+			{
+				if (!ProjShared->entries[i].in_use)
+				{
+					entry = &ProjShared->entries[i];
+					break;
+				}
+			}
+		}
+	}
+
+	if (entry == NULL)
+	{
+		LWLockRelease(GraphProjectionLock);
+
+		dsa_free(area, dp);
+		if (DsaPointerIsValid(reach_dp))
+			dsa_free(area, reach_dp);
+		if (DsaPointerIsValid(xip_dp))
+			dsa_free(area, xip_dp);
+
+		if (old != NULL && !refresh)
+			ereport(ERROR,
+					(errcode(ERRCODE_DUPLICATE_OBJECT),
+					 errmsg("graph projection \"%s\" already exists", name)));
+		if (old == NULL && refresh)
+			ereport(ERROR,
+					(errcode(ERRCODE_UNDEFINED_OBJECT),
+					 errmsg("graph projection \"%s\" does not exist", name)));
+		ereport(ERROR,
+				(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+				 errmsg("too many graph projections"),
+				 errhint("Drop graph projections that are not used.")));
+	}
+
+	/* the old one goes away when the scans using it are done */
+	if (old != NULL)
+		old->dropped = true;
+
+	MemSet(entry, 0, sizeof(*entry));
+	entry->in_use = true;
+	entry->valid = true;
+	entry->dbid = MyDatabaseId;
+	entry->owner = owner;
+	namestrcpy(&entry->name, name);
+	entry->graphid = graphid;
+	entry->elabel = elabel;
+	entry->vlabel = vlabel;
+	entry->has_weight = (weight_key != NULL);
+	if (weight_key != NULL)
+		namestrcpy(&entry->weight_key, weight_key);
+	i = 0;
+	foreach(lc, rels)
+		entry->rels[i++] = lfirst_oid(lc);
+	entry->nrels = i;
+	entry->xmin = snapshot->xmin;
+	entry->xmax = snapshot->xmax;
+	entry->xcnt = snapshot->xcnt;
+	entry->xip = xip_dp;
+	entry->data = dp;
+	entry->reach = reach_dp;
+	entry->nvertices = data->nvertices;
+	entry->nedges = data->nedges;
+	entry->size = size;
+	entry->built = GetCurrentTimestamp();
+	ProjShared->nentries++;
+
+	LWLockRelease(GraphProjectionLock);
+
+	pfree(data);
+	if (reach != NULL)
+		pfree(reach);
+	UnregisterSnapshot(snapshot);
+	list_free(rels);
+}
+
+static char *
+text_to_name(text *t, const char *what)
+{
+	char	   *s = text_to_cstring(t);
+
+	if (strlen(s) >= NAMEDATALEN)
+		ereport(ERROR,
+				(errcode(ERRCODE_NAME_TOO_LONG),
+				 errmsg("%s \"%s\" is too long", what, s)));
+
+	return s;
+}
+
+static Datum
+name_datum(const char *s, bool *isnull)
+{
+	if (s == NULL)
+	{
+		*isnull = true;
+		return (Datum) 0;
+	}
+
+	*isnull = false;
+	return DirectFunctionCall1(namein, CStringGetDatum(s));
+}
+
+/*
+ * graph_projection_create(name, edge_label, weight, vertex_label,
+ *							reachability)
+ */
+Datum
+graph_projection_create(PG_FUNCTION_ARGS)
+{
+	char	   *name;
+	char	   *weight_key = NULL;
+	Oid			graphid;
+	Oid			elabel;
+	Oid			vlabel = InvalidOid;
+	bool		reachability;
+
+	if (PG_ARGISNULL(0) || PG_ARGISNULL(1))
+		ereport(ERROR,
+				(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+				 errmsg("name and edge label of graph projection must not be null")));
+
+	name = text_to_name(PG_GETARG_TEXT_PP(0), "graph projection name");
+	if (!PG_ARGISNULL(2))
+		weight_key = text_to_name(PG_GETARG_TEXT_PP(2), "weight property");
+
+	graphid = get_graph_path_oid();
+	elabel = get_graph_label_oid(text_to_cstring(PG_GETARG_TEXT_PP(1)),
+								 graphid, LABEL_KIND_EDGE);
+	if (!PG_ARGISNULL(3))
+		vlabel = get_graph_label_oid(text_to_cstring(PG_GETARG_TEXT_PP(3)),
+									 graphid, LABEL_KIND_VERTEX);
+	reachability = (!PG_ARGISNULL(4) && PG_GETARG_BOOL(4));
+
+	check_label_owner(elabel, InvalidOid, name);
+	if (OidIsValid(vlabel))
+		check_label_owner(vlabel, InvalidOid, name);
+
+	build_projection(name, GetUserId(), graphid, elabel, vlabel, weight_key,
+					 reachability, false);
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * graph_projection_refresh(name)
+ *		Rebuild a projection from the current contents of its labels.
+ */
+Datum
+graph_projection_refresh(PG_FUNCTION_ARGS)
+{
+	char	   *name = text_to_name(PG_GETARG_TEXT_PP(0),
+									"graph projection name");
+	GraphProjectionEntry *entry;
+	Oid			owner = InvalidOid;
+	Oid			graphid = InvalidOid;
+	Oid			elabel = InvalidOid;
+	Oid			vlabel = InvalidOid;
+	NameData	weight_key;
+	bool		has_weight = false;
+	bool		reachability = false;
+
+	LWLockAcquire(GraphProjectionLock, LW_SHARED);
+	entry = find_projection(name);
+	if (entry != NULL)
+	{
+		owner = entry->owner;
+		graphid = entry->graphid;
+		elabel = entry->elabel;
+		vlabel = entry->vlabel;
+		has_weight = entry->has_weight;
+		weight_key = entry->weight_key;
+		reachability = DsaPointerIsValid(entry->reach);
+	}
+	LWLockRelease(GraphProjectionLock);
+
+	if (entry == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_OBJECT),
+				 errmsg("graph projection \"%s\" does not exist", name)));
+	check_label_owner(elabel, owner, name);
+	if (OidIsValid(vlabel))
+		check_label_owner(vlabel, owner, name);
+
+	build_projection(name, owner, graphid, elabel, vlabel,
+					 (has_weight ? NameStr(weight_key) : NULL), reachability,
+					 true);
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * graph_projection_drop(name)
+ *		Drop a projection. Its memory is freed when no scan uses it.
+ */
+Datum
+graph_projection_drop(PG_FUNCTION_ARGS)
+{
+	char	   *name = text_to_name(PG_GETARG_TEXT_PP(0),
+									"graph projection name");
+	GraphProjectionEntry *entry;
+	Oid			owner = InvalidOid;
+	Oid			elabel = InvalidOid;
+	Oid			vlabel = InvalidOid;
+
+	if (ProjShared->nentries > 0)
+		get_projection_area();
+
+	/* look the labels up without holding the lock */
+	LWLockAcquire(GraphProjectionLock, LW_SHARED);
+	entry = find_projection(name);
+	if (entry != NULL)
+	{
+		owner = entry->owner;
+		elabel = entry->elabel;
+		vlabel = entry->vlabel;
+	}
+	LWLockRelease(GraphProjectionLock);
+
+	if (entry == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_OBJECT),
+				 errmsg("graph projection \"%s\" does not exist", name)));
+	check_label_owner(elabel, owner, name);
+	if (OidIsValid(vlabel))
+		check_label_owner(vlabel, owner, name);
+
+	LWLockAcquire(GraphProjectionLock, LW_EXCLUSIVE);
+	entry = find_projection(name);
+	if (entry == NULL)
+	{
+		LWLockRelease(GraphProjectionLock);
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_OBJECT),
+				 errmsg("graph projection \"%s\" does not exist", name)));
+	}
+
+	entry->dropped = true;
+	if (entry->refcount == 0)
+		free_projection(entry);
+	LWLockRelease(GraphProjectionLock);
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * graph_projections()
+ *		List the projections of the current database.
+ */
+Datum
+graph_projections(PG_FUNCTION_ARGS)
+{
+#define GRAPH_PROJECTIONS_COLS	11
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	TupleDesc	tupdesc;
+	Tuplestorestate *tupstore;
+	MemoryContext oldcxt;
+	GraphProjectionEntry *entries;
+	int			nentries = 0;
+	int			i;
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not allowed in this context")));
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	oldcxt = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = tupdesc;
+	MemoryContextSwitchTo(oldcxt);
+
+	/* copy the entries to look up the catalogs without holding the lock */
+	entries = palloc(sizeof(GraphProjectionEntry) * MAX_GRAPH_PROJECTIONS);
+	LWLockAcquire(GraphProjectionLock, LW_SHARED);
+	for (i = 0; i < MAX_GRAPH_PROJECTIONS; i++)
+	{
+		GraphProjectionEntry *entry = &ProjShared->entries[i];
+
+		if (entry->in_use && !entry->dropped && entry->dbid == MyDatabaseId)
+			entries[nentries++] = *entry;
+	}
+	LWLockRelease(GraphProjectionLock);
+
+	for (i = 0; i < nentries; i++)
+	{
+		GraphProjectionEntry *entry = &entries[i];
+		Datum		values[GRAPH_PROJECTIONS_COLS];
+		bool		nulls[GRAPH_PROJECTIONS_COLS];
+		Oid			relid;
+
+		values[0] = NameGetDatum(&entry->name);
+		nulls[0] = false;
+		values[1] = name_datum(get_graphid_graphname(entry->graphid),
+							   &nulls[1]);
+		relid = get_laboid_relid(entry->elabel);
+		values[2] = name_datum(OidIsValid(relid) ? get_rel_name(relid) : NULL,
+							   &nulls[2]);
+		relid = get_laboid_relid(entry->vlabel);
+		values[3] = name_datum(OidIsValid(relid) ? get_rel_name(relid) : NULL,
+							   &nulls[3]);
+		if (entry->has_weight)
+		{
+			values[4] = CStringGetTextDatum(NameStr(entry->weight_key));
+			nulls[4] = false;
+		}
+		else
+		{
+			values[4] = (Datum) 0;
+			nulls[4] = true;
+		}
+		values[5] = BoolGetDatum(DsaPointerIsValid(entry->reach));
+		nulls[5] = false;
+		values[6] = Int64GetDatum(entry->nvertices);
+		nulls[6] = false;
+		values[7] = Int64GetDatum(entry->nedges);
+		nulls[7] = false;
+		values[8] = Int64GetDatum((int64) entry->size);
+		nulls[8] = false;
+		values[9] = BoolGetDatum(entry->valid);
+		nulls[9] = false;
+		values[10] = TimestampTzGetDatum(entry->built);
+		nulls[10] = false;
+
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+
+	pfree(entries);
+
+	return (Datum) 0;
+}
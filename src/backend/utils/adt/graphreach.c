@@ -0,0 +1,656 @@
+/*
+ * graphreach.c
+ *	  Reachability index over the CSR of an edge label.
+ *
+ * The strongly connected components (SCCs) of the graph are condensed into
+ * a DAG. Components are numbered in the order Tarjan's algorithm finishes
+ * them, so every edge of the DAG goes from a larger number to a smaller one.
+ * A depth-first traversal of the DAG gives each component a pre-order and a
+ * post-order number. If the path u -> v exists, post[v] < post[u], and if v
+ * is a descendant of u in the traversal, pre[u] < pre[v] as well. These
+ * answer most queries right away; the rest search the DAG, pruning every
+ * component that cannot reach the target by the same rules.
+ *
+ * Copyright (c) 2016 by Bitnine Global, Inc.
+ *
+ * IDENTIFICATION
+ *	  src/backend/utils/adt/graphreach.c
+ */
+
+#include "postgres.h"
+
+#include "access/transam.h"
+#include "catalog/ag_graph_fn.h"
+#include "catalog/ag_label.h"
+#include "miscadmin.h"
+#include "storage/shmem.h"
+#include "utils/builtins.h"
+#include "utils/graphprojection.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+#include "utils/snapmgr.h"
+
+/* arrays of GraphReachData in the order they are laid out */
+#define REACH_COMP		0
+#define REACH_CYCLIC	1
+#define REACH_PRE		2
+#define REACH_POST		3
+#define REACH_DAG_OFF	4
+#define REACH_DAG_ADJ	5
+#define REACH_NUM_ARRAYS 6
+
+#define UNVISITED		PG_UINT32_MAX
+
+/* a reachability index in one chunk of memory, the arrays follow the header */
+struct GraphReachData
+{
+	int64		nvertices;
+	int64		ncomps;
+	int64		nedges;			/* number of edges of the DAG */
+	Size		size;			/* size of the whole chunk */
+};
+
+typedef struct DagEdge
+{
+	uint32		src;
+	uint32		dst;
+} DagEdge;
+
+/* frame of the depth-first traversals */
+typedef struct DfsFrame
+{
+	uint32		v;
+	int64		next;			/* next edge of v to follow */
+} DfsFrame;
+
+/*
+ * What reachable() and reachable_index() keep across calls. The same
+ * FmgrInfo may be used by several statements, for example by PL/pgSQL for a
+ * simple expression, so the index is kept only for the snapshot it was made
+ * for.
+ */
+typedef struct ReachCache
+{
+	MemoryContext mcxt;			/* holds the index, reset to rebuild it */
+	Oid			elabel;			/* InvalidOid if the cache is empty */
+	bool		has_index;		/* false if there was no usable projection */
+	TransactionId xmin;			/* the snapshot of the index */
+	TransactionId xmax;
+	CommandId	curcid;
+	uint32		xcnt;
+	TransactionId *xip;
+	int32		subxcnt;
+	bool		suboverflowed;
+	TransactionId *subxip;
+	GraphCSR	csr;
+	GraphReach	reach;
+} ReachCache;
+
+static Size reach_layout(int64 nvertices, int64 ncomps, int64 nedges,
+			 Size *offsets);
+static uint32 *find_sccs(GraphCSR *csr, int64 *ncomps);
+static int	dagedge_cmp(const void *a, const void *b);
+static bool reach_descends(GraphReach *reach, uint32 cu, uint32 cv);
+static bool reach_cache_usable(ReachCache *cache, Oid elabel,
+				   Snapshot snapshot);
+static void reach_cache_set_snapshot(ReachCache *cache, Snapshot snapshot);
+static ReachCache *get_reach_cache(FunctionCallInfo fcinfo, Oid elabel,
+				bool build);
+
+static Size
+reach_layout(int64 nvertices, int64 ncomps, int64 nedges, Size *offsets)
+{
+	Size		size = MAXALIGN(sizeof(GraphReachData));
+	int			i;
+
+	for (i = 0; i < REACH_NUM_ARRAYS; i++)
+	{
+		Size		len;
+
+		switch (i)
+		{
+			case REACH_COMP:
+				len = mul_size(nvertices, sizeof(uint32));
+				break;
+			case REACH_CYCLIC:
+				len = mul_size(ncomps, sizeof(bool));
+				break;
+			case REACH_PRE:
+			case REACH_POST:
+				len = mul_size(ncomps, sizeof(uint32));
+				break;
+			case REACH_DAG_OFF:
+				len = mul_size(ncomps + 1, sizeof(int64));
+				break;
+			default:
+				len = mul_size(nedges, sizeof(uint32));
+				break;
+		}
+
+		offsets[i] = size;
+		size = add_size(size, MAXALIGN(len));
+	}
+
+	return size;
+}
+
+/*
+ * graph_reach_build
+ *		Build the reachability index of a CSR in the current memory context.
+ */
+GraphReachData *
+graph_reach_build(GraphCSR *csr)
+{
+	uint32	   *comp;
+	int64		ncomps;
+	uint32	   *nmembers;
+	DagEdge    *edges;
+	int64		nedges = 0;
+	GraphReachData *data;
+	GraphReach	reach;
+	Size		offsets[REACH_NUM_ARRAYS];
+	Size		size;
+	DfsFrame   *stack;
+	int64		depth;
+	uint32		counter;
+	int64		c;
+	int64		v;
+	int64		i;
+
+	comp = find_sccs(csr, &ncomps);
+
+	/* edges between components, and loops that make a component cyclic */
+	edges = MemoryContextAllocHuge(CurrentMemoryContext,
+								   mul_size(Max(csr->nedges, 1),
+											sizeof(DagEdge)));
+	for (v = 0; v < csr->nvertices; v++)
+	{
+		for (i = csr->out_off[v]; i < csr->out_off[v + 1]; i++)
+		{
+			edges[nedges].src = comp[v];
+			edges[nedges].dst = comp[csr->out_adj[i]];
+			nedges++;
+		}
+	}
+	qsort(edges, nedges, sizeof(DagEdge), dagedge_cmp);
+
+	CHECK_FOR_INTERRUPTS();
+
+	/* count the distinct edges of the DAG to lay it out */
+	size = 0;
+	for (i = 0; i < nedges; i++)
+	{
+		if (edges[i].src != edges[i].dst &&
+			(i == 0 || dagedge_cmp(&edges[i - 1], &edges[i]) != 0))
+			size++;
+	}
+
+	size = reach_layout(csr->nvertices, ncomps, (int64) size, offsets);
+	data = MemoryContextAllocHuge(CurrentMemoryContext, size);
+	data->nvertices = csr->nvertices;
+	data->ncomps = ncomps;
+	data->nedges = 0;
+	data->size = size;
+	graph_reach_init(&reach, data);
+
+	memcpy(reach.comp, comp, csr->nvertices * sizeof(uint32));
+	pfree(comp);
+
+	/* a component is cyclic if it has more than one vertex or a loop */
+	memset(reach.cyclic, 0, ncomps * sizeof(bool));
+	nmembers = palloc_extended(mul_size(Max(ncomps, 1), sizeof(uint32)),
+							   MCXT_ALLOC_HUGE | MCXT_ALLOC_ZERO);
+	for (v = 0; v < csr->nvertices; v++)
+	{
+		if (++nmembers[reach.comp[v]] > 1)
+			reach.cyclic[reach.comp[v]] = true;
+	}
+	pfree(nmembers);
+
+	memset(reach.dag_off, 0, (ncomps + 1) * sizeof(int64));
+	for (i = 0; i < nedges; i++)
+	{
+		if (edges[i].src == edges[i].dst)
+		{
+			reach.cyclic[edges[i].src] = true;
+			continue;
+		}
+		if (i > 0 && dagedge_cmp(&edges[i - 1], &edges[i]) == 0)
+			continue;
+
+		reach.dag_off[edges[i].src + 1]++;
+		reach.dag_adj[data->nedges++] = edges[i].dst;
+	}
+	for (c = 0; c < ncomps; c++)
+		reach.dag_off[c + 1] += reach.dag_off[c];
+	pfree(edges);
+
+	CHECK_FOR_INTERRUPTS();
+
+	/*
+	 * Number the components in a depth-first traversal of the DAG. Starting
+	 * from the largest number starts from the components that no edge leads
+	 * to first.
+	 */
+	for (c = 0; c < ncomps; c++)
+		reach.pre[c] = UNVISITED;
+	stack = MemoryContextAllocHuge(CurrentMemoryContext,
+								   mul_size(Max(ncomps, 1), sizeof(DfsFrame)));
+	counter = 0;
+	for (c = ncomps - 1; c >= 0; c--)
+	{
+		if (reach.pre[c] != UNVISITED)
+			continue;
+
+		depth = 0;
+		stack[depth].v = (uint32) c;
+		stack[depth].next = reach.dag_off[c];
+		reach.pre[c] = counter++;
+		while (depth >= 0)
+		{
+			DfsFrame   *frame = &stack[depth];
+
+			if (frame->next < reach.dag_off[frame->v + 1])
+			{
+				uint32		w = reach.dag_adj[frame->next++];
+
+				if (reach.pre[w] == UNVISITED)
+				{
+					depth++;
+					stack[depth].v = w;
+					stack[depth].next = reach.dag_off[w];
+					reach.pre[w] = counter++;
+				}
+			}
+			else
+			{
+				reach.post[frame->v] = counter++;
+				depth--;
+			}
+		}
+	}
+	pfree(stack);
+
+	return data;
+}
+
+/*
+ * Find the SCCs of the graph with an iterative version of Tarjan's algorithm
+ * and return the component of each vertex.
+ */
+static uint32 *
+find_sccs(GraphCSR *csr, int64 *ncomps)
+{
+	int64		nvertices = csr->nvertices;
+	Size		len = mul_size(Max(nvertices, 1), sizeof(uint32));
+	uint32	   *index = MemoryContextAllocHuge(CurrentMemoryContext, len);
+	uint32	   *lowlink = MemoryContextAllocHuge(CurrentMemoryContext, len);
+	uint32	   *comp = MemoryContextAllocHuge(CurrentMemoryContext, len);
+	uint32	   *members = MemoryContextAllocHuge(CurrentMemoryContext, len);
+	DfsFrame   *stack;
+	int64		nmembers = 0;
+	uint32		counter = 0;
+	uint32		ncomp = 0;
+	int64		root;
+
+	stack = MemoryContextAllocHuge(CurrentMemoryContext,
+								   mul_size(Max(nvertices, 1),
+											sizeof(DfsFrame)));
+
+	for (root = 0; root < nvertices; root++)
+	{
+		index[root] = UNVISITED;
+		comp[root] = UNVISITED;
+	}
+
+	for (root = 0; root < nvertices; root++)
+	{
+		int64		depth;
+
+		if (index[root] != UNVISITED)
+			continue;
+
+		depth = 0;
+		stack[0].v = (uint32) root;
+		stack[0].next = csr->out_off[root];
+		index[root] = lowlink[root] = counter++;
+		members[nmembers++] = (uint32) root;
+
+		while (depth >= 0)
+		{
+			DfsFrame   *frame = &stack[depth];
+			uint32		v = frame->v;
+
+			if (frame->next < csr->out_off[v + 1])
+			{
+				uint32		w = csr->out_adj[frame->next++];
+
+				if (index[w] == UNVISITED)
+				{
+					depth++;
+					stack[depth].v = w;
+					stack[depth].next = csr->out_off[w];
+					index[w] = lowlink[w] = counter++;
+					members[nmembers++] = w;
+				}
+				else if (comp[w] == UNVISITED)
+				{
+					/* w is on the stack of the component being built */
+					lowlink[v] = Min(lowlink[v], index[w]);
+				}
+				continue;
+			}
+
+			/* v is done; if it is the root of a component, pop it */
+			if (lowlink[v] == index[v])
+			{
+				uint32		w;
+
+				do
+				{
+					w = members[--nmembers];
+					comp[w] = ncomp;
+				} while (w != v);
+				ncomp++;
+			}
+
+			depth--;
+			if (depth >= 0)
+			{
+				uint32		parent = stack[depth].v;
+
+				lowlink[parent] = Min(lowlink[parent], lowlink[v]);
+			}
+
+			if ((counter & 0xFFFF) == 0)
+				CHECK_FOR_INTERRUPTS();
+		}
+	}
+
+	pfree(index);
+	pfree(lowlink);
+	pfree(members);
+	pfree(stack);
+
+	*ncomps = ncomp;
+	return comp;
+}
+
+static int
+dagedge_cmp(const void *a, const void *b)
+{
+	const DagEdge *ea = (const DagEdge *) a;
+	const DagEdge *eb = (const DagEdge *) b;
+
+	if (ea->src != eb->src)
+		return (ea->src < eb->src) ? -1 : 1;
+	if (ea->dst != eb->dst)
+		return (ea->dst < eb->dst) ? -1 : 1;
+	return 0;
+}
+
+/*
+ * graph_reach_init
+ *		Set up a GraphReach to access the arrays of a GraphReachData.
+ */
+void
+graph_reach_init(GraphReach *reach, GraphReachData *data)
+{
+	Size		offsets[REACH_NUM_ARRAYS];
+	char	   *base = (char *) data;
+
+	reach_layout(data->nvertices, data->ncomps, data->nedges, offsets);
+
+	reach->nvertices = data->nvertices;
+	reach->ncomps = data->ncomps;
+	reach->comp = (uint32 *) (base + offsets[REACH_COMP]);
+	reach->cyclic = (bool *) (base + offsets[REACH_CYCLIC]);
+	reach->pre = (uint32 *) (base + offsets[REACH_PRE]);
+	reach->post = (uint32 *) (base + offsets[REACH_POST]);
+	reach->dag_off = (int64 *) (base + offsets[REACH_DAG_OFF]);
+	reach->dag_adj = (uint32 *) (base + offsets[REACH_DAG_ADJ]);
+}
+
+Size
+graph_reach_size(GraphReachData *data)
+{
+	return data->size;
+}
+
+/* Is cv a descendant of cu in the traversal that numbered them? */
+static bool
+reach_descends(GraphReach *reach, uint32 cu, uint32 cv)
+{
+	return reach->pre[cu] < reach->pre[cv] && reach->post[cv] < reach->post[cu];
+}
+
+/*
+ * graph_reach_query
+ *		Is there a path of one or more edges from vertex u to vertex v?
+ *
+ * u and v are vertex ordinals of the CSR the index was built from.
+ */
+bool
+graph_reach_query(GraphReach *reach, int64 u, int64 v)
+{
+	uint32		cu = reach->comp[u];
+	uint32		cv = reach->comp[v];
+	HASHCTL		ctl;
+	HTAB	   *visited;
+	uint32	   *stack;
+	int64		depth;
+	int64		nstack;
+	bool		found = false;
+
+	if (cu == cv)
+		return (u != v || reach->cyclic[cu]);
+	if (cu < cv || reach->post[cv] > reach->post[cu])
+		return false;
+	if (reach_descends(reach, cu, cv))
+		return true;
+
+	/* search the components that may reach cv */
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(uint32);
+	ctl.entrysize = sizeof(uint32);
+	ctl.hcxt = CurrentMemoryContext;
+	visited = hash_create("reachability search", 256, &ctl,
+						  HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
+	nstack = 256;
+	stack = palloc(nstack * sizeof(uint32));
+	depth = 0;
+	stack[depth++] = cu;
+	while (depth > 0 && !found)
+	{
+		uint32		c = stack[--depth];
+		int64		i;
+
+		CHECK_FOR_INTERRUPTS();
+
+		for (i = reach->dag_off[c]; i < reach->dag_off[c + 1]; i++)
+		{
+			uint32		w = reach->dag_adj[i];
+			bool		seen;
+
+			if (w == cv || reach_descends(reach, w, cv))
+			{
+				found = true;
+				break;
+			}
+			if (w < cv || reach->post[w] < reach->post[cv])
+				continue;
+
+			hash_search(visited, &w, HASH_ENTER, &seen);
+			if (seen)
+				continue;
+
+			if (depth == nstack)
+			{
+				nstack *= 2;
+				stack = repalloc_huge(stack, nstack * sizeof(uint32));
+			}
+			stack[depth++] = w;
+		}
+	}
+
+	pfree(stack);
+	hash_destroy(visited);
+
+	return found;
+}
+
+/*
+ * reachable(start, end, edge_label)
+ *		Is there a path of one or more edges of the label from start to end?
+ *
+ * A graph projection of the label with a reachability index answers it if
+ * there is a usable one. Otherwise, the index is built for the query from
+ * the current contents of the label and kept for the following calls with
+ * the same snapshot.
+ */
+Datum
+reachable(PG_FUNCTION_ARGS)
+{
+	Graphid		start = PG_GETARG_GRAPHID(0);
+	Graphid		end = PG_GETARG_GRAPHID(1);
+	ReachCache *cache;
+	Oid			elabel;
+	int64		u;
+	int64		v;
+
+	elabel = get_graph_label_oid(text_to_cstring(PG_GETARG_TEXT_PP(2)),
+								 get_graph_path_oid(), LABEL_KIND_EDGE);
+
+	cache = get_reach_cache(fcinfo, elabel, true);
+
+	u = graph_csr_ordinal(&cache->csr, start);
+	v = graph_csr_ordinal(&cache->csr, end);
+	if (u < 0 || v < 0)
+		PG_RETURN_BOOL(false);
+
+	PG_RETURN_BOOL(graph_reach_query(&cache->reach, u, v));
+}
+
+/*
+ * reachable_index(start, end, edge_label)
+ *		Same as reachable() but answer only from the reachability index of a
+ *		graph projection.
+ *
+ * This returns NULL if there is no usable projection, so that the caller
+ * can fall back to a traversal. The parser puts it in front of EXISTS
+ * patterns of the form (a)-[:label*]->(b); see transformCypherReachability().
+ */
+Datum
+reachable_index(PG_FUNCTION_ARGS)
+{
+	Graphid		start = PG_GETARG_GRAPHID(0);
+	Graphid		end = PG_GETARG_GRAPHID(1);
+	Oid			elabel = PG_GETARG_OID(2);
+	ReachCache *cache;
+	int64		u;
+	int64		v;
+
+	cache = get_reach_cache(fcinfo, elabel, false);
+	if (!cache->has_index)
+		PG_RETURN_NULL();
+
+	u = graph_csr_ordinal(&cache->csr, start);
+	v = graph_csr_ordinal(&cache->csr, end);
+	if (u < 0 || v < 0)
+		PG_RETURN_BOOL(false);
+
+	PG_RETURN_BOOL(graph_reach_query(&cache->reach, u, v));
+}
+
+/*
+ * Get the reachability index of the edge label for the active snapshot,
+ * using the one kept in fn_extra if it is still good. If there is no usable
+ * projection, the index is built if build is true; otherwise, has_index of
+ * the result is false.
+ */
+static ReachCache *
+get_reach_cache(FunctionCallInfo fcinfo, Oid elabel, bool build)
+{
+	ReachCache *cache = (ReachCache *) fcinfo->flinfo->fn_extra;
+	Snapshot	snapshot = GetActiveSnapshot();
+
+	if (cache == NULL)
+	{
+		cache = MemoryContextAllocZero(fcinfo->flinfo->fn_mcxt,
+									   sizeof(ReachCache));
+		cache->mcxt = AllocSetContextCreate(fcinfo->flinfo->fn_mcxt,
+											"reachable() index",
+											ALLOCSET_DEFAULT_SIZES);
+		cache->elabel = InvalidOid;
+		fcinfo->flinfo->fn_extra = cache;
+	}
+
+	if (reach_cache_usable(cache, elabel, snapshot))
+		return cache;
+
+	/* this also releases the projection the old index was from */
+	MemoryContextReset(cache->mcxt);
+	cache->elabel = InvalidOid;
+
+	cache->has_index = GetGraphReachability(elabel, snapshot, cache->mcxt,
+											&cache->csr, &cache->reach);
+	if (!cache->has_index && build)
+	{
+		MemoryContext oldcxt = MemoryContextSwitchTo(cache->mcxt);
+		GraphCSRData *csrdata;
+
+		csrdata = graph_csr_build(elabel, NULL, InvalidOid, snapshot);
+		graph_csr_init(&cache->csr, csrdata);
+		graph_reach_init(&cache->reach, graph_reach_build(&cache->csr));
+		MemoryContextSwitchTo(oldcxt);
+		cache->has_index = true;
+	}
+	reach_cache_set_snapshot(cache, snapshot);
+	cache->elabel = elabel;
+
+	return cache;
+}
+
+/*
+ * Is the index of the cache for the edge label and the snapshot? Snapshots
+ * that see the same transactions and commands give the same index.
+ */
+static bool
+reach_cache_usable(ReachCache *cache, Oid elabel, Snapshot snapshot)
+{
+	if (cache->elabel != elabel)
+		return false;
+
+	return (TransactionIdEquals(cache->xmin, snapshot->xmin) &&
+			TransactionIdEquals(cache->xmax, snapshot->xmax) &&
+			cache->curcid == snapshot->curcid &&
+			cache->xcnt == snapshot->xcnt &&
+			memcmp(cache->xip, snapshot->xip,
+				   sizeof(TransactionId) * snapshot->xcnt) == 0 &&
+			cache->subxcnt == snapshot->subxcnt &&
+			cache->suboverflowed == snapshot->suboverflowed &&
+			memcmp(cache->subxip, snapshot->subxip,
+				   sizeof(TransactionId) * snapshot->subxcnt) == 0);
+}
+
+static void
+reach_cache_set_snapshot(ReachCache *cache, Snapshot snapshot)
+{
+	cache->xmin = snapshot->xmin;
+	cache->xmax = snapshot->xmax;
+	cache->curcid = snapshot->curcid;
+	cache->xcnt = snapshot->xcnt;
+	cache->xip = MemoryContextAlloc(cache->mcxt,
+									sizeof(TransactionId) *
+									Max(snapshot->xcnt, 1));
+	memcpy(cache->xip, snapshot->xip,
+		   sizeof(TransactionId) * snapshot->xcnt);
+	cache->subxcnt = snapshot->subxcnt;
+	cache->suboverflowed = snapshot->suboverflowed;
+	cache->subxip = MemoryContextAlloc(cache->mcxt,
+									   sizeof(TransactionId) *
+									   Max(snapshot->subxcnt, 1));
+	memcpy(cache->subxip, snapshot->subxip,
+		   sizeof(TransactionId) * snapshot->subxcnt);
+}
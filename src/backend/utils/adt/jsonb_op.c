@@ -13,10 +13,33 @@
  */
 #include "postgres.h"
 
+#include "access/hash.h"
+#include "catalog/pg_collation.h"
 #include "catalog/pg_type.h"
+#include "lib/hyperloglog.h"
 #include "miscadmin.h"
 #include "utils/builtins.h"
+#include "utils/guc.h"
 #include "utils/jsonb.h"
+#include "utils/pg_locale.h"
+#include "utils/sortsupport.h"
+
+/* sort support state for abbreviated keys */
+typedef struct
+{
+	char	   *buf;			/* buffer for short varlenas */
+	bool		c_collation;	/* the default collation is "C" */
+	int64		input_count;	/* number of non-null values seen */
+	bool		estimating;		/* true if estimating cardinality */
+	hyperLogLogState abbr_card; /* cardinality estimator */
+} JsonbSortSupport;
+
+static int	jsonb_fastcmp(Datum x, Datum y, SortSupport ssup);
+#if SIZEOF_DATUM == 8
+static Datum jsonb_abbrev_convert(Datum original_datum, SortSupport ssup);
+static bool jsonb_abbrev_abort(int memtupcount, SortSupport ssup);
+static int	jsonb_cmp_abbrev(Datum x, Datum y, SortSupport ssup);
+#endif
 
 Datum
 jsonb_exists(PG_FUNCTION_ARGS)
@@ -247,6 +270,163 @@ jsonb_cmp(PG_FUNCTION_ARGS)
 	PG_RETURN_INT32(res);
 }
 
+/*
+ * Sort support for the B-Tree operator class.
+ *
+ * Sorting by property values means sorting jsonb, so the values are
+ * abbreviated into 64-bit keys that order scalars of different types,
+ * numbers and, under the "C" collation, the first bytes of strings without
+ * looking at the values again; see getJsonbSortKey(). Abbreviation needs
+ * 64-bit Datums. It is aborted in the same way as that of numeric if the keys
+ * turn out to be mostly equal.
+ */
+Datum
+jsonb_sortsupport(PG_FUNCTION_ARGS)
+{
+	SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+
+	ssup->comparator = jsonb_fastcmp;
+
+#if SIZEOF_DATUM == 8
+	if (ssup->abbreviate)
+	{
+		JsonbSortSupport *jss;
+		MemoryContext oldcontext = MemoryContextSwitchTo(ssup->ssup_cxt);
+
+		jss = palloc(sizeof(JsonbSortSupport));
+		jss->buf = palloc(VARATT_SHORT_MAX + VARHDRSZ + 1);
+		jss->c_collation = lc_collate_is_c(DEFAULT_COLLATION_OID);
+		jss->input_count = 0;
+		jss->estimating = true;
+		initHyperLogLog(&jss->abbr_card, 10);
+
+		ssup->ssup_extra = jss;
+
+		ssup->abbrev_full_comparator = ssup->comparator;
+		ssup->comparator = jsonb_cmp_abbrev;
+		ssup->abbrev_converter = jsonb_abbrev_convert;
+		ssup->abbrev_abort = jsonb_abbrev_abort;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+#endif
+
+	PG_RETURN_VOID();
+}
+
+static int
+jsonb_fastcmp(Datum x, Datum y, SortSupport ssup)
+{
+	Jsonb	   *jba = DatumGetJsonbP(x);
+	Jsonb	   *jbb = DatumGetJsonbP(y);
+	int			res;
+
+	res = compareJsonbContainers(&jba->root, &jbb->root);
+
+	if ((Pointer) jba != DatumGetPointer(x))
+		pfree(jba);
+	if ((Pointer) jbb != DatumGetPointer(y))
+		pfree(jbb);
+
+	return res;
+}
+
+#if SIZEOF_DATUM == 8
+
+/*
+ * Abbreviate a jsonb datum (must not leak memory!)
+ */
+static Datum
+jsonb_abbrev_convert(Datum original_datum, SortSupport ssup)
+{
+	JsonbSortSupport *jss = ssup->ssup_extra;
+	void	   *original_varatt = PG_DETOAST_DATUM_PACKED(original_datum);
+	Jsonb	   *jb;
+	uint64		key;
+
+	jss->input_count += 1;
+
+	/* reuse a buffer to align short datums, as numeric_abbrev_convert() */
+	if (VARATT_IS_SHORT(original_varatt))
+	{
+		void	   *buf = jss->buf;
+		Size		sz = VARSIZE_SHORT(original_varatt) - VARHDRSZ_SHORT;
+
+		SET_VARSIZE(buf, VARHDRSZ + sz);
+		memcpy(VARDATA(buf), VARDATA_SHORT(original_varatt), sz);
+
+		jb = (Jsonb *) buf;
+	}
+	else
+	{
+		jb = (Jsonb *) original_varatt;
+	}
+
+	key = getJsonbSortKey(&jb->root, jss->c_collation);
+
+	if (jss->estimating)
+	{
+		uint32		tmp = ((uint32) key ^ (uint32) (key >> 32));
+
+		addHyperLogLog(&jss->abbr_card, DatumGetUInt32(hash_uint32(tmp)));
+	}
+
+	/* should happen only for external/compressed toasts */
+	if ((Pointer) original_varatt != DatumGetPointer(original_datum))
+		pfree(original_varatt);
+
+	return (Datum) key;
+}
+
+/*
+ * Consider whether to abort abbreviation, with the thresholds of
+ * numeric_abbrev_abort().
+ */
+static bool
+jsonb_abbrev_abort(int memtupcount, SortSupport ssup)
+{
+	JsonbSortSupport *jss = ssup->ssup_extra;
+	double		abbr_card;
+
+	if (memtupcount < 10000 || jss->input_count < 10000 || !jss->estimating)
+		return false;
+
+	abbr_card = estimateHyperLogLog(&jss->abbr_card);
+
+	if (abbr_card > 100000.0)
+	{
+		jss->estimating = false;
+		return false;
+	}
+
+	if (abbr_card < jss->input_count / 10000.0 + 0.5)
+	{
+#ifdef TRACE_SORT
+		if (trace_sort)
+			elog(LOG,
+				 "jsonb_abbrev: aborting abbreviation at cardinality %f"
+				 " below threshold %f after " INT64_FORMAT " values (%d rows)",
+				 abbr_card, jss->input_count / 10000.0 + 0.5,
+				 jss->input_count, memtupcount);
+#endif
+		return true;
+	}
+
+	return false;
+}
+
+static int
+jsonb_cmp_abbrev(Datum x, Datum y, SortSupport ssup)
+{
+	if ((uint64) x < (uint64) y)
+		return -1;
+	if ((uint64) x > (uint64) y)
+		return 1;
+	return 0;
+}
+
+#endif							/* SIZEOF_DATUM == 8 */
+
 /*
  * Hash operator class jsonb hashing function
  */
@@ -14,6 +14,7 @@
 #include "postgres.h"
 
 #include "access/hash.h"
+#include "access/tuptoaster.h"
 #include "catalog/pg_collation.h"
 #include "miscadmin.h"
 #include "utils/builtins.h"
@@ -33,6 +34,21 @@
 #define JSONB_MAX_ELEMS (Min(MaxAllocSize / sizeof(JsonbValue), JB_CMASK))
 #define JSONB_MAX_PAIRS (Min(MaxAllocSize / sizeof(JsonbPair), JB_CMASK))
 
+/*
+ * Classes of values in abbreviated sort keys, see getJsonbSortKey(). The
+ * class takes the top three bits of the key.
+ */
+#define JSONB_SORTKEY_EMPTY_ARRAY	0
+#define JSONB_SORTKEY_NULL			1
+#define JSONB_SORTKEY_STRING		2
+#define JSONB_SORTKEY_NUMERIC		3
+#define JSONB_SORTKEY_BOOL			4
+#define JSONB_SORTKEY_ARRAY			5
+#define JSONB_SORTKEY_OBJECT		6
+
+#define JSONB_SORTKEY(class, rest) \
+	(((uint64) (class) << 61) | ((uint64) (rest) & ((UINT64CONST(1) << 61) - 1)))
+
 static void fillJsonbValue(JsonbContainer *container, int index,
 			   char *base_addr, uint32 offset,
 			   JsonbValue *result);
@@ -112,6 +128,40 @@ JsonbValueToJsonb(JsonbValue *val)
 	return out;
 }
 
+/*
+ * Turn a Numeric into a scalar Jsonb.
+ *
+ * This is the same as JsonbValueToJsonb() on a jbvNumeric, but builds the
+ * raw scalar array directly instead of going through pushJsonbValue() and
+ * convertToJsonb(). It is for callers that produce a number per row, such as
+ * arithmetic operators of Cypher.
+ */
+Jsonb *
+NumericToJsonb(Numeric num)
+{
+	Size		numlen = VARSIZE_ANY(num);
+	Size		len;
+	Jsonb	   *out;
+
+	/* header and the only JEntry are int-aligned, so no padding is needed */
+	len = VARHDRSZ + sizeof(uint32) + sizeof(JEntry) + numlen;
+	if (numlen > JENTRY_OFFLENMASK)
+		ereport(ERROR,
+				(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+				 errmsg("total size of jsonb array elements exceeds the maximum of %u bytes",
+						JENTRY_OFFLENMASK)));
+
+	out = palloc(len);
+	SET_VARSIZE(out, len);
+	out->root.header = 1 | JB_FARRAY | JB_FSCALAR;
+
+	/* the first JEntry always has an offset, see convertJsonbArray() */
+	out->root.children[0] = JENTRY_ISNUMERIC | JENTRY_HAS_OFF | numlen;
+	memcpy(&out->root.children[1], num, numlen);
+
+	return out;
+}
+
 /*
  * Get the offset of the variable-length portion of a Jsonb node within
  * the variable-length-data part of its container.  The node is identified
@@ -181,6 +231,25 @@ compareJsonbContainers(JsonbContainer *a, JsonbContainer *b)
 			   *itb;
 	int			res = 0;
 
+	/*
+	 * Most property values are scalars. Compare two of them directly, in the
+	 * same way as the loop below would do, without setting up iterators.
+	 */
+	if (JsonContainerIsScalar(a) && JsonContainerIsScalar(b))
+	{
+		JsonbValue	va,
+					vb;
+
+		fillJsonbValue(a, 0, (char *) &a->children[1], 0, &va);
+		fillJsonbValue(b, 0, (char *) &b->children[1], 0, &vb);
+
+		if (va.type == vb.type)
+			return compareJsonbScalarValue(&va, &vb);
+
+		/* Type-defined order */
+		return (va.type > vb.type) ? 1 : -1;
+	}
+
 	ita = JsonbIteratorInit(a);
 	itb = JsonbIteratorInit(b);
 
@@ -297,6 +366,69 @@ compareJsonbContainers(JsonbContainer *a, JsonbContainer *b)
 	return res;
 }
 
+/*
+ * Compute the abbreviated sort key of a container.
+ *
+ * The top three bits of the key are the class of the value, in the order
+ * compareJsonbContainers() puts them: an empty array sorts before every
+ * scalar because it has fewer elements than a raw scalar pseudo array, and
+ * other arrays sort after them. The rest of the key orders values within a
+ * class. Values with equal keys need a full comparison, so parts of a value
+ * that do not fit are simply left out. Strings are ordered by their first
+ * bytes only if the default collation is "C" (c_collation); otherwise all
+ * strings get the same key.
+ */
+uint64
+getJsonbSortKey(JsonbContainer *jc, bool c_collation)
+{
+	uint32		count = JsonContainerSize(jc);
+	JsonbValue	v;
+
+	if (JsonContainerIsObject(jc))
+		return JSONB_SORTKEY(JSONB_SORTKEY_OBJECT, count);
+
+	if (!JsonContainerIsScalar(jc))
+	{
+		if (count == 0)
+			return JSONB_SORTKEY(JSONB_SORTKEY_EMPTY_ARRAY, 0);
+		return JSONB_SORTKEY(JSONB_SORTKEY_ARRAY, count);
+	}
+
+	fillJsonbValue(jc, 0, (char *) &jc->children[1], 0, &v);
+
+	switch (v.type)
+	{
+		case jbvNull:
+			return JSONB_SORTKEY(JSONB_SORTKEY_NULL, 0);
+		case jbvString:
+			{
+				uint64		prefix = 0;
+				int			i;
+
+				if (!c_collation)
+					return JSONB_SORTKEY(JSONB_SORTKEY_STRING, 0);
+
+				/* the first 7 bytes, padded with zeros */
+				for (i = 0; i < 7; i++)
+				{
+					prefix <<= 8;
+					if (i < v.val.string.len)
+						prefix |= (unsigned char) v.val.string.val[i];
+				}
+
+				return JSONB_SORTKEY(JSONB_SORTKEY_STRING, prefix << 5);
+			}
+		case jbvNumeric:
+			return JSONB_SORTKEY(JSONB_SORTKEY_NUMERIC,
+								 numeric_sort_key(v.val.numeric) >> 3);
+		case jbvBool:
+			return JSONB_SORTKEY(JSONB_SORTKEY_BOOL, v.val.boolean ? 1 : 0);
+		default:
+			elog(ERROR, "invalid jsonb scalar type");
+			return 0;			/* keep compiler quiet */
+	}
+}
+
 /*
  * Find value in object (i.e. the "value" part of some key/value pair in an
  * object), or find a matching element if we're looking through an array.  Do
@@ -410,6 +542,216 @@ findJsonbValueFromContainer(JsonbContainer *container, uint32 flags,
 	return NULL;
 }
 
+/*
+ * Find the index of key in the keys of a Jsonb object, trying the pair at hint
+ * first. Returns -1 if not found.
+ *
+ * Only the JEntries and the keys of the container are accessed.
+ */
+static int
+findJsonbObjectKeyIndex(JsonbContainer *container, JsonbValue *key, int hint)
+{
+	int			count = JsonContainerSize(container);
+	char	   *base_addr = (char *) (container->children + count * 2);
+	uint32		stopLow = 0,
+				stopHigh = count;
+
+	Assert(JsonContainerIsObject(container));
+	Assert(key->type == jbvString);
+
+	if (hint >= 0 && hint < count)
+	{
+		JsonbValue	candidate;
+
+		candidate.type = jbvString;
+		candidate.val.string.val = base_addr + getJsonbOffset(container, hint);
+		candidate.val.string.len = getJsonbLength(container, hint);
+
+		if (lengthCompareJsonbStringValue(&candidate, key) == 0)
+			return hint;
+	}
+
+	/* binary search on object/pair keys, see findJsonbValueFromContainer() */
+	while (stopLow < stopHigh)
+	{
+		uint32		stopMiddle;
+		int			difference;
+		JsonbValue	candidate;
+
+		stopMiddle = stopLow + (stopHigh - stopLow) / 2;
+
+		candidate.type = jbvString;
+		candidate.val.string.val =
+			base_addr + getJsonbOffset(container, stopMiddle);
+		candidate.val.string.len = getJsonbLength(container, stopMiddle);
+
+		difference = lengthCompareJsonbStringValue(&candidate, key);
+
+		if (difference == 0)
+			return stopMiddle;
+		else if (difference < 0)
+			stopLow = stopMiddle + 1;
+		else
+			stopHigh = stopMiddle;
+	}
+
+	return -1;
+}
+
+/*
+ * Find value by key in a Jsonb object, trying the pair at *hint first.
+ *
+ * Callers that look up the same key in many objects of the same shape (e.g.
+ * properties of vertices of a label) usually find the key at the same position
+ * and can skip the binary search. *hint is set to the position of the key if
+ * found; -1 means no hint. The value is returned in *result, which avoids a
+ * palloc() per lookup.
+ *
+ * Returns false if the key does not exist.
+ */
+bool
+findJsonbObjectValueWithHint(JsonbContainer *container, JsonbValue *key,
+							 int *hint, JsonbValue *result)
+{
+	int			count = JsonContainerSize(container);
+	int			i;
+	int			index;
+
+	if (count <= 0)
+		return false;
+
+	i = findJsonbObjectKeyIndex(container, key, *hint);
+	if (i < 0)
+		return false;
+
+	*hint = i;
+
+	index = i + count;
+	fillJsonbValue(container, index,
+				   (char *) (container->children + count * 2),
+				   getJsonbOffset(container, index), result);
+	return true;
+}
+
+/*
+ * Find value by key in a Jsonb object that is stored out of line without
+ * compression, fetching only the parts of it that are needed.
+ *
+ * Large objects (e.g. property maps holding documents) are stored this way if
+ * the column uses EXTERNAL storage. Reading the header, the JEntries and the
+ * keys of the object and then the value found is much cheaper than
+ * detoasting the whole datum when only one key is wanted.
+ *
+ * Returns false if attr is not such a datum or not an object; the caller must
+ * detoast it then. Otherwise, returns true and sets *result to the palloc'd
+ * value, or NULL if the key does not exist.
+ */
+bool
+findJsonbValueFromToast(struct varlena *attr, JsonbValue *key,
+						JsonbValue **result)
+{
+	struct varatt_external toast_pointer;
+	int32		datalen;
+	int32		prefixlen;
+	int32		needed;
+	struct varlena *prefix;
+	JsonbContainer *container;
+	int			count;
+	int			i;
+	int			index;
+	uint32		offset;
+	uint32		len;
+	char	   *base_addr;
+
+	if (!VARATT_IS_EXTERNAL_ONDISK(attr))
+		return false;
+
+	VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
+	if (VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer))
+		return false;
+
+	datalen = toast_pointer.va_extsize;
+
+	/* the first chunk usually has everything but the values */
+	prefixlen = Min(datalen, TOAST_MAX_CHUNK_SIZE);
+	prefix = heap_tuple_untoast_attr_slice(attr, 0, prefixlen);
+	container = (JsonbContainer *) VARDATA(prefix);
+
+	if (VARSIZE(prefix) - VARHDRSZ < sizeof(uint32) ||
+		!JsonContainerIsObject(container))
+	{
+		pfree(prefix);
+		return false;
+	}
+
+	count = JsonContainerSize(container);
+	if (count == 0)
+	{
+		pfree(prefix);
+		*result = NULL;
+		return true;
+	}
+
+	/* fetch all the JEntries first to know where the keys end */
+	needed = offsetof(JsonbContainer, children) + sizeof(JEntry) * count * 2;
+	if (needed > prefixlen)
+	{
+		pfree(prefix);
+		prefixlen = needed;
+		prefix = heap_tuple_untoast_attr_slice(attr, 0, prefixlen);
+		container = (JsonbContainer *) VARDATA(prefix);
+	}
+
+	/* keys are stored before all the values */
+	len = getJsonbOffset(container, count);
+	if (needed + len > prefixlen)
+	{
+		pfree(prefix);
+		prefixlen = needed + len;
+		prefix = heap_tuple_untoast_attr_slice(attr, 0, prefixlen);
+		container = (JsonbContainer *) VARDATA(prefix);
+	}
+
+	i = findJsonbObjectKeyIndex(container, key, -1);
+	if (i < 0)
+	{
+		pfree(prefix);
+		*result = NULL;
+		return true;
+	}
+
+	index = i + count;
+	offset = getJsonbOffset(container, index);
+	len = getJsonbLength(container, index);
+
+	/*
+	 * Fetch the value from the int-aligned offset before it so that
+	 * fillJsonbValue() can remove the alignment padding of the value as
+	 * usual.
+	 */
+	if (len > 0)
+	{
+		struct varlena *value;
+
+		value = heap_tuple_untoast_attr_slice(attr, needed + (offset & ~3),
+											  len + (offset & 3));
+		base_addr = VARDATA(value);
+		offset &= 3;
+	}
+	else
+	{
+		base_addr = "";
+		offset = 0;
+	}
+
+	*result = palloc(sizeof(JsonbValue));
+	fillJsonbValue(container, index, base_addr, offset, *result);
+
+	pfree(prefix);
+
+	return true;
+}
+
 /*
  * Get i-th value of a Jsonb array.
  *
@@ -708,6 +1050,58 @@ appendElement(JsonbParseState *pstate, JsonbValue *scalarVal)
 	array->val.array.elems[array->val.array.nElems++] = *scalarVal;
 }
 
+/*
+ * JsonbArrayIteratorInit
+ *		Set up `it` to walk the elements of an array container.
+ */
+void
+JsonbArrayIteratorInit(JsonbArrayIterator *it, JsonbContainer *container)
+{
+	Assert(JsonContainerIsArray(container));
+
+	it->container = container;
+	it->nElems = JsonContainerSize(container);
+	it->dataProper = (char *) &container->children[it->nElems];
+	it->nextIndex = 0;
+	it->nextDataOffset = 0;
+	it->nBatch = 0;
+	it->curBatch = 0;
+}
+
+/*
+ * JsonbArrayIteratorNext
+ *		Return the next element, or NULL if there are no more.
+ *
+ * The returned value is valid until the next JSONB_ARRAY_BATCH_SIZE calls.
+ */
+JsonbValue *
+JsonbArrayIteratorNext(JsonbArrayIterator *it)
+{
+	if (it->curBatch >= it->nBatch)
+	{
+		int			n = 0;
+
+		/* decode the next batch of elements */
+		while (n < JSONB_ARRAY_BATCH_SIZE && it->nextIndex < it->nElems)
+		{
+			fillJsonbValue(it->container, it->nextIndex, it->dataProper,
+						   it->nextDataOffset, &it->batch[n]);
+			JBE_ADVANCE_OFFSET(it->nextDataOffset,
+							   it->container->children[it->nextIndex]);
+			it->nextIndex++;
+			n++;
+		}
+
+		if (n == 0)
+			return NULL;
+
+		it->nBatch = n;
+		it->curBatch = 0;
+	}
+
+	return &it->batch[it->curBatch++];
+}
+
 /*
  * Given a JsonbContainer, expand to JsonbIterator to iterate over items
  * fully expanded to in-memory representation for manipulation.
@@ -1452,8 +1846,30 @@ convertToJsonb(JsonbValue *val)
 	/* Should not already have binary representation */
 	Assert(val->type != jbvBinary);
 
-	/* Allocate an output buffer. It will be enlarged as needed */
-	initStringInfo(&buffer);
+	/*
+	 * Allocate an output buffer. It will be enlarged as needed. A raw scalar
+	 * is usually much smaller than the default size of StringInfo, and
+	 * scalars are made for every element and property read by Cypher, so
+	 * allocate just about enough for it.
+	 */
+	if (val->type == jbvArray && val->val.array.rawScalar)
+	{
+		JsonbValue *scalar = &val->val.array.elems[0];
+		int			size = VARHDRSZ + sizeof(uint32) + sizeof(JEntry) + 1;
+
+		if (scalar->type == jbvString)
+			size += scalar->val.string.len;
+		else if (scalar->type == jbvNumeric)
+			size += VARSIZE_ANY(scalar->val.numeric) + sizeof(int32);
+
+		buffer.data = palloc(size);
+		buffer.maxlen = size;
+		resetStringInfo(&buffer);
+	}
+	else
+	{
+		initStringInfo(&buffer);
+	}
 
 	/* Make room for the varlena header */
 	reserveFromBuffer(&buffer, VARHDRSZ);
@@ -711,19 +711,42 @@ json_object_field(PG_FUNCTION_ARGS)
 		PG_RETURN_NULL();
 }
 
-Datum
-jsonb_object_field(PG_FUNCTION_ARGS)
+/*
+ * Find the value of the key (2nd argument) in the jsonb object (1st argument)
+ * for jsonb_object_field() and jsonb_object_field_text(). An out-of-line
+ * object is read partially if possible. Returns NULL if the jsonb is not an
+ * object or the key does not exist.
+ */
+static JsonbValue *
+jsonb_object_field_value(FunctionCallInfo fcinfo)
 {
-	Jsonb	   *jb = PG_GETARG_JSONB_P(0);
+	Datum		jbd = PG_GETARG_DATUM(0);
 	text	   *key = PG_GETARG_TEXT_PP(1);
+	Jsonb	   *jb;
+	JsonbValue	kjv;
 	JsonbValue *v;
 
+	kjv.type = jbvString;
+	kjv.val.string.val = VARDATA_ANY(key);
+	kjv.val.string.len = VARSIZE_ANY_EXHDR(key);
+
+	if (findJsonbValueFromToast((struct varlena *) DatumGetPointer(jbd),
+								&kjv, &v))
+		return v;
+
+	jb = DatumGetJsonbP(jbd);
 	if (!JB_ROOT_IS_OBJECT(jb))
-		PG_RETURN_NULL();
+		return NULL;
 
-	v = findJsonbValueFromContainerLen(&jb->root, JB_FOBJECT,
-									   VARDATA_ANY(key),
-									   VARSIZE_ANY_EXHDR(key));
+	return findJsonbValueFromContainer(&jb->root, JB_FOBJECT, &kjv);
+}
+
+Datum
+jsonb_object_field(PG_FUNCTION_ARGS)
+{
+	JsonbValue *v;
+
+	v = jsonb_object_field_value(fcinfo);
 
 	if (v != NULL)
 		PG_RETURN_JSONB_P(JsonbValueToJsonb(v));
@@ -750,16 +773,9 @@ json_object_field_text(PG_FUNCTION_ARGS)
 Datum
 jsonb_object_field_text(PG_FUNCTION_ARGS)
 {
-	Jsonb	   *jb = PG_GETARG_JSONB_P(0);
-	text	   *key = PG_GETARG_TEXT_PP(1);
 	JsonbValue *v;
 
-	if (!JB_ROOT_IS_OBJECT(jb))
-		PG_RETURN_NULL();
-
-	v = findJsonbValueFromContainerLen(&jb->root, JB_FOBJECT,
-									   VARDATA_ANY(key),
-									   VARSIZE_ANY_EXHDR(key));
+	v = jsonb_object_field_value(fcinfo);
 
 	if (v != NULL)
 	{
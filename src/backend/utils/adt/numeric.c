@@ -682,6 +682,143 @@ numeric_is_nan(Numeric num)
 	return NUMERIC_IS_NAN(num);
 }
 
+/*
+ * numeric_is_int64() -
+ *
+ *	If the value is an integer (with no fractional digits in its display
+ *	scale) that fits in int64, store it into *result and return true.
+ *	Otherwise, return false.
+ */
+bool
+numeric_is_int64(Numeric num, int64 *result)
+{
+	NumericDigit *digits;
+	int			ndigits;
+	int			weight;
+	int			i;
+	int64		val;
+
+	if (NUMERIC_IS_NAN(num) || NUMERIC_DSCALE(num) != 0)
+		return false;
+
+	ndigits = NUMERIC_NDIGITS(num);
+	if (ndigits == 0)
+	{
+		*result = 0;
+		return true;
+	}
+
+	weight = NUMERIC_WEIGHT(num);
+	if (weight < ndigits - 1)
+		return false;
+
+	/* accumulate the value as a negative number to handle INT64_MIN */
+	digits = NUMERIC_DIGITS(num);
+	val = 0;
+	for (i = 0; i <= weight; i++)
+	{
+		if (unlikely(pg_mul_s64_overflow(val, NBASE, &val)))
+			return false;
+		if (i < ndigits)
+		{
+			if (unlikely(pg_sub_s64_overflow(val, digits[i], &val)))
+				return false;
+		}
+	}
+
+	if (NUMERIC_SIGN(num) != NUMERIC_NEG)
+	{
+		if (unlikely(val == PG_INT64_MIN))
+			return false;
+		val = -val;
+	}
+
+	*result = val;
+	return true;
+}
+
+/*
+ * int64_to_numeric() -
+ *
+ *	Convert int64 to Numeric.
+ */
+Numeric
+int64_to_numeric(int64 val)
+{
+	Numeric		res;
+	NumericVar	result;
+
+	init_var(&result);
+
+	int64_to_numericvar(val, &result);
+
+	res = make_result(&result);
+
+	free_var(&result);
+
+	return res;
+}
+
+/*
+ * numeric_sort_key() -
+ *
+ *	Map a value to a key whose unsigned order agrees with the order of the
+ *	values, for abbreviated keys of types that contain numerics.  Different
+ *	values may get the same key, but the keys of two values never contradict
+ *	cmp_numerics().  The magnitude is packed the same way as the 63-bit
+ *	abbreviation of numeric_abbrev_convert_var().
+ */
+uint64
+numeric_sort_key(Numeric num)
+{
+	NumericDigit *digits;
+	int			ndigits;
+	int			weight;
+	uint64		mag;
+
+	/* NaN sorts above all non-NaN values, as in cmp_numerics() */
+	if (NUMERIC_IS_NAN(num))
+		return PG_UINT64_MAX;
+
+	ndigits = NUMERIC_NDIGITS(num);
+	weight = NUMERIC_WEIGHT(num);
+	digits = NUMERIC_DIGITS(num);
+
+	if (ndigits == 0 || weight < -44)
+	{
+		mag = 0;
+	}
+	else if (weight > 83)
+	{
+		mag = PG_INT64_MAX;
+	}
+	else
+	{
+		mag = ((uint64) (weight + 44) << 56);
+
+		switch (ndigits)
+		{
+			default:
+				mag |= ((uint64) digits[3]);
+				/* FALLTHROUGH */
+			case 3:
+				mag |= ((uint64) digits[2]) << 14;
+				/* FALLTHROUGH */
+			case 2:
+				mag |= ((uint64) digits[1]) << 28;
+				/* FALLTHROUGH */
+			case 1:
+				mag |= ((uint64) digits[0]) << 42;
+				break;
+		}
+	}
+
+	/* zero is in the middle of the key space */
+	if (NUMERIC_SIGN(num) == NUMERIC_NEG)
+		return (UINT64CONST(1) << 63) - mag;
+	return (UINT64CONST(1) << 63) + mag;
+}
+
 /*
  * numeric_maximum_size() -
  *
@@ -3132,18 +3269,8 @@ Datum
 int8_numeric(PG_FUNCTION_ARGS)
 {
 	int64		val = PG_GETARG_INT64(0);
-	Numeric		res;
-	NumericVar	result;
 
-	init_var(&result);
-
-	int64_to_numericvar(val, &result);
-
-	res = make_result(&result);
-
-	free_var(&result);
-
-	PG_RETURN_NUMERIC(res);
+	PG_RETURN_NUMERIC(int64_to_numeric(val));
 }
 
 
@@ -4922,7 +4922,12 @@ examine_variable(PlannerInfo *root, Node *node, int varRelid,
 					indexkey = (Node *) lfirst(indexpr_item);
 					if (indexkey && IsA(indexkey, RelabelType))
 						indexkey = (Node *) ((RelabelType *) indexkey)->arg;
-					if (equal(node, indexkey))
+					/*
+					 * A Cypher property access can use the statistics of
+					 * the same property taken with the jsonb -> operator.
+					 */
+					if (equal(node, indexkey) ||
+						cypher_access_matches_field_path(node, indexkey))
 					{
 						/*
 						 * Found a match ... is it a unique index? Tests here
@@ -0,0 +1,264 @@
+/*
+ * cypherplancache.c
+ *	  Backend-local cache of plans for Cypher statements.
+ *
+ * Short MATCH lookups spend more time in parse analysis of the Cypher
+ * clauses and planning than in execution. Clients that send them with the
+ * simple query protocol cannot use prepared statements, so this cache keeps
+ * a saved CachedPlanSource for each Cypher statement text and reuses its
+ * generic plan on the next execution of the same text. plancache.c takes
+ * care of invalidation and replanning when the labels or anything else the
+ * statement depends on change.
+ *
+ * The result of parse analysis of a Cypher statement depends on search_path,
+ * graph_path and a few GUC parameters. They are part of the key. A generic
+ * plan also depends on the planner parameters, which plancache.c does not
+ * track, so the whole cache is dropped when any of them may have changed
+ * (see PlannerGUCChangeCounter).
+ *
+ * The number of entries is limited by cypher_plan_cache_size. The least
+ * recently used entry is dropped when the cache is full.
+ *
+ * Copyright (c) 2016 by Bitnine Global, Inc.
+ *
+ * IDENTIFICATION
+ *	  src/backend/utils/cache/cypherplancache.c
+ */
+
+#include "postgres.h"
+
+#include "access/hash.h"
+#include "catalog/ag_graph_fn.h"
+#include "catalog/namespace.h"
+#include "lib/ilist.h"
+#include "nodes/parsenodes.h"
+#include "parser/parse_cypher_expr.h"
+#include "parser/parse_graph.h"
+#include "tcop/tcopprot.h"
+#include "utils/catcache.h"
+#include "utils/cypherplancache.h"
+#include "utils/guc.h"
+#include "utils/hashutils.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+
+typedef struct CypherPlanCacheKey
+{
+	const char *query;			/* text of the statement */
+	const char *search_path;
+	const char *graph_path;
+	bool		allow_null_properties;
+	bool		enable_eager;
+} CypherPlanCacheKey;
+
+typedef struct CypherPlanCacheEntry
+{
+	CypherPlanCacheKey key;		/* lookup key - must be first */
+	CachedPlanSource *plansource;
+	dlist_node	lru_node;		/* most recently used one is at the head */
+} CypherPlanCacheEntry;
+
+/* GUC parameter */
+int			cypher_plan_cache_size = 0;
+
+static HTAB *CypherPlanCacheHash = NULL;
+static dlist_head CypherPlanCacheLRU = DLIST_STATIC_INIT(CypherPlanCacheLRU);
+
+/* value of PlannerGUCChangeCounter when the cached plans were made */
+static uint64 CypherPlanCacheGUCCounter = 0;
+
+static void InitializeCypherPlanCache(void);
+static uint32 cypher_plan_cache_hash(const void *key, Size keysize);
+static int cypher_plan_cache_match(const void *key1, const void *key2,
+						Size keysize);
+static void RemoveCypherPlanCacheEntry(CypherPlanCacheEntry *entry);
+
+/*
+ * InitializeCypherPlanCache
+ *		Initialize the Cypher plan cache.
+ */
+static void
+InitializeCypherPlanCache(void)
+{
+	HASHCTL		ctl;
+
+	/* Make sure we've initialized CacheMemoryContext. */
+	if (!CacheMemoryContext)
+		CreateCacheMemoryContext();
+
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(CypherPlanCacheKey);
+	ctl.entrysize = sizeof(CypherPlanCacheEntry);
+	ctl.hash = cypher_plan_cache_hash;
+	ctl.match = cypher_plan_cache_match;
+	ctl.hcxt = CacheMemoryContext;
+	CypherPlanCacheHash = hash_create("Cypher plan cache", 64, &ctl,
+									  HASH_ELEM | HASH_FUNCTION |
+									  HASH_COMPARE | HASH_CONTEXT);
+}
+
+static uint32
+cypher_plan_cache_hash(const void *key, Size keysize)
+{
+	const CypherPlanCacheKey *k = (const CypherPlanCacheKey *) key;
+	uint32		hashkey;
+
+	hashkey = DatumGetUInt32(hash_any((const unsigned char *) k->query,
+									  strlen(k->query)));
+	hashkey = hash_combine(hashkey,
+						   string_hash(k->search_path,
+									   strlen(k->search_path) + 1));
+	hashkey = hash_combine(hashkey,
+						   string_hash(k->graph_path, NAMEDATALEN));
+	hashkey = hash_combine(hashkey, (k->allow_null_properties ? 1 : 0) |
+						   (k->enable_eager ? 2 : 0));
+
+	return hashkey;
+}
+
+static int
+cypher_plan_cache_match(const void *key1, const void *key2, Size keysize)
+{
+	const CypherPlanCacheKey *k1 = (const CypherPlanCacheKey *) key1;
+	const CypherPlanCacheKey *k2 = (const CypherPlanCacheKey *) key2;
+
+	if (k1->allow_null_properties != k2->allow_null_properties ||
+		k1->enable_eager != k2->enable_eager)
+		return 1;
+	if (strcmp(k1->graph_path, k2->graph_path) != 0)
+		return 1;
+	if (strcmp(k1->search_path, k2->search_path) != 0)
+		return 1;
+	return strcmp(k1->query, k2->query);
+}
+
+/*
+ * GetCypherPlanSource
+ *		Find or make the saved plan source of a Cypher statement.
+ *
+ * parsetree is one of the raw statements of query_string. If the cache has
+ * no entry for it, the statement is analyzed and rewritten here, so callers
+ * need a snapshot set if analyze_requires_snapshot() says so. The caller
+ * gets the plan with GetCachedPlan().
+ */
+CachedPlanSource *
+GetCypherPlanSource(RawStmt *parsetree, const char *query_string,
+					const char *commandTag)
+{
+	CypherPlanCacheKey key;
+	CypherPlanCacheEntry *entry;
+	CachedPlanSource *plansource;
+	List	   *querytree_list;
+	char	   *stmt_text;
+	bool		found;
+
+	Assert(IsA(parsetree->stmt, CypherStmt));
+	Assert(cypher_plan_cache_size > 0);
+
+	if (CypherPlanCacheHash == NULL)
+		InitializeCypherPlanCache();
+
+	/* the cached plans may have been made with other planner parameters */
+	if (CypherPlanCacheGUCCounter != PlannerGUCChangeCounter)
+	{
+		ResetCypherPlanCache();
+		CypherPlanCacheGUCCounter = PlannerGUCChangeCounter;
+	}
+
+	/* a query string may have many statements */
+	if (parsetree->stmt_len > 0)
+		stmt_text = pnstrdup(query_string + parsetree->stmt_location,
+							 parsetree->stmt_len);
+	else
+		stmt_text = pstrdup(query_string + parsetree->stmt_location);
+
+	key.query = stmt_text;
+	key.search_path = (namespace_search_path == NULL ?
+					   "" : namespace_search_path);
+	key.graph_path = (graph_path == NULL ? "" : graph_path);
+	key.allow_null_properties = allow_null_properties;
+	key.enable_eager = enable_eager;
+
+	entry = (CypherPlanCacheEntry *) hash_search(CypherPlanCacheHash,
+												 (void *) &key, HASH_FIND,
+												 NULL);
+	if (entry != NULL)
+	{
+		dlist_move_head(&CypherPlanCacheLRU, &entry->lru_node);
+		pfree(stmt_text);
+		return entry->plansource;
+	}
+
+	/*
+	 * Build the plan source in the current memory context first, so that it
+	 * goes away if parse analysis fails.
+	 */
+	plansource = CreateCachedPlan(parsetree, query_string, commandTag);
+	querytree_list = pg_analyze_and_rewrite(parsetree, query_string,
+											NULL, 0, NULL);
+	CompleteCachedPlan(plansource, querytree_list, NULL, NULL, 0, NULL, NULL,
+					   CURSOR_OPT_PARALLEL_OK, true);
+
+	/* make room for the new entry */
+	while (hash_get_num_entries(CypherPlanCacheHash) >= cypher_plan_cache_size)
+	{
+		dlist_node *node = dlist_tail_node(&CypherPlanCacheLRU);
+
+		RemoveCypherPlanCacheEntry(dlist_container(CypherPlanCacheEntry,
+												   lru_node, node));
+	}
+
+	/* copy the key before entering it so that we don't fail after that */
+	key.query = MemoryContextStrdup(CacheMemoryContext, stmt_text);
+	key.search_path = MemoryContextStrdup(CacheMemoryContext,
+										  key.search_path);
+	key.graph_path = MemoryContextStrdup(CacheMemoryContext, key.graph_path);
+	pfree(stmt_text);
+
+	SaveCachedPlan(plansource);
+
+	entry = (CypherPlanCacheEntry *) hash_search(CypherPlanCacheHash,
+												 (void *) &key, HASH_ENTER,
+												 &found);
+	Assert(!found);
+	entry->plansource = plansource;
+	dlist_push_head(&CypherPlanCacheLRU, &entry->lru_node);
+
+	return plansource;
+}
+
+/*
+ * ResetCypherPlanCache
+ *		Drop all cached Cypher plans.
+ */
+void
+ResetCypherPlanCache(void)
+{
+	dlist_mutable_iter iter;
+
+	if (CypherPlanCacheHash == NULL)
+		return;
+
+	dlist_foreach_modify(iter, &CypherPlanCacheLRU)
+	{
+		RemoveCypherPlanCacheEntry(dlist_container(CypherPlanCacheEntry,
+												   lru_node, iter.cur));
+	}
+}
+
+static void
+RemoveCypherPlanCacheEntry(CypherPlanCacheEntry *entry)
+{
+	CypherPlanCacheKey key = entry->key;
+
+	dlist_delete(&entry->lru_node);
+	DropCachedPlan(entry->plansource);
+
+	if (hash_search(CypherPlanCacheHash, (void *) &key, HASH_REMOVE,
+					NULL) == NULL)
+		elog(ERROR, "hash table corrupted");
+
+	pfree((char *) key.query);
+	pfree((char *) key.search_path);
+	pfree((char *) key.graph_path);
+}
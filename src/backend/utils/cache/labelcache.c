@@ -0,0 +1,250 @@
+/*
+ * labelcache.c
+ *	  Backend-local cache of label metadata.
+ *
+ * Output functions of graph types (vertex_out, edge_out, graphpath_out) and
+ * labels() need the name, the relation and the ancestors of the label of each
+ * element. Since a result set usually has elements of many labels, caching
+ * only the last label in fn_extra is not enough. This cache keeps them for
+ * all labels seen by the backend, keyed by (graph OID, label ID).
+ *
+ * Copyright (c) 2016 by Bitnine Global, Inc.
+ *
+ * IDENTIFICATION
+ *	  src/backend/utils/cache/labelcache.c
+ */
+
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "catalog/ag_label.h"
+#include "catalog/pg_inherits.h"
+#include "utils/builtins.h"
+#include "utils/catcache.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/labelcache.h"
+#include "utils/memutils.h"
+#include "utils/syscache.h"
+
+static HTAB *LabelCacheHash = NULL;
+
+static void InitializeLabelCache(void);
+static void InvalidateLabelCacheCallback(Datum arg, int cacheid,
+										 uint32 hashvalue);
+static void InvalidateLabelCacheRelCallback(Datum arg, Oid relid);
+static void ResetLabelCacheEntryLabels(LabelCacheEntry *entry);
+static void build_label_ancestors(Oid relid, List **ancestors, Jsonb **labels);
+
+/*
+ * InvalidateLabelCacheCallback
+ *		Flush all cache entries when ag_label is updated.
+ *
+ * Labels are renamed, created and dropped rarely, so flushing everything is
+ * good enough.
+ */
+static void
+InvalidateLabelCacheCallback(Datum arg, int cacheid, uint32 hashvalue)
+{
+	HASH_SEQ_STATUS status;
+	LabelCacheEntry *entry;
+
+	hash_seq_init(&status, LabelCacheHash);
+	while ((entry = (LabelCacheEntry *) hash_seq_search(&status)) != NULL)
+	{
+		ResetLabelCacheEntryLabels(entry);
+		if (hash_search(LabelCacheHash, (void *) &entry->key, HASH_REMOVE,
+						NULL) == NULL)
+			elog(ERROR, "hash table corrupted");
+	}
+}
+
+/*
+ * InvalidateLabelCacheRelCallback
+ *		Forget the ancestors of labels when their inheritance may be changed.
+ *
+ * ALTER VLABEL ... [NO] INHERIT updates inherited attributes of the child
+ * label, and it causes relcache invalidation of the child. Every entry that
+ * has the child as one of its ancestors (including itself) is affected.
+ */
+static void
+InvalidateLabelCacheRelCallback(Datum arg, Oid relid)
+{
+	HASH_SEQ_STATUS status;
+	LabelCacheEntry *entry;
+
+	hash_seq_init(&status, LabelCacheHash);
+	while ((entry = (LabelCacheEntry *) hash_seq_search(&status)) != NULL)
+	{
+		if (!OidIsValid(relid) || list_member_oid(entry->ancestors, relid))
+			ResetLabelCacheEntryLabels(entry);
+	}
+}
+
+static void
+ResetLabelCacheEntryLabels(LabelCacheEntry *entry)
+{
+	if (entry->ancestors != NIL)
+		list_free(entry->ancestors);
+	entry->ancestors = NIL;
+
+	if (entry->labels != NULL)
+		pfree(entry->labels);
+	entry->labels = NULL;
+}
+
+/*
+ * InitializeLabelCache
+ *		Initialize the label cache.
+ */
+static void
+InitializeLabelCache(void)
+{
+	HASHCTL		ctl;
+
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(LabelCacheKey);
+	ctl.entrysize = sizeof(LabelCacheEntry);
+	LabelCacheHash = hash_create("Label cache", 64, &ctl,
+								 HASH_ELEM | HASH_BLOBS);
+
+	/* Make sure we've initialized CacheMemoryContext. */
+	if (!CacheMemoryContext)
+		CreateCacheMemoryContext();
+
+	/* Watch for invalidation events. */
+	CacheRegisterSyscacheCallback(LABELLABID, InvalidateLabelCacheCallback,
+								  (Datum) 0);
+	CacheRegisterRelcacheCallback(InvalidateLabelCacheRelCallback, (Datum) 0);
+}
+
+/*
+ * LookupLabelCache
+ *		Fetch metadata of the label identified by (graphoid, labid).
+ *
+ * If need_labels is true, the entry also has labels() result of the label.
+ * Returns NULL if there is no such label.
+ */
+LabelCacheEntry *
+LookupLabelCache(Oid graphoid, uint16 labid, bool need_labels)
+{
+	LabelCacheKey key;
+	LabelCacheEntry *entry;
+	HeapTuple	tp;
+	NameData	labname;
+	Oid			relid;
+	List	   *ancestors = NIL;
+	Jsonb	   *labels = NULL;
+	bool		found;
+
+	if (LabelCacheHash == NULL)
+		InitializeLabelCache();
+
+	memset(&key, 0, sizeof(key));	/* make sure any padding bits are unset */
+	key.graphoid = graphoid;
+	key.labid = labid;
+
+	entry = (LabelCacheEntry *) hash_search(LabelCacheHash, (void *) &key,
+											HASH_FIND, NULL);
+	if (entry != NULL && (!need_labels || entry->labels != NULL))
+		return entry;
+
+	/*
+	 * Build the entry before adding it to the hash table because the catalog
+	 * access below may flush the cache.
+	 */
+	tp = SearchSysCache2(LABELLABID,
+						 ObjectIdGetDatum(graphoid),
+						 Int32GetDatum((int32) labid));
+	if (!HeapTupleIsValid(tp))
+		return NULL;
+
+	namecpy(&labname, &((Form_ag_label) GETSTRUCT(tp))->labname);
+	relid = ((Form_ag_label) GETSTRUCT(tp))->relid;
+	ReleaseSysCache(tp);
+
+	if (need_labels)
+		build_label_ancestors(relid, &ancestors, &labels);
+
+	entry = (LabelCacheEntry *) hash_search(LabelCacheHash, (void *) &key,
+											HASH_ENTER, &found);
+	if (!found)
+	{
+		entry->ancestors = NIL;
+		entry->labels = NULL;
+	}
+	else if (need_labels)
+	{
+		ResetLabelCacheEntryLabels(entry);
+	}
+
+	namecpy(&entry->labname, &labname);
+	entry->relid = relid;
+	if (need_labels)
+	{
+		entry->ancestors = ancestors;
+		entry->labels = labels;
+	}
+
+	return entry;
+}
+
+/* build the list of ancestors and labels() result in CacheMemoryContext */
+static void
+build_label_ancestors(Oid relid, List **ancestors, Jsonb **labels)
+{
+	List	   *ancestor_relids;
+	JsonbParseState *jpstate = NULL;
+	ListCell   *li;
+	JsonbValue *labels_jv;
+	Jsonb	   *labels_jb;
+	MemoryContext oldcontext;
+
+	ancestor_relids = find_all_ancestors(relid, AccessShareLock);
+
+	pushJsonbValue(&jpstate, WJB_BEGIN_ARRAY, NULL);
+
+	foreach(li, ancestor_relids)
+	{
+		Oid			ancestor_relid = lfirst_oid(li);
+		HeapTuple	tp;
+		char	   *ancestor_labname;
+
+		tp = SearchSysCache1(LABELRELID, ObjectIdGetDatum(ancestor_relid));
+		if (HeapTupleIsValid(tp))
+		{
+			Form_ag_label labtup = (Form_ag_label) GETSTRUCT(tp);
+
+			ancestor_labname = pstrdup(NameStr(labtup->labname));
+
+			ReleaseSysCache(tp);
+		}
+		else
+		{
+			elog(ERROR, "cache lookup failed for label %u", ancestor_relid);
+		}
+
+		if (strcmp(ancestor_labname, "ag_vertex") != 0)
+		{
+			JsonbValue	jv;
+
+			jv.type = jbvString;
+			jv.val.string.len = strlen(ancestor_labname);
+			jv.val.string.val = ancestor_labname;
+
+			pushJsonbValue(&jpstate, WJB_ELEM, &jv);
+		}
+	}
+
+	labels_jv = pushJsonbValue(&jpstate, WJB_END_ARRAY, NULL);
+	labels_jb = JsonbValueToJsonb(labels_jv);
+
+	oldcontext = MemoryContextSwitchTo(CacheMemoryContext);
+	*ancestors = list_copy(ancestor_relids);
+	*labels = (Jsonb *) palloc(VARSIZE(labels_jb));
+	memcpy(*labels, labels_jb, VARSIZE(labels_jb));
+	MemoryContextSwitchTo(oldcontext);
+
+	list_free(ancestor_relids);
+	pfree(labels_jb);
+}
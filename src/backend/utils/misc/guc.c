@@ -83,6 +83,8 @@
 #include "tsearch/ts_cache.h"
 #include "utils/builtins.h"
 #include "utils/bytea.h"
+#include "utils/cypherplancache.h"
+#include "utils/graphprojection.h"
 #include "utils/guc_tables.h"
 #include "utils/memutils.h"
 #include "utils/pg_locale.h"
@@ -2156,6 +2158,17 @@ static struct config_int ConfigureNamesInt[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"graph_projection_memory", PGC_SUSET, RESOURCES_MEM,
+			gettext_noop("Sets the maximum memory to be used by all graph projections."),
+			NULL,
+			GUC_UNIT_KB
+		},
+		&graph_projection_memory,
+		1048576, 0, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
 	/*
 	 * We use the hopefully-safely-small value of 100kB as the compiled-in
 	 * default for max_stack_depth.  InitializeGUCOptions will increase it if
@@ -3116,6 +3129,17 @@ static struct config_int ConfigureNamesInt[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"cypher_plan_cache_size", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets the maximum number of cached plans of Cypher statements."),
+			gettext_noop("Plans of Cypher statements sent as simple queries are "
+						 "reused for the same statement text. Zero disables the cache.")
+		},
+		&cypher_plan_cache_size,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, 0, 0, 0, NULL, NULL, NULL
@@ -4267,6 +4291,12 @@ static bool reporting_enabled;	/* true to enable GUC_REPORT */
 
 static int	GUCNestLevel = 0;	/* 1 when in main transaction */
 
+/*
+ * Incremented whenever a parameter that the planner reads may have changed,
+ * so that caches of generic plans can tell when theirs might be stale.
+ */
+uint64		PlannerGUCChangeCounter = 0;
+
 
 static int	guc_var_compare(const void *a, const void *b);
 static int	guc_name_compare(const char *namea, const char *nameb);
@@ -4274,6 +4304,7 @@ static void InitializeGUCOptionsFromEnvironment(void);
 static void InitializeOneGUCOption(struct config_generic *gconf);
 static void push_old_value(struct config_generic *gconf, GucAction action);
 static void ReportGUCOption(struct config_generic *record);
+static void NotePlannerGUCChange(struct config_generic *record);
 static void reapply_stacked_values(struct config_generic *variable,
 					   struct config_string *pHolder,
 					   GucStack *stack,
@@ -5270,6 +5301,7 @@ ResetAllOptions(void)
 		gconf->source = gconf->reset_source;
 		gconf->scontext = gconf->reset_scontext;
 
+		NotePlannerGUCChange(gconf);
 		if (gconf->flags & GUC_REPORT)
 			ReportGUCOption(gconf);
 	}
@@ -5657,6 +5689,8 @@ AtEOXact_GUC(bool isCommit, int nestLevel)
 			pfree(stack);
 
 			/* Report new value if we changed it */
+			if (changed)
+				NotePlannerGUCChange(gconf);
 			if (changed && (gconf->flags & GUC_REPORT))
 				ReportGUCOption(gconf);
 		}						/* end of stack-popping loop */
@@ -5702,6 +5736,28 @@ BeginReportingGUCOptions(void)
 	}
 }
 
+/*
+ * NotePlannerGUCChange: advance PlannerGUCChangeCounter if the option is one
+ * that affects planning
+ */
+static void
+NotePlannerGUCChange(struct config_generic *record)
+{
+	switch (record->group)
+	{
+		case QUERY_TUNING:
+		case QUERY_TUNING_METHOD:
+		case QUERY_TUNING_COST:
+		case QUERY_TUNING_GEQO:
+		case QUERY_TUNING_OTHER:
+		case RESOURCES_MEM:
+			PlannerGUCChangeCounter++;
+			break;
+		default:
+			break;
+	}
+}
+
 /*
  * ReportGUCOption: if appropriate, transmit option value to frontend
  */
@@ -6978,6 +7034,8 @@ set_config_option(const char *name, const char *value,
 			}
 	}
 
+	if (changeVal)
+		NotePlannerGUCChange(record);
 	if (changeVal && (record->flags & GUC_REPORT))
 		ReportGUCOption(record);
 
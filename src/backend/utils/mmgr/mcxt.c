@@ -462,6 +462,35 @@ MemoryContextIsEmpty(MemoryContext context)
 	return context->methods->is_empty(context);
 }
 
+/*
+ * MemoryContextMemAllocated
+ *		Total space allocated for a memory context, and optionally its
+ *		descendants, from malloc.
+ */
+Size
+MemoryContextMemAllocated(MemoryContext context, bool recurse)
+{
+	MemoryContextCounters totals;
+	MemoryContext child;
+	Size		total;
+
+	AssertArg(MemoryContextIsValid(context));
+
+	memset(&totals, 0, sizeof(totals));
+	context->methods->stats(context, NULL, NULL, &totals);
+	total = totals.totalspace;
+
+	if (recurse)
+	{
+		for (child = context->firstchild;
+			 child != NULL;
+			 child = child->nextchild)
+			total += MemoryContextMemAllocated(child, true);
+	}
+
+	return total;
+}
+
 /*
  * MemoryContextStats
  *		Print statistics about the named context and all its descendants.
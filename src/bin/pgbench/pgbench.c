@@ -168,6 +168,15 @@ int64		random_seed = -1;
 #define ntellers	10
 #define naccounts	100000
 
+/*
+ * Size of the social network generated by the "G" initialization step, per
+ * scale unit.  nfriends, nposts and nlikes are averages per person.
+ */
+#define npersons	1000
+#define nfriends	10
+#define nposts		10
+#define nlikes		10
+
 /*
  * The scale factor at/beyond which 32bit integers are incapable of storing
  * 64bit values.
@@ -182,6 +191,7 @@ bool		use_quiet;			/* quiet logging onto stderr */
 int			agg_interval;		/* log aggregates instead of individual
 								 * transactions */
 bool		per_script_stats = false;	/* whether to collect stats per script */
+bool		latency_percentiles = false;	/* report latency percentiles */
 int			progress = 0;		/* thread progress report every this seconds */
 bool		progress_timestamp = false; /* progress report with Unix time */
 int			nclients = 1;		/* number of clients */
@@ -236,6 +246,23 @@ typedef struct SimpleStats
 	double		sum2;			/* sum of squared values */
 } SimpleStats;
 
+/*
+ * Latency histogram of a script, for --latency-percentiles.
+ *
+ * Latencies are counted in microseconds.  Below 2 * LATENCY_HIST_SUB each
+ * value has its own bucket; above, every power of two is split into
+ * LATENCY_HIST_SUB buckets, so that the relative error of a percentile is
+ * below 1 / LATENCY_HIST_SUB whatever the latency.
+ */
+#define LATENCY_HIST_SUB_BITS	4
+#define LATENCY_HIST_SUB		(1 << LATENCY_HIST_SUB_BITS)
+#define LATENCY_HIST_BUCKETS	((64 - LATENCY_HIST_SUB_BITS + 1) * LATENCY_HIST_SUB)
+
+typedef struct LatencyHistogram
+{
+	int64		counts[LATENCY_HIST_BUCKETS];
+} LatencyHistogram;
+
 /*
  * Data structure to hold various statistics: per-thread and per-script stats
  * are maintained and merged together.
@@ -457,6 +484,7 @@ typedef struct ParsedScript
 	int			weight;			/* selection weight */
 	Command   **commands;		/* NULL-terminated array of Commands */
 	StatsData	stats;			/* total time spent in script */
+	LatencyHistogram *histogram;	/* latencies, if latency_percentiles */
 } ParsedScript;
 
 static ParsedScript sql_script[MAX_SCRIPTS];	/* SQL script files */
@@ -472,6 +500,7 @@ typedef struct BuiltinScript
 	const char *name;			/* very short name for -b ... */
 	const char *desc;			/* short description */
 	const char *script;			/* actual pgbench script */
+	bool		graph;			/* runs against the "G" graph? */
 } BuiltinScript;
 
 static const BuiltinScript builtin_script[] =
@@ -489,7 +518,8 @@ static const BuiltinScript builtin_script[] =
 		"UPDATE pgbench_tellers SET tbalance = tbalance + :delta WHERE tid = :tid;\n"
 		"UPDATE pgbench_branches SET bbalance = bbalance + :delta WHERE bid = :bid;\n"
 		"INSERT INTO pgbench_history (tid, bid, aid, delta, mtime) VALUES (:tid, :bid, :aid, :delta, CURRENT_TIMESTAMP);\n"
-		"END;\n"
+		"END;\n",
+		false
 	},
 	{
 		"simple-update",
@@ -502,13 +532,59 @@ static const BuiltinScript builtin_script[] =
 		"UPDATE pgbench_accounts SET abalance = abalance + :delta WHERE aid = :aid;\n"
 		"SELECT abalance FROM pgbench_accounts WHERE aid = :aid;\n"
 		"INSERT INTO pgbench_history (tid, bid, aid, delta, mtime) VALUES (:tid, :bid, :aid, :delta, CURRENT_TIMESTAMP);\n"
-		"END;\n"
+		"END;\n",
+		false
 	},
 	{
 		"select-only",
 		"<builtin: select only>",
 		"\\set aid random(1, " CppAsString2(naccounts) " * :scale)\n"
-		"SELECT abalance FROM pgbench_accounts WHERE aid = :aid;\n"
+		"SELECT abalance FROM pgbench_accounts WHERE aid = :aid;\n",
+		false
+	},
+	{
+		"snb-short-read",
+		"<builtin: social network short reads>",
+		"\\set pid random(1, " CppAsString2(npersons) " * :scale)\n"
+		"SET graph_path = pgbench_graph;\n"
+		"MATCH (p:person {id: :pid}) RETURN p.firstname, p.lastname, p.birthday, p.creationdate;\n"
+		"MATCH (p:person {id: :pid})<-[:has_creator]-(m:post) RETURN m.id, m.content, m.creationdate ORDER BY m.creationdate DESC LIMIT 10;\n"
+		"MATCH (p:person {id: :pid})-[:knows]-(f:person) RETURN f.id, f.firstname, f.lastname;\n",
+		true
+	},
+	{
+		"snb-khop",
+		"<builtin: social network k-hop neighborhood>",
+		"\\set pid random(1, " CppAsString2(npersons) " * :scale)\n"
+		"SET graph_path = pgbench_graph;\n"
+		"MATCH (p:person {id: :pid})-[:knows*1..2]-(f:person) WHERE id(f) <> id(p) RETURN count(DISTINCT id(f));\n"
+		"MATCH (p:person {id: :pid})-[:knows]-(f:person)<-[:has_creator]-(m:post) RETURN f.id, m.id, m.creationdate ORDER BY m.creationdate DESC LIMIT 20;\n",
+		true
+	},
+	{
+		"snb-shortestpath",
+		"<builtin: social network shortest path>",
+		"\\set pid1 random(1, " CppAsString2(npersons) " * :scale)\n"
+		"\\set pid2 random(1, " CppAsString2(npersons) " * :scale)\n"
+		"SET graph_path = pgbench_graph;\n"
+		"MATCH (a:person {id: :pid1}), (b:person {id: :pid2}) RETURN length(shortestpath((a)-[:knows*]-(b)));\n",
+		true
+	},
+	{
+		"snb-update",
+		"<builtin: social network updates>",
+		"\\set pid1 random(1, " CppAsString2(npersons) " * :scale)\n"
+		"\\set pid2 random(1, " CppAsString2(npersons) " * :scale)\n"
+		"\\set postid random(1, " CppAsString2(nposts) " * " CppAsString2(npersons) " * :scale)\n"
+		"\\set newpost random(1, " CppAsString2(nposts) " * " CppAsString2(npersons) " * :scale) + " CppAsString2(nposts) " * " CppAsString2(npersons) " * :scale\n"
+		"\\set newdate random(1577836800, 1609459199)\n"
+		"SET graph_path = pgbench_graph;\n"
+		"BEGIN;\n"
+		"MATCH (a:person {id: :pid1}), (b:person {id: :pid2}) MERGE (a)-[:knows]->(b);\n"
+		"MATCH (a:person {id: :pid1}), (m:post {id: :postid}) MERGE (a)-[:likes]->(m);\n"
+		"MATCH (a:person {id: :pid2}) MERGE (m:post {id: :newpost}) ON CREATE SET m.content = 'new post', m.creationdate = :newdate MERGE (m)-[:has_creator]->(a);\n"
+		"END;\n",
+		true
 	}
 };
 
@@ -545,7 +621,7 @@ usage(void)
 		   "  %s [OPTION]... [DBNAME]\n"
 		   "\nInitialization options:\n"
 		   "  -i, --initialize         invokes initialization mode\n"
-		   "  -I, --init-steps=[dtgvpf]+ (default \"dtgvp\")\n"
+		   "  -I, --init-steps=[dtgvpfG]+ (default \"dtgvp\")\n"
 		   "                           run selected initialization steps\n"
 		   "  -F, --fillfactor=NUM     set fill factor\n"
 		   "  -n, --no-vacuum          do not run VACUUM during initialization\n"
@@ -583,6 +659,7 @@ usage(void)
 		   "  -T, --time=NUM           duration of benchmark test in seconds\n"
 		   "  -v, --vacuum-all         vacuum all four standard tables before tests\n"
 		   "  --aggregate-interval=NUM aggregate data over NUM seconds\n"
+		   "  --latency-percentiles    report latency percentiles per script\n"
 		   "  --log-prefix=PREFIX      prefix for transaction time log file\n"
 		   "                           (default: \"pgbench_log\")\n"
 		   "  --progress-timestamp     use Unix epoch timestamps for progress\n"
@@ -1049,6 +1126,43 @@ initStats(StatsData *sd, time_t start_time)
 	initSimpleStats(&sd->lag);
 }
 
+/*
+ * Return the bucket of a latency histogram that counts the given latency.
+ */
+static int
+latencyHistBucket(double latency)
+{
+	uint64		v = (latency > 0.0) ? (uint64) latency : 0;
+	int			shift = 0;
+
+	/* keep the LATENCY_HIST_SUB_BITS + 1 highest bits */
+	while (v >= 2 * LATENCY_HIST_SUB)
+	{
+		v >>= 1;
+		shift++;
+	}
+
+	return shift * LATENCY_HIST_SUB + (int) v;
+}
+
+/*
+ * Return the middle of the latency range counted by a histogram bucket.
+ */
+static double
+latencyHistValue(int bucket)
+{
+	int			shift = 0;
+	uint64		v = bucket;
+
+	if (bucket >= 2 * LATENCY_HIST_SUB)
+	{
+		shift = bucket / LATENCY_HIST_SUB - 1;
+		v = bucket - shift * LATENCY_HIST_SUB;
+	}
+
+	return (double) (v << shift) + ((double) ((uint64) 1 << shift) - 1.0) / 2.0;
+}
+
 /*
  * Accumulate one additional item into the given stats object.
  */
@@ -3457,6 +3571,8 @@ processXactStats(TState *thread, CState *st, instr_time *now,
 	/* XXX could use a mutex here, but we choose not to */
 	if (per_script_stats)
 		accumStats(&sql_script[st->use_file].stats, skipped, latency, lag);
+	if (latency_percentiles && !skipped)
+		sql_script[st->use_file].histogram->counts[latencyHistBucket(latency)]++;
 }
 
 
@@ -3794,6 +3910,128 @@ initCreateFKeys(PGconn *con)
 	}
 }
 
+/*
+ * Generate the social network graph used by the snb-* builtin scripts
+ *
+ * The graph "pgbench_graph" is made of persons who know each other, and of
+ * posts which persons have created and like, much like the LDBC Social
+ * Network Benchmark.  Every person knows nfriends others and likes nlikes
+ * posts.  The persons who are known and the creators and posts that are liked
+ * follow power laws, so that some of them become hubs.  The data is generated
+ * on the server side with deterministic hash functions, so that the same
+ * scale always gives the same graph.
+ */
+static void
+initGenerateGraph(PGconn *con)
+{
+	static const char *const DDLs[] = {
+		"drop graph if exists pgbench_graph cascade",
+		"create graph pgbench_graph",
+		"set graph_path = pgbench_graph",
+		"create vlabel person",
+		"create vlabel post",
+		"create elabel knows",
+		"create elabel likes",
+		"create elabel has_creator"
+	};
+	/* uniform random number in [0, 1) derived from an int8 */
+#define GRAPH_UNIT(x) "((hashint8(" x ") & 2147483647) / 2147483648.0)"
+	char		sql[1024];
+	int64		persons = (int64) npersons * scale;
+	int64		posts = (int64) nposts * persons;
+	int			i;
+
+	fprintf(stderr, "generating graph...\n");
+
+	for (i = 0; i < lengthof(DDLs); i++)
+		executeStatement(con, DDLs[i]);
+
+	executeStatement(con, "begin");
+
+	snprintf(sql, sizeof(sql),
+			 "insert into pgbench_graph.person (properties) "
+			 "select jsonb_build_object("
+			 "'id', i, "
+			 "'firstname', 'first' || i %% 997, "
+			 "'lastname', 'last' || i %% 2999, "
+			 "'gender', case when i %% 2 = 0 then 'female' else 'male' end, "
+			 "'birthday', to_char(date '1960-01-01' + (i * 7919 %% 14600)::int, 'YYYY-MM-DD'), "
+			 "'creationdate', 1262304000 + i * 104729 %% 283996800) "
+			 "from generate_series(1::int8, " INT64_FORMAT ") i",
+			 persons);
+	executeStatement(con, sql);
+
+	snprintf(sql, sizeof(sql),
+			 "insert into pgbench_graph.post (properties) "
+			 "select jsonb_build_object("
+			 "'id', i, "
+			 "'content', 'post ' || i, "
+			 "'length', 10 + i %% 190, "
+			 "'creationdate', 1262304000 + i * 104729 %% 283996800) "
+			 "from generate_series(1::int8, " INT64_FORMAT ") i",
+			 posts);
+	executeStatement(con, sql);
+
+	/* map the ids of the vertices to their graphids to create edges */
+	executeStatement(con,
+					 "create temp table pgbench_graph_person_ids on commit drop as "
+					 "select (properties->>'id')::int8 as id, id as vid "
+					 "from pgbench_graph.person");
+	executeStatement(con,
+					 "create temp table pgbench_graph_post_ids on commit drop as "
+					 "select (properties->>'id')::int8 as id, id as vid "
+					 "from pgbench_graph.post");
+	executeStatement(con, "analyze pgbench_graph_person_ids");
+	executeStatement(con, "analyze pgbench_graph_post_ids");
+
+	fprintf(stderr, "generating edges...\n");
+
+	snprintf(sql, sizeof(sql),
+			 "insert into pgbench_graph.has_creator (start, \"end\", properties) "
+			 "select m.vid, p.vid, '{}' "
+			 "from pgbench_graph_post_ids m join pgbench_graph_person_ids p "
+			 "on p.id = 1 + floor(" INT64_FORMAT " * power(" GRAPH_UNIT("m.id") ", 2))::int8",
+			 persons);
+	executeStatement(con, sql);
+
+	snprintf(sql, sizeof(sql),
+			 "insert into pgbench_graph.knows (start, \"end\", properties) "
+			 "select a.vid, b.vid, '{}' "
+			 "from (select distinct 1 + (k - 1) / %d as src, "
+			 "1 + floor(" INT64_FORMAT " * power(" GRAPH_UNIT("k") ", 3))::int8 as dst "
+			 "from generate_series(1::int8, " INT64_FORMAT ") k) e "
+			 "join pgbench_graph_person_ids a on a.id = e.src "
+			 "join pgbench_graph_person_ids b on b.id = e.dst "
+			 "where e.src <> e.dst",
+			 nfriends, persons, (int64) nfriends * persons);
+	executeStatement(con, sql);
+
+	snprintf(sql, sizeof(sql),
+			 "insert into pgbench_graph.likes (start, \"end\", properties) "
+			 "select a.vid, m.vid, '{}' "
+			 "from (select distinct 1 + (k - 1) / %d as src, "
+			 "1 + floor(" INT64_FORMAT " * power(" GRAPH_UNIT("-k") ", 2))::int8 as dst "
+			 "from generate_series(1::int8, " INT64_FORMAT ") k) e "
+			 "join pgbench_graph_person_ids a on a.id = e.src "
+			 "join pgbench_graph_post_ids m on m.id = e.dst",
+			 nlikes, posts, (int64) nlikes * persons);
+	executeStatement(con, sql);
+
+	executeStatement(con, "commit");
+#undef GRAPH_UNIT
+
+	fprintf(stderr, "creating property indexes...\n");
+	executeStatement(con, "create property index on person (id)");
+	executeStatement(con, "create property index on post (id)");
+
+	fprintf(stderr, "vacuuming graph...\n");
+	executeStatement(con, "vacuum analyze pgbench_graph.person");
+	executeStatement(con, "vacuum analyze pgbench_graph.post");
+	executeStatement(con, "vacuum analyze pgbench_graph.knows");
+	executeStatement(con, "vacuum analyze pgbench_graph.likes");
+	executeStatement(con, "vacuum analyze pgbench_graph.has_creator");
+}
+
 /*
  * Validate an initialization-steps string
  *
@@ -3814,11 +4052,11 @@ checkInitSteps(const char *initialize_steps)
 
 	for (step = initialize_steps; *step != '\0'; step++)
 	{
-		if (strchr("dtgvpf ", *step) == NULL)
+		if (strchr("dtgvpfG ", *step) == NULL)
 		{
 			fprintf(stderr, "unrecognized initialization step \"%c\"\n",
 					*step);
-			fprintf(stderr, "allowed steps are: \"d\", \"t\", \"g\", \"v\", \"p\", \"f\"\n");
+			fprintf(stderr, "allowed steps are: \"d\", \"t\", \"g\", \"v\", \"p\", \"f\", \"G\"\n");
 			exit(1);
 		}
 	}
@@ -3858,6 +4096,9 @@ runInitSteps(const char *initialize_steps)
 			case 'f':
 				initCreateFKeys(con);
 				break;
+			case 'G':
+				initGenerateGraph(con);
+				break;
 			case ' ':
 				break;			/* ignore */
 			default:
@@ -4583,6 +4824,34 @@ printSimpleStats(const char *prefix, SimpleStats *ss)
 	}
 }
 
+/* print out percentiles of a latency histogram */
+static void
+printPercentiles(const char *prefix, LatencyHistogram *hist)
+{
+	static const double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+	int64		total = 0;
+	int64		seen = 0;
+	int			bucket = 0;
+	int			i;
+
+	for (i = 0; i < LATENCY_HIST_BUCKETS; i++)
+		total += hist->counts[i];
+	if (total == 0)
+		return;
+
+	for (i = 0; i < lengthof(percentiles); i++)
+	{
+		int64		rank = (int64) ceil(total * percentiles[i] / 100.0);
+
+		while (bucket < LATENCY_HIST_BUCKETS - 1 &&
+			   seen + hist->counts[bucket] < rank)
+			seen += hist->counts[bucket++];
+
+		printf("%s %g%% = %.3f ms\n", prefix, percentiles[i],
+			   0.001 * latencyHistValue(bucket));
+	}
+}
+
 /* print out results */
 static void
 printResults(TState *threads, StatsData *total, instr_time total_time,
@@ -4696,6 +4965,8 @@ printResults(TState *threads, StatsData *total, instr_time total_time,
 						   100.0 * sstats->skipped / sstats->cnt);
 
 				printSimpleStats(" - latency", &sstats->latency);
+				if (latency_percentiles)
+					printPercentiles(" - latency", sql_script[i].histogram);
 			}
 
 			/* Report per-command latencies */
@@ -4826,6 +5097,7 @@ main(int argc, char **argv)
 		{"log-prefix", required_argument, NULL, 7},
 		{"foreign-keys", no_argument, NULL, 8},
 		{"random-seed", required_argument, NULL, 9},
+		{"latency-percentiles", no_argument, NULL, 10},
 		{NULL, 0, NULL, 0}
 	};
 
@@ -4841,6 +5113,7 @@ main(int argc, char **argv)
 	bool		benchmarking_option_set = false;
 	bool		initialization_option_set = false;
 	bool		internal_script_used = false;
+	bool		graph_script_used = false;
 
 	CState	   *state;			/* status of clients */
 	TState	   *threads;		/* array of thread */
@@ -5031,10 +5304,18 @@ main(int argc, char **argv)
 					listAvailableScripts();
 					exit(0);
 				}
-				weight = parseScriptWeight(optarg, &script);
-				process_builtin(findBuiltin(script), weight);
-				benchmarking_option_set = true;
-				internal_script_used = true;
+				{
+					const BuiltinScript *bi;
+
+					weight = parseScriptWeight(optarg, &script);
+					bi = findBuiltin(script);
+					process_builtin(bi, weight);
+					benchmarking_option_set = true;
+					if (bi->graph)
+						graph_script_used = true;
+					else
+						internal_script_used = true;
+				}
 				break;
 			case 'S':
 				process_builtin(findBuiltin("select-only"), 1);
@@ -5181,6 +5462,11 @@ main(int argc, char **argv)
 					exit(1);
 				}
 				break;
+			case 10:			/* latency-percentiles */
+				benchmarking_option_set = true;
+				per_script_stats = true;
+				latency_percentiles = true;
+				break;
 			default:
 				fprintf(stderr, _("Try \"%s --help\" for more information.\n"), progname);
 				exit(1);
@@ -5196,6 +5482,16 @@ main(int argc, char **argv)
 		internal_script_used = true;
 	}
 
+	/*
+	 * Cypher labels look like variables to parseQuery(), so the graph scripts
+	 * can only be sent as they are.
+	 */
+	if (graph_script_used && querymode != QUERY_SIMPLE)
+	{
+		fprintf(stderr, "builtin graph scripts require simple query mode (-M simple)\n");
+		exit(1);
+	}
+
 	/* if not simple query mode, parse the script(s) to find parameters */
 	if (querymode != QUERY_SIMPLE)
 	{
@@ -5229,6 +5525,12 @@ main(int argc, char **argv)
 	if (num_scripts > 1)
 		per_script_stats = true;
 
+	if (latency_percentiles)
+	{
+		for (i = 0; i < num_scripts; i++)
+			sql_script[i].histogram = pg_malloc0(sizeof(LatencyHistogram));
+	}
+
 	/*
 	 * Don't need more threads than there are clients.  (This is not merely an
 	 * optimization; throttle_delay is calculated incorrectly below if some
@@ -5443,6 +5745,55 @@ main(int argc, char **argv)
 					scale);
 	}
 
+	if (graph_script_used)
+	{
+		int			graph_scale;
+
+		/* likewise, from the number of persons in pgbench_graph */
+		res = PQexec(con, "select count(*) from pgbench_graph.person");
+		if (PQresultStatus(res) != PGRES_TUPLES_OK)
+		{
+			char	   *sqlState = PQresultErrorField(res, PG_DIAG_SQLSTATE);
+
+			fprintf(stderr, "%s", PQerrorMessage(con));
+			if (sqlState && strcmp(sqlState, ERRCODE_UNDEFINED_TABLE) == 0)
+			{
+				fprintf(stderr, "Perhaps you need to do graph initialization (\"pgbench -i -I G\") in database \"%s\"\n", PQdb(con));
+			}
+
+			exit(1);
+		}
+		graph_scale = atoi(PQgetvalue(res, 0, 0)) / npersons;
+		if (graph_scale <= 0)
+		{
+			fprintf(stderr, "invalid count(*) from pgbench_graph.person: \"%s\"\n",
+					PQgetvalue(res, 0, 0));
+			exit(1);
+		}
+		PQclear(res);
+
+		if (internal_script_used)
+		{
+			/* all the builtin scripts share :scale */
+			if (graph_scale != scale)
+			{
+				fprintf(stderr,
+						"scale of pgbench_graph (%d) does not match scale of pgbench_branches (%d)\n",
+						graph_scale, scale);
+				fprintf(stderr, "Perhaps you need to initialize both with the same scale factor.\n");
+				exit(1);
+			}
+		}
+		else
+		{
+			scale = graph_scale;
+			if (scale_given)
+				fprintf(stderr,
+						"scale option ignored, using count from pgbench_graph.person (%d)\n",
+						scale);
+		}
+	}
+
 	/*
 	 * :scale variables normally get -s or database scale, but don't override
 	 * an explicit -D switch
@@ -5489,16 +5840,31 @@ main(int argc, char **argv)
 
 	if (!is_no_vacuum)
 	{
-		fprintf(stderr, "starting vacuum...");
-		tryExecuteStatement(con, "vacuum pgbench_branches");
-		tryExecuteStatement(con, "vacuum pgbench_tellers");
-		tryExecuteStatement(con, "truncate pgbench_history");
-		fprintf(stderr, "end.\n");
+		/* the graph scripts don't need the standard tables */
+		if (internal_script_used || !graph_script_used)
+		{
+			fprintf(stderr, "starting vacuum...");
+			tryExecuteStatement(con, "vacuum pgbench_branches");
+			tryExecuteStatement(con, "vacuum pgbench_tellers");
+			tryExecuteStatement(con, "truncate pgbench_history");
+			fprintf(stderr, "end.\n");
+
+			if (do_vacuum_accounts)
+			{
+				fprintf(stderr, "starting vacuum pgbench_accounts...");
+				tryExecuteStatement(con, "vacuum analyze pgbench_accounts");
+				fprintf(stderr, "end.\n");
+			}
+		}
 
-		if (do_vacuum_accounts)
+		if (graph_script_used)
 		{
-			fprintf(stderr, "starting vacuum pgbench_accounts...");
-			tryExecuteStatement(con, "vacuum analyze pgbench_accounts");
+			fprintf(stderr, "starting vacuum pgbench_graph...");
+			tryExecuteStatement(con, "vacuum pgbench_graph.person");
+			tryExecuteStatement(con, "vacuum pgbench_graph.post");
+			tryExecuteStatement(con, "vacuum pgbench_graph.knows");
+			tryExecuteStatement(con, "vacuum pgbench_graph.likes");
+			tryExecuteStatement(con, "vacuum pgbench_graph.has_creator");
 			fprintf(stderr, "end.\n");
 		}
 	}
@@ -178,6 +178,57 @@ pgbench(
 	],
 	'pgbench select only');
 
+# Social network graph and its builtin scripts
+pgbench(
+	'-i -I G',
+	0,
+	[qr{^$}],
+	[
+		qr{generating graph},
+		qr{creating property indexes},
+		qr{vacuuming graph},
+		qr{done\.}
+	],
+	'pgbench graph initialization');
+
+pgbench(
+	'-t 10 -c 2 -M simple -b snb-short-read -b snb-khop -b snb-shortestpath'
+	  . ' -b snb-update --latency-percentiles',
+	0,
+	[
+		qr{type: multiple scripts},
+		qr{processed: 20/20},
+		qr{script 1: <builtin: social network short reads>},
+		qr{script 4: <builtin: social network updates>},
+		qr{latency 99.9% = \d+\.\d+ ms}
+	],
+	[qr{vacuum pgbench_graph}],
+	'pgbench graph scripts');
+
+# graph and standard scripts share :scale
+pgbench(
+	'-t 1 -M simple -b select-only -b snb-short-read',
+	0,
+	[qr{processed: 1/1}],
+	[qr{vacuum pgbench_graph}],
+	'pgbench graph and standard scripts');
+
+pgbench(
+	'-i -I G -s 2',
+	0,
+	[qr{^$}],
+	[qr{generating graph}, qr{done\.}],
+	'pgbench graph initialization with scale 2');
+
+pgbench(
+	'-t 1 -M simple -b select-only -b snb-short-read',
+	1,
+	[qr{^$}],
+	[
+		qr{scale of pgbench_graph \(2\) does not match scale of pgbench_branches \(1\)}
+	],
+	'pgbench graph and standard scripts with different scales');
+
 # check if threads are supported
 my $nthreads = 2;
 
@@ -131,6 +131,11 @@ my @options = (
 	[ 'init vs run', '-i -S',    [qr{cannot be used in initialization}] ],
 	[ 'run vs init', '-S -F 90', [qr{cannot be used in benchmarking}] ],
 	[ 'ambiguous builtin', '-b s', [qr{ambiguous}] ],
+	[
+		'graph builtin with prepared',
+		'-b snb-khop -M prepared',
+		[qr{builtin graph scripts require simple query mode}]
+	],
 	[
 		'--progress-timestamp => --progress', '--progress-timestamp',
 		[qr{allowed only under}]
@@ -210,7 +215,8 @@ pgbench(
 	[qr{^$}],
 	[
 		qr{Available builtin scripts:}, qr{tpcb-like},
-		qr{simple-update},              qr{select-only}
+		qr{simple-update},              qr{select-only},
+		qr{snb-short-read},             qr{snb-update}
 	],
 	'pgbench builtin list');
 
@@ -21,4 +21,10 @@
 #define AG_PATH_VERTICES	"vertices"
 #define AG_PATH_EDGES		"edges"
 
+/*
+ * number of IDs of a label sequence that each backend pre-allocates, so that
+ * creating many elements does not lock the sequence for each of them
+ */
+#define AG_LABEL_ID_SEQ_CACHE	32
+
 #endif	/* AG_CONST_H */
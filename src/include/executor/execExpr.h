@@ -685,7 +685,7 @@ typedef struct ExprEvalStep
 		{
 			Datum	   *listvalue;
 			bool	   *listnull;
-			JsonbIterator **listiter;
+			JsonbArrayIterator *listiter;
 		}			cypherlistcomp_iter;
 
 		struct
@@ -760,6 +760,11 @@ typedef struct CypherAccessPathElem
 	bool		is_slice;
 	CypherIndexResult lidx;
 	CypherIndexResult uidx;
+
+	/* prepared object key if uidx is a constant string, otherwise NULL */
+	JsonbValue *key;
+	int			keyhint;		/* position of the key found last time */
+	JsonbValue	keyvalue;		/* workspace for the value of the key */
 } CypherAccessPathElem;
 
 
@@ -833,6 +838,13 @@ extern void ExecEvalAggOrderedTransTuple(ExprState *state, ExprEvalStep *op,
 extern void ExecEvalCypherTypeCast(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalCypherMapExpr(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalCypherListExpr(ExprState *state, ExprEvalStep *op);
+extern void ExecEvalCypherListCompBegin(ExprState *state, ExprEvalStep *op);
+extern void ExecEvalCypherListCompElem(ExprState *state, ExprEvalStep *op);
+extern void ExecEvalCypherListCompEnd(ExprState *state, ExprEvalStep *op);
+extern void ExecEvalCypherListCompIterInit(ExprState *state,
+							   ExprEvalStep *op);
+extern void ExecEvalCypherListCompIterNext(ExprState *state,
+							   ExprEvalStep *op);
 extern void ExecEvalCypherAccessExpr(ExprState *state, ExprEvalStep *op);
 
 #endif							/* EXEC_EXPR_H */
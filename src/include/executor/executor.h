@@ -551,6 +551,7 @@ extern Bitmapset *ExecGetInsertedCols(ResultRelInfo *relinfo, EState *estate);
 extern Bitmapset *ExecGetUpdatedCols(ResultRelInfo *relinfo, EState *estate);
 
 extern void InitScanLabelInfo(ScanState *node);
+extern Oid	ExecGetLabelGraphOid(PlanState *planstate);
 
 /*
  * prototypes from functions in execIndexing.c
@@ -70,6 +70,21 @@ typedef struct WorkerInstrumentation
 	Instrumentation instrument[FLEXIBLE_ARRAY_MEMBER];
 } WorkerInstrumentation;
 
+/*
+ * Counters of graph traversal nodes. Unlike Instrumentation, these are kept
+ * whether or not the query is instrumented, and accumulate across rescans.
+ */
+typedef struct TraversalInstrumentation
+{
+	double		nexpanded;		/* # of vertices whose edges were looked up */
+	double		nedges;			/* # of edges examined */
+	double		nrescans;		/* # of rescans of the edge subplan */
+	int			maxdepth;		/* # of edges of the longest path reached */
+	int			nhops;			/* # of valid entries in frontier */
+	int			maxhops;		/* allocated length of frontier */
+	double	   *frontier;		/* # of vertices expanded at each hop */
+} TraversalInstrumentation;
+
 extern PGDLLIMPORT BufferUsage pgBufferUsage;
 
 extern Instrumentation *InstrAlloc(int n, int instrument_options);
@@ -81,5 +96,7 @@ extern void InstrAggNode(Instrumentation *dst, Instrumentation *add);
 extern void InstrStartParallelQuery(void);
 extern void InstrEndParallelQuery(BufferUsage *result);
 extern void InstrAccumParallelQuery(BufferUsage *result);
+extern void InstrInitTraversal(TraversalInstrumentation *ti, bool per_hop);
+extern void InstrCountExpansion(TraversalInstrumentation *ti, int hop);
 
 #endif							/* INSTRUMENT_H */
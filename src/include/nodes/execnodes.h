@@ -1787,6 +1787,8 @@ typedef struct NestLoopVLEState
 	ArrayBuildState *vertices;	/* vertices for the current result row */
 	dlist_head	ctxs_head;		/* list of NestLoopVLEContext */
 	dlist_node *prev_ctx_node;
+	Oid			graphoid;		/* graph of the vertices, for pgstat */
+	TraversalInstrumentation instr;	/* counters for EXPLAIN ANALYZE */
 } NestLoopVLEState;
 
 
@@ -2340,6 +2342,7 @@ typedef struct ModifyGraphState
 	int			numOldRtable;
 	ResultRelInfo *resultRelations;
 	int			numResultRelations;
+	List	  **promotedProps;	/* PromotedProperty's of each result rel */
 	CommandId	modify_cid;
 	List	   *pattern;		/* graph pattern (list of paths) for CREATE
 								   with `es_prop_map` */
@@ -2372,6 +2375,12 @@ typedef struct Hash2SideState
 
 	/* Parallel hash state. */
 	struct ParallelHashJoinState *parallel_state;
+
+	/* counters for EXPLAIN ANALYZE */
+	TraversalInstrumentation instr;
+	long			bucketIncreases;	/* # of times nbuckets grew */
+	long			batchIncreases;		/* # of times nbatch grew */
+	long			spilledBatches;		/* # of batch files written */
 } Hash2SideState;
 
 typedef struct ShortestpathState
@@ -2412,12 +2421,15 @@ typedef struct ShortestpathState
 	long             numResults;
 	Hash2SideState  *outerNode;
 	Hash2SideState  *innerNode;
+	Oid              graphoid;	/* graph of the vertices, for pgstat */
+	TraversalInstrumentation instr;	/* counters for EXPLAIN ANALYZE */
 } ShortestpathState;
 
 typedef struct DijkstraState
 {
 	PlanState 		ps;
 	HTAB		   *visited_nodes;
+	MemoryContext	visited_mcxt;
 	pairingheap	   *pq;
 	MemoryContext 	pq_mcxt;
 	ExprState  	   *source;
@@ -2430,6 +2442,14 @@ typedef struct DijkstraState
 	TupleTableSlot *selfTupleSlot;
 	HeapTuple		vertexRow;		/* pointer to hold reusable vertex row */
 	TupleDesc		tupleDesc;		/* pointer to vertex row's tuple descr */
+	struct GraphCSR *projection;	/* graph projection of edges, or NULL */
+	char		   *projection_name;	/* its name, for EXPLAIN */
+	Oid				graphoid;		/* graph of the vertices, for pgstat */
+
+	/* counters for EXPLAIN ANALYZE */
+	TraversalInstrumentation instr;
+	Size			visited_peak;	/* peak memory of visited_nodes */
+	Size			pq_peak;		/* peak memory of the priority queue */
 } DijkstraState;
 
 #endif							/* EXECNODES_H */
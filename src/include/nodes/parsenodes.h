@@ -187,6 +187,9 @@ typedef struct Query
 	Node	   *dijkstraEndId;
 	Node	   *dijkstraEdgeId;
 	Node	   *dijkstraLimit;
+	Oid			dijkstraLabel;	/* edge label to find graph projections */
+	char	   *dijkstraWeightKey;	/* weight property for graph projections */
+	int			dijkstraDirection;	/* CYPHER_REL_DIR_* */
 	Node	   *shortestpathEndIdLeft;
 	Node	   *shortestpathEndIdRight;
 	Node	   *shortestpathTableOidLeft;
@@ -1017,6 +1020,7 @@ typedef struct RangeTblEntry
 	Query	   *subquery;		/* the sub-query */
 	bool		security_barrier;	/* is from security_barrier view? */
 	bool		isVLE;
+	bool		isCypherClause;	/* is the subquery of a Cypher clause? */
 
 	/*
 	 * Fields valid for a join RTE (else NULL/zero):
@@ -1834,7 +1838,8 @@ typedef enum AlterTableType
 	AT_AddIdentity,				/* ADD IDENTITY */
 	AT_SetIdentity,				/* SET identity column options */
 	AT_DropIdentity,			/* DROP IDENTITY */
-	AT_DisableIndex				/* DISABLE INDEX for graph labels */
+	AT_DisableIndex,			/* DISABLE INDEX for graph labels */
+	AT_PromoteProperty			/* PROMOTE PROPERTY for graph labels */
 } AlterTableType;
 
 typedef struct ReplicaIdentityStmt
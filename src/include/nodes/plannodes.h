@@ -1281,6 +1281,9 @@ typedef struct Dijkstra
 	Node	   *source;
 	Node	   *target;
 	Node	   *limit;
+	Oid			elabel;			/* edge label for graph projections */
+	char	   *weight_key;		/* weight property, NULL if not a property */
+	int			direction;		/* CYPHER_REL_DIR_* */
 } Dijkstra;
 
 #endif							/* PLANNODES_H */
@@ -83,6 +83,9 @@ extern Node *eval_const_expressions(PlannerInfo *root, Node *node);
 
 extern Node *estimate_expression_value(PlannerInfo *root, Node *node);
 
+extern Node *rewrite_promoted_properties(PlannerInfo *root, Node *node);
+extern bool cypher_access_matches_field_path(Node *node, Node *expr);
+
 extern Query *inline_set_returning_function(PlannerInfo *root,
 							  RangeTblEntry *rte);
 
@@ -13,10 +13,15 @@
 
 #include "parser/parse_node.h"
 
+/* alias of the subquery made for each Cypher clause */
+#define CYPHER_SUBQUERY_ALIAS	"_"
+
 extern bool enable_eager;
 
 extern Query *transformCypherSubPattern(ParseState *pstate,
 										CypherSubPattern *subpat);
+extern Node *transformCypherReachability(ParseState *pstate,
+										 CypherSubPattern *subpat);
 extern Query *transformCypherProjection(ParseState *pstate,
 										CypherClause *clause);
 extern Query *transformCypherMatchClause(ParseState *pstate,
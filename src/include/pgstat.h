@@ -93,6 +93,12 @@ typedef int64 PgStat_Counter;
  * regardless of whether the transaction committed.  delta_live_tuples,
  * delta_dead_tuples, and changed_tuples are set depending on commit or abort.
  * Note that delta_live_tuples and delta_dead_tuples can be negative!
+ *
+ * The graph_* counters are kept only for label tables.  graph_expanded is the
+ * number of vertices of the label that graph traversals (VLE, shortestpath,
+ * dijkstra) expanded as their frontier.  graph_merge_matched and
+ * graph_merge_created count the elements of the label that MERGE found and
+ * created.  Like the scan counters, they are nontransactional.
  * ----------
  */
 typedef struct PgStat_TableCounts
@@ -114,6 +120,10 @@ typedef struct PgStat_TableCounts
 
 	PgStat_Counter t_blocks_fetched;
 	PgStat_Counter t_blocks_hit;
+
+	PgStat_Counter t_graph_expanded;
+	PgStat_Counter t_graph_merge_matched;
+	PgStat_Counter t_graph_merge_created;
 } PgStat_TableCounts;
 
 /* Possible targets for resetting cluster-wide shared values */
@@ -565,7 +575,7 @@ typedef union PgStat_Msg
  * ------------------------------------------------------------
  */
 
-#define PGSTAT_FILE_FORMAT_ID	0x01A5BC9D
+#define PGSTAT_FILE_FORMAT_ID	0x01A5BC9E
 
 /* ----------
  * PgStat_StatDBEntry			The collector's data per database
@@ -632,6 +642,10 @@ typedef struct PgStat_StatTabEntry
 	PgStat_Counter blocks_fetched;
 	PgStat_Counter blocks_hit;
 
+	PgStat_Counter graph_expanded;
+	PgStat_Counter graph_merge_matched;
+	PgStat_Counter graph_merge_created;
+
 	TimestampTz vacuum_timestamp;	/* user initiated vacuum */
 	PgStat_Counter vacuum_count;
 	TimestampTz autovac_vacuum_timestamp;	/* autovacuum initiated */
@@ -801,6 +815,7 @@ typedef enum
 	WAIT_EVENT_BGWORKER_STARTUP,
 	WAIT_EVENT_BTREE_PAGE,
 	WAIT_EVENT_EXECUTE_GATHER,
+	WAIT_EVENT_GRAPH_ALGORITHM_ITERATING,
 	WAIT_EVENT_HASH_BATCH_ALLOCATING,
 	WAIT_EVENT_HASH_BATCH_ELECTING,
 	WAIT_EVENT_HASH_BATCH_LOADING,
@@ -1342,6 +1357,11 @@ pgstat_report_wait_end(void)
 		if ((rel)->pgstat_info != NULL)								\
 			(rel)->pgstat_info->t_counts.t_blocks_hit++;			\
 	} while (0)
+#define pgstat_count_graph_merge_create(rel)						\
+	do {															\
+		if ((rel)->pgstat_info != NULL)								\
+			(rel)->pgstat_info->t_counts.t_graph_merge_created++;	\
+	} while (0)
 #define pgstat_count_buffer_read_time(n)							\
 	(pgStatBlockReadTime += (n))
 #define pgstat_count_buffer_write_time(n)							\
@@ -1395,4 +1415,8 @@ extern void agstat_drop_vlabel(const char *vlab);
 extern void agstat_drop_elabel(const char *elab);
 extern void agstat_drop_graph(const char *graph);
 
+/* Functions to count graph traversals and MERGE per label */
+extern void agstat_count_vertex_expand(Oid graphoid, Graphid vid);
+extern void agstat_count_merge_match(Oid relid);
+
 #endif							/* PGSTAT_H */
@@ -219,6 +219,7 @@ typedef enum BuiltinTrancheIds
 	LWTRANCHE_SHARED_TUPLESTORE,
 	LWTRANCHE_TBM,
 	LWTRANCHE_PARALLEL_APPEND,
+	LWTRANCHE_GRAPH_PROJECTION,
 	LWTRANCHE_FIRST_USER_DEFINED
 }			BuiltinTrancheIds;
 
@@ -11,6 +11,9 @@
 #define CYPHER_FUNCS_H
 
 #include "fmgr.h"
+#include "nodes/pg_list.h"
+#include "utils/jsonb.h"
+#include "utils/relcache.h"
 
 /* scalar */
 extern Datum jsonb_head(PG_FUNCTION_ARGS);
@@ -66,6 +69,21 @@ extern Datum jsonb_string_ends_with(PG_FUNCTION_ARGS);
 extern Datum jsonb_string_contains(PG_FUNCTION_ARGS);
 extern Datum jsonb_string_regex(PG_FUNCTION_ARGS);
 
+/* promoted properties */
+typedef struct PromotedProperty
+{
+	AttrNumber	attnum;			/* column the property is promoted to */
+	char	   *key;			/* key of the property */
+} PromotedProperty;
+
+extern List *RelationGetPromotedProperties(Relation rel);
+extern bool PropertyTypeIsPromotable(Oid typid);
+extern bool JsonbScalarToPropertyDatum(JsonbValue *jv, Oid typid,
+									   Datum *result);
+extern Datum getPromotedPropertyDatum(Jsonb *props, const char *key,
+									  Oid typid, bool *isnull);
+extern Datum promote_property(PG_FUNCTION_ARGS);
+
 /* utility */
 extern Datum get_last_graph_write_stats(PG_FUNCTION_ARGS);
 
@@ -0,0 +1,24 @@
+/*
+ * cypherplancache.h
+ *	  Backend-local cache of plans for Cypher statements.
+ *
+ * Copyright (c) 2016 by Bitnine Global, Inc.
+ *
+ * src/include/utils/cypherplancache.h
+ */
+
+#ifndef CYPHERPLANCACHE_H
+#define CYPHERPLANCACHE_H
+
+#include "nodes/parsenodes.h"
+#include "utils/plancache.h"
+
+/* GUC parameter */
+extern int	cypher_plan_cache_size;
+
+extern CachedPlanSource *GetCypherPlanSource(RawStmt *parsetree,
+					const char *query_string,
+					const char *commandTag);
+extern void ResetCypherPlanCache(void);
+
+#endif	/* CYPHERPLANCACHE_H */
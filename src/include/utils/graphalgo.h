@@ -0,0 +1,22 @@
+/*
+ * graphalgo.h
+ *	  Built-in graph algorithms.
+ *
+ * Copyright (c) 2016 by Bitnine Global, Inc.
+ *
+ * src/include/utils/graphalgo.h
+ */
+
+#ifndef GRAPHALGO_H
+#define GRAPHALGO_H
+
+#include "storage/dsm.h"
+#include "storage/shm_toc.h"
+
+/* entry points of parallel workers */
+extern void pagerank_parallel_main(dsm_segment *seg, shm_toc *toc);
+extern void wcc_parallel_main(dsm_segment *seg, shm_toc *toc);
+extern void triangle_parallel_main(dsm_segment *seg, shm_toc *toc);
+extern void random_walks_parallel_main(dsm_segment *seg, shm_toc *toc);
+
+#endif	/* GRAPHALGO_H */
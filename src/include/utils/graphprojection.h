@@ -0,0 +1,101 @@
+/*
+ * graphprojection.h
+ *	  Shared in-memory CSR projections of edge labels.
+ *
+ * Copyright (c) 2016 by Bitnine Global, Inc.
+ *
+ * src/include/utils/graphprojection.h
+ */
+
+#ifndef GRAPHPROJECTION_H
+#define GRAPHPROJECTION_H
+
+#include "utils/graph.h"
+#include "utils/snapshot.h"
+
+/*
+ * Compressed sparse row (CSR) form of the edges of an edge label.
+ *
+ * Vertices are numbered by dense ordinals 0 .. nvertices - 1 in the order of
+ * their graphids. The outgoing edges of the vertex with ordinal v are
+ * out_adj[out_off[v]] .. out_adj[out_off[v + 1] - 1], which are the
+ * ordinals of their end vertices in ascending order. out_eid and out_weight
+ * give the graphid and the weight of each of them. in_* are the same for
+ * incoming edges. Weights are there only if the projection has a weight
+ * property; otherwise out_weight and in_weight are NULL.
+ *
+ * The arrays live in one chunk of memory (GraphCSRData), either in a DSA
+ * area for shared projections or in backend-local memory.
+ */
+typedef struct GraphCSR
+{
+	int64		nvertices;
+	int64		nedges;
+	Graphid    *vertices;		/* graphids of the vertices, sorted */
+	int64	   *out_off;		/* nvertices + 1 offsets into out_* */
+	uint32	   *out_adj;
+	Graphid    *out_eid;
+	float8	   *out_weight;
+	int64	   *in_off;			/* nvertices + 1 offsets into in_* */
+	uint32	   *in_adj;
+	Graphid    *in_eid;
+	float8	   *in_weight;
+} GraphCSR;
+
+typedef struct GraphCSRData GraphCSRData;
+
+/*
+ * Reachability index of a CSR. comp gives the strongly connected component
+ * of each vertex ordinal. The components form a DAG whose edges go from a
+ * larger component number to a smaller one; the edges of component c are
+ * dag_adj[dag_off[c]] .. dag_adj[dag_off[c + 1] - 1]. pre and post are the
+ * numbers of the components in a depth-first traversal of the DAG. cyclic
+ * tells whether a path leads from a component back to itself.
+ */
+typedef struct GraphReach
+{
+	int64		nvertices;
+	int64		ncomps;
+	uint32	   *comp;
+	bool	   *cyclic;
+	uint32	   *pre;
+	uint32	   *post;
+	int64	   *dag_off;		/* ncomps + 1 offsets into dag_adj */
+	uint32	   *dag_adj;
+} GraphReach;
+
+typedef struct GraphReachData GraphReachData;
+
+/* GUC variable */
+extern int	graph_projection_memory;
+
+/* building */
+extern GraphCSRData *graph_csr_build(Oid elabel, const char *weight_key,
+				Oid vlabel, Snapshot snapshot);
+extern GraphCSRData *graph_csr_build_labels(Oid *elabels, int nelabels,
+					   const char *weight_key, Oid vlabel,
+					   Snapshot snapshot);
+extern void graph_csr_init(GraphCSR *csr, GraphCSRData *data);
+extern Size graph_csr_size(GraphCSRData *data);
+extern int64 graph_csr_ordinal(GraphCSR *csr, Graphid id);
+extern Oid	get_graph_label_oid(const char *labname, Oid graphid,
+					char labkind);
+
+/* reachability */
+extern GraphReachData *graph_reach_build(GraphCSR *csr);
+extern void graph_reach_init(GraphReach *reach, GraphReachData *data);
+extern Size graph_reach_size(GraphReachData *data);
+extern bool graph_reach_query(GraphReach *reach, int64 u, int64 v);
+
+/* shared projections */
+extern Size GraphProjectionShmemSize(void);
+extern void GraphProjectionShmemInit(void);
+extern void GraphProjectionRelationModified(Oid relid);
+extern bool GetGraphProjection(Oid elabel, const char *weight_key,
+				   Snapshot snapshot, MemoryContext mcxt, GraphCSR *csr,
+				   char **name);
+extern bool GetGraphReachability(Oid elabel, Snapshot snapshot,
+					 MemoryContext mcxt, GraphCSR *csr, GraphReach *reach);
+extern bool GraphReachabilityExists(Oid elabel);
+
+#endif	/* GRAPHPROJECTION_H */
@@ -265,6 +265,8 @@ extern char *external_pid_file;
 
 extern PGDLLIMPORT char *application_name;
 
+extern uint64 PlannerGUCChangeCounter;
+
 extern int	tcp_keepalives_idle;
 extern int	tcp_keepalives_interval;
 extern int	tcp_keepalives_count;
@@ -351,22 +351,51 @@ typedef struct JsonbIterator
 	struct JsonbIterator *parent;
 } JsonbIterator;
 
+/*
+ * Iterator over the elements of an array container.  Elements are decoded
+ * JSONB_ARRAY_BATCH_SIZE at a time into the iterator itself, so walking an
+ * array allocates nothing per element.  Returned values point into the
+ * container, which must outlive them.
+ */
+#define JSONB_ARRAY_BATCH_SIZE	64
+
+typedef struct JsonbArrayIterator
+{
+	JsonbContainer *container;
+	uint32		nElems;
+	char	   *dataProper;
+	uint32		nextIndex;		/* index of the next element to decode */
+	uint32		nextDataOffset; /* data offset of the next element */
+	int			nBatch;			/* number of elements in batch */
+	int			curBatch;		/* next element to return from batch */
+	JsonbValue	batch[JSONB_ARRAY_BATCH_SIZE];
+} JsonbArrayIterator;
+
 
 /* Support functions */
 extern uint32 getJsonbOffset(const JsonbContainer *jc, int index);
 extern uint32 getJsonbLength(const JsonbContainer *jc, int index);
 extern int	compareJsonbContainers(JsonbContainer *a, JsonbContainer *b);
+extern uint64 getJsonbSortKey(JsonbContainer *jc, bool c_collation);
 extern JsonbValue *findJsonbValueFromContainer(JsonbContainer *sheader,
 							uint32 flags,
 							JsonbValue *key);
 extern JsonbValue *getIthJsonbValueFromContainer(JsonbContainer *sheader,
 							  uint32 i);
+extern bool findJsonbObjectValueWithHint(JsonbContainer *container,
+							 JsonbValue *key, int *hint, JsonbValue *result);
+extern bool findJsonbValueFromToast(struct varlena *attr, JsonbValue *key,
+						JsonbValue **result);
 extern JsonbValue *pushJsonbValue(JsonbParseState **pstate,
 			   JsonbIteratorToken seq, JsonbValue *jbVal);
 extern JsonbIterator *JsonbIteratorInit(JsonbContainer *container);
 extern JsonbIteratorToken JsonbIteratorNext(JsonbIterator **it, JsonbValue *val,
 				  bool skipNested);
+extern void JsonbArrayIteratorInit(JsonbArrayIterator *it,
+					   JsonbContainer *container);
+extern JsonbValue *JsonbArrayIteratorNext(JsonbArrayIterator *it);
 extern Jsonb *JsonbValueToJsonb(JsonbValue *val);
+extern Jsonb *NumericToJsonb(Numeric num);
 extern bool JsonbDeepContains(JsonbIterator **val,
 				  JsonbIterator **mContained);
 extern void JsonbHashScalarValue(const JsonbValue *scalarVal, uint32 *hash);
@@ -0,0 +1,39 @@
+/*
+ * labelcache.h
+ *	  Backend-local cache of label metadata.
+ *
+ * Copyright (c) 2016 by Bitnine Global, Inc.
+ *
+ * src/include/utils/labelcache.h
+ */
+
+#ifndef LABELCACHE_H
+#define LABELCACHE_H
+
+#include "nodes/pg_list.h"
+#include "utils/jsonb.h"
+
+typedef struct LabelCacheKey
+{
+	Oid			graphoid;
+	uint16		labid;
+} LabelCacheKey;
+
+typedef struct LabelCacheEntry
+{
+	LabelCacheKey key;			/* lookup key - must be first */
+	NameData	labname;
+	Oid			relid;
+	List	   *ancestors;		/* relids of the label and its ancestors */
+	Jsonb	   *labels;			/* result of labels(), or NULL if not built */
+} LabelCacheEntry;
+
+/*
+ * The returned entry is only valid until the next time invalidation messages
+ * are processed. Callers must copy whatever they need before doing any
+ * catalog access.
+ */
+extern LabelCacheEntry *LookupLabelCache(Oid graphoid, uint16 labid,
+										 bool need_labels);
+
+#endif	/* LABELCACHE_H */
@@ -57,6 +57,9 @@ typedef struct NumericData *Numeric;
  * Utility functions in numeric.c
  */
 extern bool numeric_is_nan(Numeric num);
+extern bool numeric_is_int64(Numeric num, int64 *result);
+extern Numeric int64_to_numeric(int64 val);
+extern uint64 numeric_sort_key(Numeric num);
 int32		numeric_maximum_size(int32 typmod);
 extern char *numeric_out_sci(Numeric num, int scale);
 extern char *numeric_normalize(Numeric num);
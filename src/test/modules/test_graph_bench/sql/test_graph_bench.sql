@@ -0,0 +1,26 @@
+CREATE EXTENSION test_graph_bench;
+
+CREATE GRAPH bench_graph;
+SET graph_path = bench_graph;
+
+-- timings vary from run to run, so only check that every benchmark ran;
+-- graphid comparisons must not allocate
+SELECT name, ops, ns_per_op >= 0 AS timed, allocs_per_op = 0 AS no_allocs
+FROM bench_graph_functions(nitems => 100, loops => 2);
+
+SELECT name, ops, allocs_per_op > 0 AS allocs
+FROM bench_graph_functions(ARRAY['vertex_out', 'cypher_access_object'],
+                           nitems => 50, nprops => 32, shape => 'string',
+                           strlen => 100, loops => 1);
+
+SELECT name, ops
+FROM bench_graph_functions(ARRAY['jsonb_add', 'jsonb_div'], shape => 'float',
+                           nitems => 10, loops => 3);
+
+-- errors
+SELECT * FROM bench_graph_functions(shape => 'nested');
+SELECT * FROM bench_graph_functions(ARRAY['vertex_in']);
+SELECT * FROM bench_graph_functions(nitems => 1);
+SELECT * FROM bench_graph_functions(loops => NULL);
+
+DROP GRAPH bench_graph CASCADE;
@@ -0,0 +1,18 @@
+/* src/test/modules/test_graph_bench/test_graph_bench--1.0.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "CREATE EXTENSION test_graph_bench" to load this file. \quit
+
+CREATE FUNCTION bench_graph_functions(funcs text[] DEFAULT NULL,
+    nitems integer DEFAULT 1000,
+    nprops integer DEFAULT 8,
+    shape text DEFAULT 'mixed',
+    strlen integer DEFAULT 16,
+    loops integer DEFAULT 100,
+    OUT name text,
+    OUT ops bigint,
+    OUT ns_per_op float8,
+    OUT allocs_per_op float8,
+    OUT bytes_per_op float8)
+RETURNS SETOF record
+AS 'MODULE_PATHNAME' LANGUAGE C;
@@ -0,0 +1,746 @@
+/*
+ * test_graph_bench.c
+ *	  Micro-benchmarks of graph datatype and jsonb property functions.
+ *
+ * Each benchmark calls one function over a synthetic dataset many times and
+ * reports the time and the memory allocations per call. Allocations are
+ * counted by a memory context that hands every request over to an ordinary
+ * AllocSet context and only keeps counts; see CountingContext below.
+ *
+ * Copyright (c) 2016 by Bitnine Global, Inc.
+ *
+ * IDENTIFICATION
+ *	  src/test/modules/test_graph_bench/test_graph_bench.c
+ */
+
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "ag_const.h"
+#include "catalog/ag_graph_fn.h"
+#include "catalog/pg_collation.h"
+#include "catalog/pg_type.h"
+#include "executor/executor.h"
+#include "fmgr.h"
+#include "funcapi.h"
+#include "lib/stringinfo.h"
+#include "miscadmin.h"
+#include "nodes/makefuncs.h"
+#include "portability/instr_time.h"
+#include "storage/itemptr.h"
+#include "utils/array.h"
+#include "utils/builtins.h"
+#include "utils/graph.h"
+#include "utils/jsonb.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+
+PG_MODULE_MAGIC;
+
+PG_FUNCTION_INFO_V1(bench_graph_functions);
+
+/* number of vertices in each graphpath of the dataset */
+#define BENCH_PATH_LENGTH	4
+
+typedef enum BenchShape
+{
+	BENCH_SHAPE_INT,
+	BENCH_SHAPE_FLOAT,
+	BENCH_SHAPE_STRING,
+	BENCH_SHAPE_MIXED
+} BenchShape;
+
+/* synthetic dataset; item i of every array is made from the same number */
+typedef struct BenchData
+{
+	int			nitems;
+	Datum	   *ids;			/* graphid */
+	Datum	   *props;			/* jsonb objects of nprops properties */
+	Datum	   *numbers;		/* jsonb numbers */
+	Datum	   *strings;		/* jsonb strings */
+	Datum	   *vertices;
+	Datum	   *edges;
+	Datum	   *paths;
+	Datum		start;			/* jsonb 1, for substr() */
+	Datum		length;			/* jsonb 3, for substr() */
+	char	   *key;			/* property accessed by cypher_access_object */
+} BenchData;
+
+typedef enum BenchArgs
+{
+	BENCH_ARGS_IDS,				/* (ids[i], ids[i + 1]) */
+	BENCH_ARGS_VERTEX,			/* (vertices[i]) */
+	BENCH_ARGS_EDGE,			/* (edges[i]) */
+	BENCH_ARGS_PATH,			/* (paths[i]) */
+	BENCH_ARGS_ACCESS,			/* props[i].key, through the executor */
+	BENCH_ARGS_NUMBERS,			/* (numbers[i], numbers[i + 1]) */
+	BENCH_ARGS_NUMBER,			/* (numbers[i]) */
+	BENCH_ARGS_OBJECT,			/* (props[i]) */
+	BENCH_ARGS_STRING,			/* (strings[i]) */
+	BENCH_ARGS_STRINGS,			/* (strings[i], strings[i + 1]) */
+	BENCH_ARGS_SUBSTR			/* (strings[i], start, length) */
+} BenchArgs;
+
+typedef struct BenchFunc
+{
+	const char *name;			/* benchmark name */
+	const char *prosrc;			/* built-in function, if called directly */
+	BenchArgs	args;
+} BenchFunc;
+
+static const BenchFunc bench_funcs[] = {
+	{"graphid_eq", "graphid_eq", BENCH_ARGS_IDS},
+	{"graphid_lt", "graphid_lt", BENCH_ARGS_IDS},
+	{"btgraphidcmp", "btgraphidcmp", BENCH_ARGS_IDS},
+	{"vertex_out", "vertex_out", BENCH_ARGS_VERTEX},
+	{"edge_out", "edge_out", BENCH_ARGS_EDGE},
+	{"graphpath_out", "graphpath_out", BENCH_ARGS_PATH},
+	{"cypher_access_object", NULL, BENCH_ARGS_ACCESS},
+	{"jsonb_add", "jsonb_add", BENCH_ARGS_NUMBERS},
+	{"jsonb_mul", "jsonb_mul", BENCH_ARGS_NUMBERS},
+	{"jsonb_div", "jsonb_div", BENCH_ARGS_NUMBERS},
+	{"jsonb_abs", "jsonb_abs", BENCH_ARGS_NUMBER},
+	{"jsonb_round", "jsonb_round", BENCH_ARGS_NUMBER},
+	{"jsonb_keys", "jsonb_keys", BENCH_ARGS_OBJECT},
+	{"jsonb_length", "jsonb_length", BENCH_ARGS_STRING},
+	{"jsonb_tostring", "jsonb_tostring", BENCH_ARGS_NUMBER},
+	{"jsonb_toupper", "jsonb_toupper", BENCH_ARGS_STRING},
+	{"jsonb_substr", "jsonb_substr", BENCH_ARGS_SUBSTR},
+	{"jsonb_string_contains", "jsonb_string_contains", BENCH_ARGS_STRINGS}
+};
+
+/*
+ * A memory context that counts the chunks asked of it. The chunks come from
+ * `inner`, so they are freed and reallocated by `inner` without going through
+ * here; only new allocations are counted. `inner` is a sibling rather than a
+ * child so that resetting this context does not delete it.
+ */
+typedef struct CountingContext
+{
+	MemoryContextData header;
+	MemoryContext inner;
+	int64		nallocs;
+	int64		nbytes;
+} CountingContext;
+
+static void *CountingAlloc(MemoryContext context, Size size);
+static void CountingFree(MemoryContext context, void *pointer);
+static void *CountingRealloc(MemoryContext context, void *pointer, Size size);
+static void CountingReset(MemoryContext context);
+static void CountingDelete(MemoryContext context);
+static Size CountingGetChunkSpace(MemoryContext context, void *pointer);
+static bool CountingIsEmpty(MemoryContext context);
+static void CountingStats(MemoryContext context,
+			  MemoryStatsPrintFunc printfunc, void *passthru,
+			  MemoryContextCounters *totals);
+#ifdef MEMORY_CONTEXT_CHECKING
+static void CountingCheck(MemoryContext context);
+#endif
+
+static const MemoryContextMethods CountingMethods = {
+	CountingAlloc,
+	CountingFree,
+	CountingRealloc,
+	CountingReset,
+	CountingDelete,
+	CountingGetChunkSpace,
+	CountingIsEmpty,
+	CountingStats
+#ifdef MEMORY_CONTEXT_CHECKING
+	,CountingCheck
+#endif
+};
+
+static CountingContext *CountingContextCreate(MemoryContext parent);
+static BenchShape parse_shape(const char *shape);
+static void make_bench_data(BenchData *data, int nitems, int nprops,
+				BenchShape shape, int slen);
+static Datum make_jsonb(const char *str);
+static void append_value(StringInfo si, BenchShape shape, int64 n,
+			 int slen);
+static ExprState *make_access_expr(const char *key, ParamListInfo params);
+static int64 run_bench(const BenchFunc *bf, BenchData *data, int loops,
+		  CountingContext *cc, double *elapsed_ns);
+static bool bench_selected(const char *name, ArrayType *funcs);
+
+/*
+ * bench_graph_functions(funcs, nitems, nprops, shape, strlen, loops)
+ *		Benchmark graph datatype and jsonb property functions.
+ *
+ * The dataset has `nitems` vertices, edges, property maps and scalars. Each
+ * property map has `nprops` properties whose values are of the given shape,
+ * and strings are `strlen` characters long. Every selected benchmark (all of
+ * them if `funcs` is NULL) goes over the dataset `loops` times, and reports
+ * the calls made and the time, allocations and bytes allocated per call.
+ */
+Datum
+bench_graph_functions(PG_FUNCTION_ARGS)
+{
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	ArrayType  *funcs;
+	int			nitems;
+	int			nprops;
+	BenchShape	shape;
+	int			slen;
+	int			loops;
+	TupleDesc	tupdesc;
+	Tuplestorestate *tupstore;
+	MemoryContext oldcxt;
+	MemoryContext datacxt;
+	CountingContext *cc;
+	BenchData	data;
+	int			i;
+
+	/* only funcs may be NULL */
+	for (i = 1; i < PG_NARGS(); i++)
+	{
+		if (PG_ARGISNULL(i))
+			ereport(ERROR,
+					(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+					 errmsg("only funcs may be null")));
+	}
+
+	funcs = PG_ARGISNULL(0) ? NULL : PG_GETARG_ARRAYTYPE_P(0);
+	nitems = PG_GETARG_INT32(1);
+	nprops = PG_GETARG_INT32(2);
+	shape = parse_shape(text_to_cstring(PG_GETARG_TEXT_PP(3)));
+	slen = PG_GETARG_INT32(4);
+	loops = PG_GETARG_INT32(5);
+
+	if (nitems < 2 || nprops < 1 || slen < 1 || loops < 1)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("nitems must be at least 2, and nprops, strlen and loops at least 1")));
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not allowed in this context")));
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	if (funcs != NULL)
+	{
+		Datum	   *names;
+		bool	   *nulls;
+		int			nnames;
+
+		deconstruct_array(funcs, TEXTOID, -1, false, 'i',
+						  &names, &nulls, &nnames);
+		for (i = 0; i < nnames; i++)
+		{
+			const char *name;
+			int			j;
+
+			if (nulls[i])
+				continue;
+
+			name = TextDatumGetCString(names[i]);
+			for (j = 0; j < lengthof(bench_funcs); j++)
+			{
+				if (strcmp(bench_funcs[j].name, name) == 0)
+					break;
+			}
+			if (j == lengthof(bench_funcs))
+				ereport(ERROR,
+						(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+						 errmsg("unknown benchmark \"%s\"", name)));
+		}
+	}
+
+	oldcxt = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = tupdesc;
+	MemoryContextSwitchTo(oldcxt);
+
+	datacxt = AllocSetContextCreate(CurrentMemoryContext,
+									"bench_graph_functions data",
+									ALLOCSET_DEFAULT_SIZES);
+	oldcxt = MemoryContextSwitchTo(datacxt);
+	make_bench_data(&data, nitems, nprops, shape, slen);
+	MemoryContextSwitchTo(oldcxt);
+
+	cc = CountingContextCreate(CurrentMemoryContext);
+
+	for (i = 0; i < lengthof(bench_funcs); i++)
+	{
+		const BenchFunc *bf = &bench_funcs[i];
+		Datum		values[5];
+		bool		isnull[5];
+		double		elapsed_ns;
+		int64		ops;
+
+		if (!bench_selected(bf->name, funcs))
+			continue;
+
+		ops = run_bench(bf, &data, loops, cc, &elapsed_ns);
+
+		values[0] = CStringGetTextDatum(bf->name);
+		values[1] = Int64GetDatum(ops);
+		values[2] = Float8GetDatum(elapsed_ns / ops);
+		values[3] = Float8GetDatum((double) cc->nallocs / ops);
+		values[4] = Float8GetDatum((double) cc->nbytes / ops);
+		memset(isnull, false, sizeof(isnull));
+		tuplestore_putvalues(tupstore, tupdesc, values, isnull);
+	}
+
+	MemoryContextDelete(cc->inner);
+	MemoryContextDelete((MemoryContext) cc);
+	MemoryContextDelete(datacxt);
+
+	return (Datum) 0;
+}
+
+static bool
+bench_selected(const char *name, ArrayType *funcs)
+{
+	Datum	   *names;
+	bool	   *nulls;
+	int			nnames;
+	int			i;
+
+	if (funcs == NULL)
+		return true;
+
+	deconstruct_array(funcs, TEXTOID, -1, false, 'i',
+					  &names, &nulls, &nnames);
+	for (i = 0; i < nnames; i++)
+	{
+		if (!nulls[i] && strcmp(TextDatumGetCString(names[i]), name) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+static BenchShape
+parse_shape(const char *shape)
+{
+	if (strcmp(shape, "int") == 0)
+		return BENCH_SHAPE_INT;
+	if (strcmp(shape, "float") == 0)
+		return BENCH_SHAPE_FLOAT;
+	if (strcmp(shape, "string") == 0)
+		return BENCH_SHAPE_STRING;
+	if (strcmp(shape, "mixed") == 0)
+		return BENCH_SHAPE_MIXED;
+
+	ereport(ERROR,
+			(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+			 errmsg("invalid property shape \"%s\"", shape),
+			 errhint("Valid shapes are \"int\", \"float\", \"string\" and \"mixed\".")));
+	return BENCH_SHAPE_INT;		/* keep compiler quiet */
+}
+
+/*
+ * Build the dataset in CurrentMemoryContext. Vertices and edges get the
+ * default labels of the current graph so that their output functions can
+ * look the labels up.
+ */
+static void
+make_bench_data(BenchData *data, int nitems, int nprops, BenchShape shape,
+				int slen)
+{
+	Oid			graphoid = get_graph_path_oid();
+	uint16		vlabid = get_labname_labid(AG_VERTEX, graphoid);
+	uint16		elabid = get_labname_labid(AG_EDGE, graphoid);
+	StringInfoData si;
+	int			i;
+
+	data->nitems = nitems;
+	data->ids = palloc(sizeof(Datum) * nitems);
+	data->props = palloc(sizeof(Datum) * nitems);
+	data->numbers = palloc(sizeof(Datum) * nitems);
+	data->strings = palloc(sizeof(Datum) * nitems);
+	data->vertices = palloc(sizeof(Datum) * nitems);
+	data->edges = palloc(sizeof(Datum) * nitems);
+	data->paths = palloc(sizeof(Datum) * nitems);
+	data->start = make_jsonb("1");
+	data->length = make_jsonb("3");
+	data->key = psprintf("p%d", nprops / 2);
+
+	initStringInfo(&si);
+	for (i = 0; i < nitems; i++)
+	{
+		Graphid		id;
+		ItemPointerData *tid;
+		int			j;
+
+		GraphidSet(&id, vlabid, i + 1);
+		data->ids[i] = GraphidGetDatum(id);
+
+		resetStringInfo(&si);
+		appendStringInfoChar(&si, '{');
+		for (j = 0; j < nprops; j++)
+		{
+			if (j > 0)
+				appendStringInfoString(&si, ", ");
+			appendStringInfo(&si, "\"p%d\": ", j);
+			/* a mixed map cycles through the other shapes and booleans */
+			append_value(&si, (shape == BENCH_SHAPE_MIXED ?
+							   (BenchShape) (j % 4) : shape),
+						 (int64) i * nprops + j, slen);
+		}
+		appendStringInfoChar(&si, '}');
+		data->props[i] = make_jsonb(si.data);
+
+		resetStringInfo(&si);
+		append_value(&si, (shape == BENCH_SHAPE_FLOAT ?
+						   BENCH_SHAPE_FLOAT : BENCH_SHAPE_INT),
+					 i + 1, slen);
+		data->numbers[i] = make_jsonb(si.data);
+
+		resetStringInfo(&si);
+		append_value(&si, BENCH_SHAPE_STRING, i, slen);
+		data->strings[i] = make_jsonb(si.data);
+
+		tid = palloc(sizeof(*tid));
+		ItemPointerSet(tid, i / MaxHeapTuplesPerPage,
+					   i % MaxHeapTuplesPerPage + 1);
+
+		data->vertices[i] = makeGraphVertexDatum(data->ids[i], data->props[i],
+												 PointerGetDatum(tid));
+	}
+
+	for (i = 0; i < nitems; i++)
+	{
+		Graphid		id;
+		ItemPointerData *tid;
+
+		GraphidSet(&id, elabid, i + 1);
+		tid = palloc(sizeof(*tid));
+		ItemPointerSet(tid, i / MaxHeapTuplesPerPage,
+					   i % MaxHeapTuplesPerPage + 1);
+
+		data->edges[i] = makeGraphEdgeDatum(GraphidGetDatum(id),
+											data->ids[i],
+											data->ids[(i + 1) % nitems],
+											data->props[i],
+											PointerGetDatum(tid));
+	}
+
+	for (i = 0; i < nitems; i++)
+	{
+		Datum		vertices[BENCH_PATH_LENGTH];
+		Datum		edges[BENCH_PATH_LENGTH - 1];
+		int			j;
+
+		for (j = 0; j < BENCH_PATH_LENGTH; j++)
+			vertices[j] = data->vertices[(i + j) % nitems];
+		for (j = 0; j < BENCH_PATH_LENGTH - 1; j++)
+			edges[j] = data->edges[(i + j) % nitems];
+
+		data->paths[i] = makeGraphpathDatum(vertices, BENCH_PATH_LENGTH,
+											edges, BENCH_PATH_LENGTH - 1);
+	}
+
+	pfree(si.data);
+}
+
+static Datum
+make_jsonb(const char *str)
+{
+	return DirectFunctionCall1(jsonb_in, CStringGetDatum(str));
+}
+
+static void
+append_value(StringInfo si, BenchShape shape, int64 n, int slen)
+{
+	switch (shape)
+	{
+		case BENCH_SHAPE_INT:
+			appendStringInfo(si, INT64_FORMAT, n);
+			break;
+		case BENCH_SHAPE_FLOAT:
+			appendStringInfo(si, INT64_FORMAT ".25", n);
+			break;
+		case BENCH_SHAPE_STRING:
+			{
+				int			start = si->len + 1;
+
+				appendStringInfo(si, "\"s" INT64_FORMAT, n);
+				while (si->len - start < slen)
+					appendStringInfoChar(si, 'a' + (si->len - start) % 26);
+				appendStringInfoChar(si, '"');
+			}
+			break;
+		case BENCH_SHAPE_MIXED:
+			appendStringInfoString(si, (n % 2 == 0) ? "true" : "false");
+			break;
+	}
+}
+
+/*
+ * Build `$1.key` as the Cypher property access expression that
+ * cypher_access_object() evaluates.
+ */
+static ExprState *
+make_access_expr(const char *key, ParamListInfo params)
+{
+	CypherAccessExpr *access;
+	Param	   *param;
+
+	param = makeNode(Param);
+	param->paramkind = PARAM_EXTERN;
+	param->paramid = 1;
+	param->paramtype = JSONBOID;
+	param->paramtypmod = -1;
+	param->paramcollid = InvalidOid;
+	param->location = -1;
+
+	access = makeNode(CypherAccessExpr);
+	access->arg = (Expr *) param;
+	access->path = list_make1(makeConst(TEXTOID, -1, DEFAULT_COLLATION_OID,
+										-1, CStringGetTextDatum(key),
+										false, false));
+
+	return ExecInitExprWithParams((Expr *) access, params);
+}
+
+/*
+ * Call the function of a benchmark over the dataset `loops` times and return
+ * the number of calls. The first pass over the dataset warms the caches of
+ * the function up and is not measured. Allocations are left in `cc`, which
+ * is reset after each pass, outside of the measured time.
+ */
+static int64
+run_bench(const BenchFunc *bf, BenchData *data, int loops,
+		  CountingContext *cc, double *elapsed_ns)
+{
+	FmgrInfo	flinfo;
+	ExprState  *exprstate = NULL;
+	ExprContext *econtext = NULL;
+	ParamListInfo params = NULL;
+	int64		nallocs = 0;
+	int64		nbytes = 0;
+	instr_time	total;
+	int			loop;
+
+	if (bf->prosrc != NULL)
+	{
+		Oid			funcoid = fmgr_internal_function(bf->prosrc);
+
+		if (!OidIsValid(funcoid))
+			elog(ERROR, "internal function \"%s\" is not in internal lookup table",
+				 bf->prosrc);
+		fmgr_info(funcoid, &flinfo);
+	}
+	else
+	{
+		params = palloc0(offsetof(ParamListInfoData, params) +
+						 sizeof(ParamExternData));
+		params->numParams = 1;
+		params->params[0].ptype = JSONBOID;
+		params->params[0].isnull = false;
+
+		exprstate = make_access_expr(data->key, params);
+		econtext = CreateStandaloneExprContext();
+		econtext->ecxt_param_list_info = params;
+	}
+
+	INSTR_TIME_SET_ZERO(total);
+
+	/* loop 0 is the warm-up */
+	for (loop = 0; loop <= loops; loop++)
+	{
+		MemoryContext oldcxt;
+		instr_time	start;
+		instr_time	end;
+		int			i;
+
+		CHECK_FOR_INTERRUPTS();
+
+		cc->nallocs = 0;
+		cc->nbytes = 0;
+		oldcxt = MemoryContextSwitchTo((MemoryContext) cc);
+
+		INSTR_TIME_SET_CURRENT(start);
+
+		for (i = 0; i < data->nitems; i++)
+		{
+			int			next = (i + 1) % data->nitems;
+			bool		isnull;
+
+			switch (bf->args)
+			{
+				case BENCH_ARGS_IDS:
+					FunctionCall2(&flinfo, data->ids[i], data->ids[next]);
+					break;
+				case BENCH_ARGS_VERTEX:
+					FunctionCall1(&flinfo, data->vertices[i]);
+					break;
+				case BENCH_ARGS_EDGE:
+					FunctionCall1(&flinfo, data->edges[i]);
+					break;
+				case BENCH_ARGS_PATH:
+					FunctionCall1(&flinfo, data->paths[i]);
+					break;
+				case BENCH_ARGS_ACCESS:
+					params->params[0].value = data->props[i];
+					ExecEvalExpr(exprstate, econtext, &isnull);
+					break;
+				case BENCH_ARGS_NUMBERS:
+					FunctionCall2(&flinfo, data->numbers[i],
+								  data->numbers[next]);
+					break;
+				case BENCH_ARGS_NUMBER:
+					FunctionCall1(&flinfo, data->numbers[i]);
+					break;
+				case BENCH_ARGS_OBJECT:
+					FunctionCall1(&flinfo, data->props[i]);
+					break;
+				case BENCH_ARGS_STRING:
+					FunctionCall1Coll(&flinfo, DEFAULT_COLLATION_OID,
+									  data->strings[i]);
+					break;
+				case BENCH_ARGS_STRINGS:
+					FunctionCall2Coll(&flinfo, DEFAULT_COLLATION_OID,
+									  data->strings[i], data->strings[next]);
+					break;
+				case BENCH_ARGS_SUBSTR:
+					FunctionCall3Coll(&flinfo, DEFAULT_COLLATION_OID,
+									  data->strings[i], data->start,
+									  data->length);
+					break;
+			}
+		}
+
+		INSTR_TIME_SET_CURRENT(end);
+
+		MemoryContextSwitchTo(oldcxt);
+		MemoryContextReset((MemoryContext) cc);
+
+		if (loop > 0)
+		{
+			INSTR_TIME_ACCUM_DIFF(total, end, start);
+			nallocs += cc->nallocs;
+			nbytes += cc->nbytes;
+		}
+	}
+
+	if (econtext != NULL)
+		FreeExprContext(econtext, true);
+
+	cc->nallocs = nallocs;
+	cc->nbytes = nbytes;
+	*elapsed_ns = INSTR_TIME_GET_DOUBLE(total) * 1000000000.0;
+
+	return (int64) data->nitems * loops;
+}
+
+/*
+ * CountingContext
+ */
+
+static CountingContext *
+CountingContextCreate(MemoryContext parent)
+{
+	CountingContext *cc;
+
+	cc = (CountingContext *) malloc(sizeof(CountingContext));
+	if (cc == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_OUT_OF_MEMORY),
+				 errmsg("out of memory")));
+
+	cc->inner = AllocSetContextCreate(parent, "bench_graph_functions",
+									  ALLOCSET_DEFAULT_SIZES);
+	cc->nallocs = 0;
+	cc->nbytes = 0;
+
+	/*
+	 * MemoryContextIsValid() only accepts the known context types, so this
+	 * context poses as an AllocSet. Nothing looks at the type beyond that;
+	 * the chunks it returns belong to the real AllocSet `inner`.
+	 */
+	MemoryContextCreate((MemoryContext) cc, T_AllocSetContext,
+						&CountingMethods, parent, "bench_graph_functions");
+
+	return cc;
+}
+
+static void *
+CountingAlloc(MemoryContext context, Size size)
+{
+	CountingContext *cc = (CountingContext *) context;
+
+	cc->nallocs++;
+	cc->nbytes += size;
+
+	return MemoryContextAllocExtended(cc->inner, size,
+									  MCXT_ALLOC_HUGE | MCXT_ALLOC_NO_OOM);
+}
+
+static void
+CountingFree(MemoryContext context, void *pointer)
+{
+	elog(ERROR, "chunk does not belong to counting context");
+}
+
+static void *
+CountingRealloc(MemoryContext context, void *pointer, Size size)
+{
+	elog(ERROR, "chunk does not belong to counting context");
+	return NULL;				/* keep compiler quiet */
+}
+
+static void
+CountingReset(MemoryContext context)
+{
+	CountingContext *cc = (CountingContext *) context;
+
+	MemoryContextReset(cc->inner);
+}
+
+static void
+CountingDelete(MemoryContext context)
+{
+	/* `inner` is deleted on its own, possibly already */
+	free(context);
+}
+
+static Size
+CountingGetChunkSpace(MemoryContext context, void *pointer)
+{
+	elog(ERROR, "chunk does not belong to counting context");
+	return 0;					/* keep compiler quiet */
+}
+
+static bool
+CountingIsEmpty(MemoryContext context)
+{
+	CountingContext *cc = (CountingContext *) context;
+
+	return MemoryContextIsEmpty(cc->inner);
+}
+
+static void
+CountingStats(MemoryContext context, MemoryStatsPrintFunc printfunc,
+			  void *passthru, MemoryContextCounters *totals)
+{
+	CountingContext *cc = (CountingContext *) context;
+
+	if (printfunc)
+	{
+		char		stats_string[200];
+
+		snprintf(stats_string, sizeof(stats_string),
+				 INT64_FORMAT " allocations, " INT64_FORMAT " bytes requested",
+				 cc->nallocs, cc->nbytes);
+		printfunc(context, passthru, stats_string);
+	}
+}
+
+#ifdef MEMORY_CONTEXT_CHECKING
+static void
+CountingCheck(MemoryContext context)
+{
+	/* `inner` is checked on its own */
+}
+#endif
@@ -0,0 +1,265 @@
+--
+-- Graph algorithms
+--
+
+-- prepare
+SET client_min_messages TO WARNING;
+DROP GRAPH IF EXISTS algo CASCADE;
+CREATE GRAPH algo;
+SET graph_path = algo;
+
+CREATE (n1:node {id: 1})-[:link]->(n2:node {id: 2})-[:link]->(n3:node {id: 3}),
+	   (n1)-[:link]->(n3)-[:link]->(n1),
+	   (:node {id: 4})-[:link]->(n3),
+	   (:node {id: 5});
+
+-- pagerank()
+SELECT v.properties->>'id' AS node, round(p.score::numeric, 6) AS score
+FROM pagerank('algo', 'node', 'link') p JOIN algo.node v ON v.id = p.id
+ORDER BY 1;
+
+SELECT count(*), round(sum(score)::numeric, 6)
+FROM pagerank('algo', 'node', 'link');
+
+-- without vertex label, the vertices are the ends of the edges
+SELECT v.properties->>'id' AS node, round(p.score::numeric, 6) AS score
+FROM pagerank(NULL, NULL, 'link') p JOIN algo.node v ON v.id = p.id
+ORDER BY 1;
+
+SELECT v.properties->>'id' AS node, p.score
+FROM pagerank('algo', 'node', 'link', iterations => 0) p
+	 JOIN algo.node v ON v.id = p.id
+ORDER BY 1;
+
+SELECT * FROM pagerank('algo', 'node', 'link', 20, 1.5);
+SELECT * FROM pagerank('algo', 'node', 'link', -1);
+SELECT * FROM pagerank('algo', 'node', NULL);
+SELECT * FROM pagerank('algo', 'node', 'node');
+SELECT * FROM pagerank('algo', 'node', 'knows');
+SELECT * FROM pagerank('none', 'node', 'link');
+
+-- wcc()
+MATCH (n:node {id: 5})
+CREATE (n)-[:peer]->(:node {id: 6})-[:peer]->(:node {id: 7});
+
+SELECT v.properties->>'id' AS node, c.properties->>'id' AS component
+FROM wcc('algo', ARRAY['link', 'peer']) w
+	 JOIN algo.node v ON v.id = w.id
+	 JOIN algo.node c ON c.id = w.component
+ORDER BY 1;
+
+SELECT v.properties->>'id' AS node, c.properties->>'id' AS component
+FROM wcc('algo', ARRAY['peer']) w
+	 JOIN algo.node v ON v.id = w.id
+	 JOIN algo.node c ON c.id = w.component
+ORDER BY 1;
+
+SELECT count(DISTINCT component) FROM wcc(NULL, ARRAY['link']);
+SELECT * FROM wcc('algo', ARRAY[]::text[]);
+SELECT * FROM wcc('algo', ARRAY['node']);
+SELECT * FROM wcc('algo', NULL);
+
+-- triangle_count(), clustering_coefficient()
+SELECT triangle_count('algo', 'link'), triangle_count(NULL, 'peer');
+
+SELECT v.properties->>'id' AS node, c.triangles,
+	   round(c.coefficient::numeric, 4) AS coefficient
+FROM clustering_coefficient('algo', 'link') c JOIN algo.node v ON v.id = c.id
+ORDER BY 1;
+SELECT triangle_count('algo', 'node');
+
+-- reachable()
+SELECT a.properties->>'id' AS node,
+	   string_agg(b.properties->>'id', ',' ORDER BY b.properties->>'id') AS reaches
+FROM algo.node a, algo.node b
+WHERE reachable(a.id, b.id, 'link')
+GROUP BY 1 ORDER BY 1;
+SELECT a.properties->>'id' AS node,
+	   string_agg(b.properties->>'id', ',' ORDER BY b.properties->>'id') AS reaches
+FROM algo.node a, algo.node b
+WHERE reachable(a.id, b.id, 'peer')
+GROUP BY 1 ORDER BY 1;
+
+-- answered by the index of a graph projection
+SELECT graph_projection_create('link_reach', 'link', reachability => true);
+SELECT name, edge_label, reachability, vertices, edges, valid
+FROM graph_projections();
+SELECT a.properties->>'id' AS node,
+	   string_agg(b.properties->>'id', ',' ORDER BY b.properties->>'id') AS reaches
+FROM algo.node a, algo.node b
+WHERE reachable(a.id, b.id, 'link')
+GROUP BY 1 ORDER BY 1;
+
+-- so are EXISTS patterns of a path between bound vertices
+CREATE FUNCTION plan_probes_index(query text) RETURNS boolean AS $$
+DECLARE
+  line text;
+BEGIN
+  FOR line IN EXECUTE 'EXPLAIN (COSTS OFF) ' || query LOOP
+    IF line LIKE '%reachable_index%' THEN
+      RETURN true;
+    END IF;
+  END LOOP;
+  RETURN false;
+END;
+$$ LANGUAGE plpgsql;
+SELECT plan_probes_index($$
+MATCH (a:node), (b:node) WHERE exists((a)-[:link*]->(b)) RETURN a, b
+$$);
+MATCH (a:node), (b:node) WHERE exists((a)-[:link*]->(b))
+RETURN a.id AS src, b.id AS dst ORDER BY src, dst;
+MATCH (a:node {id: 4}), (b:node) WHERE NOT exists((b)<-[:link*]-(a))
+RETURN b.id AS dst ORDER BY dst;
+
+-- a stale projection is not used
+MATCH (a:node {id: 7}), (b:node {id: 4})
+CREATE (a)-[:link]->(b);
+SELECT name, edge_label, reachability, vertices, edges, valid
+FROM graph_projections();
+SELECT reachable(a.id, b.id, 'link') AS forward,
+	   reachable(b.id, a.id, 'link') AS backward
+FROM algo.node a, algo.node b
+WHERE a.properties->>'id' = '7' AND b.properties->>'id' = '1';
+MATCH (a:node {id: 7}), (b:node) WHERE exists((a)-[:link*]->(b))
+RETURN b.id AS dst ORDER BY dst;
+SELECT graph_projection_drop('link_reach');
+SELECT plan_probes_index($$
+MATCH (a:node), (b:node) WHERE exists((a)-[:link*]->(b)) RETURN a, b
+$$);
+DROP FUNCTION plan_probes_index(text);
+SELECT reachable(id, id, 'node') FROM algo.node;
+
+-- random_walks()
+SELECT s.properties->>'id' AS start, w.walk,
+	   (SELECT array_agg(v.properties->>'id' ORDER BY p.n)
+		FROM unnest(w.path) WITH ORDINALITY p(id, n)
+			 JOIN algo.node v ON v.id = p.id) AS path
+FROM random_walks('algo', 'peer', NULL, 3, 2) w
+	 JOIN algo.node s ON s.id = w.start
+ORDER BY 1, 2;
+
+-- vertices without edges of the label only visit themselves
+SELECT s.properties->>'id' AS start, count(*) AS walks,
+	   min(array_length(w.path, 1)), max(array_length(w.path, 1)),
+	   bool_and(w.path[1] = w.start) AS from_start
+FROM random_walks('algo', 'link', ARRAY(SELECT id FROM algo.node), 4, 10) w
+	 JOIN algo.node s ON s.id = w.start
+GROUP BY 1 ORDER BY 1;
+
+-- every step follows an edge
+SELECT count(*) AS steps,
+	   bool_and(EXISTS (SELECT 1 FROM algo.link e
+						WHERE e.start = w.path[i] AND e."end" = w.path[i + 1]))
+	   AS along_edges
+FROM random_walks(NULL, 'link', NULL, 4, 10) w,
+	 generate_series(1, array_length(w.path, 1) - 1) i;
+
+-- setseed() makes the walks repeatable
+SELECT setseed(0.5);
+CREATE TEMP TABLE walks AS
+  SELECT * FROM random_walks('algo', 'link', walk_length => 8,
+							 walks_per_vertex => 5);
+SELECT setseed(0.5);
+SELECT count(*)
+FROM random_walks('algo', 'link', walk_length => 8, walks_per_vertex => 5) w
+	 JOIN walks USING (start, walk)
+WHERE w.path = walks.path;
+DROP TABLE walks;
+
+SELECT * FROM random_walks('algo', 'link', NULL, -1, 1);
+SELECT * FROM random_walks('algo', 'link', NULL, 4, 0);
+SELECT * FROM random_walks('algo', 'link', NULL, NULL, 1);
+SELECT * FROM random_walks('algo', 'link', ARRAY[NULL]::graphid[], 4, 1);
+SELECT * FROM random_walks('algo', 'node');
+
+-- reachable() keeps its index only for the snapshot it was built with
+CREATE FUNCTION reachable_before_after(p_from graphid, p_to graphid)
+RETURNS text AS $$
+DECLARE
+  result text := '';
+  i int;
+BEGIN
+  FOR i IN 1..2 LOOP
+    result := result ||
+              CASE WHEN reachable(p_from, p_to, 'peer') THEN 't' ELSE 'f' END;
+    MATCH (x:node {id: 7}), (y:node {id: 5}) CREATE (x)-[:peer]->(y);
+  END LOOP;
+  RETURN result;
+END;
+$$ LANGUAGE plpgsql;
+SELECT reachable_before_after(a.id, b.id)
+FROM algo.node a, algo.node b
+WHERE a.properties->>'id' = '7' AND b.properties->>'id' = '5';
+DROP FUNCTION reachable_before_after(graphid, graphid);
+
+-- a projection answers only for users that may read the label
+SELECT graph_projection_create('link_reach', 'link', reachability => true);
+SELECT id AS n7 FROM algo.node WHERE properties->>'id' = '7' \gset
+SELECT id AS n1 FROM algo.node WHERE properties->>'id' = '1' \gset
+CREATE ROLE regress_algo_reader;
+GRANT USAGE ON SCHEMA algo TO regress_algo_reader;
+SET ROLE regress_algo_reader;
+SELECT reachable(:'n7', :'n1', 'link');
+RESET ROLE;
+SELECT reachable(:'n7', :'n1', 'link');
+SELECT graph_projection_drop('link_reach');
+
+-- parallel workers give the same results as the backend alone
+CREATE VLABEL big;
+CREATE ELABEL big_link;
+INSERT INTO algo.big (properties)
+SELECT jsonb_build_object('id', i) FROM generate_series(0, 9999) i;
+-- rings of 100 vertices, each vertex linked to the next two
+INSERT INTO algo.big_link (start, "end", properties)
+SELECT a.id, b.id, '{}'
+FROM algo.big a, generate_series(1, 2) d, algo.big b
+WHERE (b.properties->>'id')::int =
+	  (a.properties->>'id')::int / 100 * 100 +
+	  ((a.properties->>'id')::int + d) % 100;
+
+SET max_parallel_workers_per_gather = 0;
+CREATE TEMP TABLE big_pagerank AS
+  SELECT id, round(score::numeric, 10) AS score
+  FROM pagerank('algo', 'big', 'big_link');
+CREATE TEMP TABLE big_wcc AS
+  SELECT * FROM wcc('algo', ARRAY['big_link']);
+CREATE TEMP TABLE big_clustering AS
+  SELECT id, triangles, round(coefficient::numeric, 10) AS coefficient
+  FROM clustering_coefficient('algo', 'big_link');
+SELECT triangle_count('algo', 'big_link') AS big_triangles \gset
+SELECT setseed(0.5);
+CREATE TEMP TABLE big_walks AS
+  SELECT * FROM random_walks('algo', 'big_link', NULL, 8, 2);
+
+SET max_parallel_workers_per_gather = 2;
+SELECT count(*) AS vertices,
+	   count(*) FILTER (WHERE s.score IS DISTINCT FROM p.score) AS differ
+FROM big_pagerank s
+	 FULL JOIN (SELECT id, round(score::numeric, 10) AS score
+				FROM pagerank('algo', 'big', 'big_link')) p USING (id);
+SELECT count(*) AS vertices, count(DISTINCT s.component) AS components,
+	   count(*) FILTER (WHERE s.component IS DISTINCT FROM p.component)
+	   AS differ
+FROM big_wcc s FULL JOIN wcc('algo', ARRAY['big_link']) p USING (id);
+SELECT count(*) AS vertices,
+	   count(*) FILTER (WHERE s.triangles IS DISTINCT FROM p.triangles OR
+								s.coefficient IS DISTINCT FROM p.coefficient)
+	   AS differ
+FROM big_clustering s
+	 FULL JOIN (SELECT id, triangles,
+					   round(coefficient::numeric, 10) AS coefficient
+				FROM clustering_coefficient('algo', 'big_link')) p
+	 USING (id);
+SELECT triangle_count('algo', 'big_link') = :big_triangles AS same_triangles;
+SELECT setseed(0.5);
+SELECT count(*) AS walks,
+	   count(*) FILTER (WHERE s.path IS DISTINCT FROM p.path) AS differ
+FROM big_walks s
+	 FULL JOIN random_walks('algo', 'big_link', NULL, 8, 2) p
+	 USING (start, walk);
+RESET max_parallel_workers_per_gather;
+DROP TABLE big_pagerank, big_wcc, big_clustering, big_walks;
+
+-- cleanup
+DROP GRAPH algo CASCADE;
+DROP ROLE regress_algo_reader;
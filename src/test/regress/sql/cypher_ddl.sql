@@ -361,6 +361,121 @@ CREATE CONSTRAINT ON regv8 ASSERT (SELECT * FROM graph.regv8).c IS NOT NULL;
 CREATE CONSTRAINT ON regv8 ASSERT (1).c IS NOT NULL;
 CREATE CONSTRAINT ON regv8 ASSERT ($1).c IS NOT NULL;
 
+-- promoted property
+
+CREATE VLABEL regv9;
+
+CREATE (:regv9 {age: 10});
+CREATE (:regv9 {age: 20, name: 'agens'});
+CREATE (:regv9 {name: 'graph'});
+
+ALTER VLABEL regv9 PROMOTE PROPERTY age AS int;
+SELECT age FROM ddl.regv9 ORDER BY age;
+
+CREATE (:regv9 {age: 30});
+MATCH (n:regv9) WHERE n.age = 30 SET n.age = 40;
+SELECT age FROM ddl.regv9 ORDER BY age;
+
+MATCH (n:regv9) WHERE n.age > 15 RETURN n.age AS age ORDER BY age;
+MATCH (n:regv9) WHERE 15 > n.age RETURN n.age AS age;
+MATCH (n:regv9) WHERE n.age > 15.5 RETURN n.age AS age ORDER BY age;
+
+CREATE (:regv9 {age: 'old'});
+CREATE (:regv9 {age: 1.5});
+ALTER VLABEL regv9 PROMOTE PROPERTY name AS point;
+
+-- promoted columns are found by their constraints, not by position
+ALTER TABLE ddl.regv9 ADD COLUMN note text;
+ALTER VLABEL regv9 PROMOTE PROPERTY "camelCase" AS int;
+CREATE (:regv9 {age: 50, camelCase: 5, note: 'ignored'});
+SELECT age, "camelCase", note FROM ddl.regv9 WHERE age = 50;
+MATCH (n:regv9) WHERE n.camelCase = 5 RETURN n.age AS age;
+
+-- element attributes are right for labels with added and dropped columns
+CREATE ELABEL rege9;
+ALTER TABLE ddl.rege9 ADD COLUMN dummy int;
+MATCH (a:regv9 {age: 50}), (b:regv9 {age: 40}) CREATE (a)-[:rege9 {w: 1}]->(b);
+ALTER TABLE ddl.regv9 DROP COLUMN note;
+ALTER TABLE ddl.rege9 DROP COLUMN dummy;
+MATCH (a:regv9)-[r:rege9]->(b:regv9)
+RETURN a.age AS a, properties(r) AS r, b.age AS b,
+       id(startnode(r)) = id(a) AS s, id(endnode(r)) = id(b) AS e;
+
+-- label id sequences hand out ids in batches that do not collide
+CREATE VLABEL seqv;
+SELECT cache_size FROM pg_sequences
+WHERE schemaname = 'ddl' AND sequencename = 'seqv_id_seq';
+CREATE (:seqv {n: 1}), (:seqv {n: 2});
+DISCARD SEQUENCES;
+CREATE (:seqv {n: 3});
+SELECT count(DISTINCT id) AS ids,
+       bool_and(graphid_labid(id) = l.labid) AS labid_ok
+FROM ddl.seqv, pg_catalog.ag_label l
+WHERE l.relid = 'ddl.seqv'::regclass;
+SELECT properties->'n' AS n, graphid_locid(id) AS locid FROM ddl.seqv ORDER BY 1;
+DROP VLABEL seqv;
+
+-- property access on expression index
+
+CREATE VLABEL regv10;
+CREATE INDEX regv10_ts_idx ON ddl.regv10 ((properties -> 'ts'));
+
+CREATE (:regv10 {ts: 10}), (:regv10 {ts: 20}), (:regv10 {ts: 30});
+INSERT INTO ddl.regv10 (properties) VALUES ('{"ts": null}');
+
+SET enable_seqscan = off;
+SET enable_bitmapscan = off;
+
+EXPLAIN (COSTS OFF) MATCH (n:regv10) WHERE n.ts > 15 RETURN n.ts;
+MATCH (n:regv10) WHERE n.ts > 15 RETURN n.ts AS ts ORDER BY ts;
+MATCH (n:regv10) WHERE n.ts < 25 RETURN n.ts AS ts ORDER BY ts;
+MATCH (n:regv10 {ts: 20}) RETURN n.ts AS ts;
+
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+
+-- plan cache of Cypher statements
+
+SET cypher_plan_cache_size = 2;
+MATCH (n:regv10) WHERE n.ts > 15 RETURN n.ts AS ts ORDER BY ts;
+CREATE (:regv10 {ts: 40});
+MATCH (n:regv10) WHERE n.ts > 15 RETURN n.ts AS ts ORDER BY ts;
+DROP INDEX ddl.regv10_ts_idx;
+MATCH (n:regv10) WHERE n.ts > 15 RETURN n.ts AS ts ORDER BY ts;
+
+CREATE GRAPH ddl2;
+SET graph_path = ddl2;
+CREATE VLABEL regv10;
+MATCH (n:regv10) WHERE n.ts > 15 RETURN n.ts AS ts ORDER BY ts;
+SET graph_path = ddl;
+DROP GRAPH ddl2 CASCADE;
+MATCH (n:regv10) WHERE n.ts > 15 RETURN n.ts AS ts ORDER BY ts;
+
+-- cached CREATE and MERGE have their effects every time
+CREATE (:regv10 {ts: 50});
+CREATE (:regv10 {ts: 50});
+MATCH (n:regv10 {ts: 50}) RETURN count(n) AS cnt;
+MERGE (n:regv10 {ts: 60})
+  ON CREATE SET n.merged = 1 ON MATCH SET n.merged = n.merged + 1;
+MERGE (n:regv10 {ts: 60})
+  ON CREATE SET n.merged = 1 ON MATCH SET n.merged = n.merged + 1;
+MATCH (n:regv10 {ts: 60}) RETURN count(n) AS cnt, n.merged AS merged;
+
+-- the cache is keyed on search_path
+CREATE SCHEMA cpc1;
+CREATE SCHEMA cpc2;
+CREATE FUNCTION cpc1.cpc_f() RETURNS jsonb AS $$SELECT '1'::jsonb$$ LANGUAGE sql;
+CREATE FUNCTION cpc2.cpc_f() RETURNS jsonb AS $$SELECT '2'::jsonb$$ LANGUAGE sql;
+SET search_path = cpc1, public;
+RETURN cpc_f() AS v;
+SET search_path = cpc2, public;
+RETURN cpc_f() AS v;
+RESET search_path;
+DROP FUNCTION cpc1.cpc_f(), cpc2.cpc_f();
+DROP SCHEMA cpc1, cpc2;
+
+RESET cypher_plan_cache_size;
+
 --
 -- DROP GRAPH
 --
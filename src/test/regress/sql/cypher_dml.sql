@@ -1343,6 +1343,9 @@ DROP GRAPH ag189 CASCADE;
 --
 
 UNWIND [1, 2, 3] AS i RETURN i;
+UNWIND [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69] AS i WITH i WHERE i >= 62 RETURN i;
+UNWIND 1 AS i RETURN i;
+UNWIND {a: 1} AS i RETURN i;
 
 CREATE GRAPH test_unwind;
 CREATE ({a: [1, 2, 3]}), ({a: [4, 5, 6]});
@@ -1392,6 +1395,69 @@ MATCH p=((u)-[*..3]->(v)) RETURN p LIMIT 5; -- crash
 
 DROP GRAPH asterisk CASCADE;
 
+-- Cypher clause subqueries are flattened into one FROM list
+
+CREATE GRAPH flat;
+SET graph_path = flat;
+CREATE VLABEL v;
+CREATE (:v {x: 1, y: 1}), (:v {x: 2, y: 2});
+
+CREATE FUNCTION has_nestloop(query text) RETURNS bool AS $$
+DECLARE
+  ln text;
+BEGIN
+  FOR ln IN EXECUTE 'EXPLAIN (COSTS OFF) ' || query LOOP
+    IF ln ~ 'Nested Loop' THEN
+      RETURN true;
+    END IF;
+  END LOOP;
+  RETURN false;
+END;
+$$ LANGUAGE plpgsql;
+
+-- a and c have no join clause, so only a plan that joins b first avoids a
+-- cartesian product
+SET from_collapse_limit = 1;
+SET enable_nestloop = off;
+SELECT has_nestloop($$
+MATCH (a:v), (c:v) MATCH (b:v) WHERE a.x = b.x AND b.y = c.y
+RETURN a, b, c
+$$);
+-- an SQL subquery that happens to be aliased "_" is not flattened
+SELECT has_nestloop($$
+SELECT * FROM (SELECT a.properties AS ap, c.properties AS cp
+               FROM flat.v a, flat.v c) AS _, flat.v b
+WHERE _.ap->'x' = b.properties->'x' AND b.properties->'y' = _.cp->'y'
+$$);
+RESET enable_nestloop;
+RESET from_collapse_limit;
+
+DROP FUNCTION has_nestloop(text);
+
+-- length() and nodes() of a path do not build the path
+CREATE (:v {x: 3})-[:r]->(:v {x: 4});
+
+CREATE FUNCTION builds_path(query text) RETURNS bool AS $$
+DECLARE
+  ln text;
+BEGIN
+  FOR ln IN EXECUTE 'EXPLAIN (VERBOSE, COSTS OFF) ' || query LOOP
+    IF ln ~ '::graphpath' THEN
+      RETURN true;
+    END IF;
+  END LOOP;
+  RETURN false;
+END;
+$$ LANGUAGE plpgsql;
+
+SELECT builds_path($$MATCH p=(:v)-[:r]->(:v) RETURN p$$);
+SELECT builds_path($$MATCH p=(:v)-[:r]->(:v) RETURN length(p), nodes(p)$$);
+MATCH p=(:v)-[:r]->(:v)
+RETURN length(p) AS len, properties(nodes(p)[1]) AS last;
+
+DROP FUNCTION builds_path(text);
+DROP GRAPH flat CASCADE;
+
 -- cleanup
 
 DROP GRAPH srf CASCADE;
@@ -53,6 +53,12 @@ RETURN '1' + '1', '1' + 1, 1 + '1';
 
 -- Arithmetic operation
 RETURN 1 + 1, 1 - 1, 2 * 2, 2 / 2, 2 % 2, 2 ^ 2, +1, -1;
+RETURN 7 / 2, -7 / 2, 7 % -2, -7 % 2, 2 ^ 10, 7.0 / 2, 1.5 + 1;
+RETURN 9223372036854775807 + 1, -9223372036854775808 - 1,
+       3037000500 * 3037000500, 2 ^ 63, -(-9223372036854775808);
+RETURN 0 ^ 4294967296, 1 ^ 4294967296, 2 ^ 64;
+RETURN (-1) ^ 4294967296;
+RETURN 1 / 0;
 
 -- List concatenation
 RETURN 's' + [], 0 + [], true + [],
@@ -216,6 +222,8 @@ MATCH (n:v0) RETURN n.l[0], n.l[6][0],
                     n.l[6][-4..], n.l[6][..-2], n.l[6][-4..-2],
                     n.l[6][1..6], n.l[6][-7..-2], n.l[6][1..3][0],
                     n.l[7].p,n.l[7].'p', n.l[7]['p'];
+UNWIND [{a: 1, b: 2}, {b: 3, c: 4}, {b: 5}, {a: 6}, {}, {bb: 7, b: 8}] AS m
+RETURN m.b;
 
 -- Null test
 RETURN '' IS NULL, '' IS NOT NULL, NULL IS NULL, NULL IS NOT NULL;
@@ -291,6 +299,7 @@ RETURN [x IN [0, 1, 2, 3, 4]];
 RETURN [x IN [0, 1, 2, 3, 4] WHERE x % 2 = 0];
 RETURN [x IN [0, 1, 2, 3, 4] | x + 1];
 RETURN [x IN [0, 1, 2, 3, 4] WHERE x % 2 = 0 | x + 1];
+RETURN [x IN [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99] WHERE x % 10 = 0 | x];
 -- nested use of variables
 RETURN [x IN [[0], [1]] WHERE length([y IN x]) = 1 | [y IN x]];
 
@@ -316,6 +325,17 @@ RETURN SINGLE(x in [0, 1, 2, 3, 4] WHERE x = 0);
 RETURN SINGLE(x in [0, 1, 2, 3, 4] WHERE x >= 0);
 RETURN SINGLE(x in [0, 1, 2, 3, 4] WHERE x = 5);
 
+-- Sort order of values of different types
+
+UNWIND [{a: 1}, [1, 2], true, 123456789012346, 'ba', null, 1.5, [], 'a', {},
+        false, -2, 0.000001, 'b', [1], 0, 123456789012345] AS x
+RETURN x ORDER BY x;
+
+-- NaN becomes a string in jsonb and sorts among strings
+SELECT x FROM (VALUES (to_jsonb(1)), (to_jsonb('NaN'::numeric)), ('-1.5'),
+                      (to_jsonb('NaN'::numeric)), ('"N"')) AS t(x)
+ORDER BY x;
+
 -- Functions
 
 CREATE (:coll {name: 'AgensGraph'});
@@ -36,6 +36,12 @@ MATCH (n) RETURN n.name, labels(n)[0];
 MATCH (n:c) RETURN n.name, labels(n)[1];
 MATCH (n:d) RETURN n.name, labels(n)[2], labels(n)[3];
 
+-- renamed labels must not be served from the label cache
+ALTER VLABEL a RENAME TO aa;
+MATCH (n:c) RETURN n.name, label(n), labels(n);
+ALTER VLABEL aa RENAME TO a;
+MATCH (n:c) RETURN n.name, label(n), labels(n);
+
 -- complex test 1
 
 SET graph_path = vertex_labels_complex1;
@@ -187,3 +193,45 @@ RETURN toBoolean('TRUE');
 
 -- cleanup
 DROP GRAPH AG283 CASCADE;
+
+-- binary output of vertex and edge
+CREATE GRAPH binio;
+SET graph_path = binio;
+CREATE VLABEL v;
+CREATE ELABEL e;
+CREATE (:v {name: 'a'});
+CREATE (:v {name: 'b'});
+MATCH (a:v {name: 'a'}), (b:v {name: 'b'}) CREATE (a)-[:e {w: 1}]->(b);
+SELECT vertex_send((id, properties, NULL)::vertex) FROM binio.v ORDER BY id;
+SELECT edge_send((id, start, "end", properties, NULL)::edge) FROM binio.e;
+
+-- binary round trip of vertex, edge and graphpath
+CREATE TABLE binio_t (v vertex, e edge, p graphpath);
+INSERT INTO binio_t
+SELECT (a.id, a.properties, a.ctid)::vertex,
+       (r.id, r.start, r."end", r.properties, r.ctid)::edge,
+       (ARRAY[(a.id, a.properties, a.ctid)::vertex,
+              (b.id, b.properties, b.ctid)::vertex],
+        ARRAY[(r.id, r.start, r."end", r.properties, r.ctid)::edge])::graphpath
+FROM binio.v a, binio.e r, binio.v b
+WHERE a.id = r.start AND b.id = r."end";
+SELECT current_setting('data_directory') || '/binio_t.bin' AS binio_file \gset
+COPY binio_t TO :'binio_file' (FORMAT binary);
+CREATE TABLE binio_t2 (LIKE binio_t);
+COPY binio_t2 FROM :'binio_file' (FORMAT binary);
+SELECT * FROM binio_t2;
+SELECT t1.v::text = t2.v::text AND t1.e::text = t2.e::text AND
+       t1.p::text = t2.p::text AS same
+FROM binio_t t1, binio_t2 t2;
+
+-- a graphpath without vertices but with an edge
+SELECT current_setting('data_directory') || '/binio_bad.bin' AS binio_bad \gset
+SELECT lo_from_bytea(0, '\x5047434f50590aff0d0a0000000000000000000001000000140000000000000000000000010000000000000000ffff'::bytea) AS binio_lo \gset
+SELECT lo_export(:binio_lo, :'binio_bad');
+SELECT lo_unlink(:binio_lo);
+CREATE TABLE binio_p (p graphpath);
+COPY binio_p FROM :'binio_bad' (FORMAT binary);
+DROP TABLE binio_t, binio_t2, binio_p;
+
+-- cleanup
+DROP GRAPH binio CASCADE;
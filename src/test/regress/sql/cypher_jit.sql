@@ -0,0 +1,58 @@
+--
+-- Cypher Query Language - JIT Compilation
+--
+
+-- skip this test if the server is built without LLVM
+SET jit = on;
+SELECT NOT pg_jit_available() AS skip_test \gset
+\if :skip_test
+\quit
+\endif
+
+-- Set up
+CREATE GRAPH cypher_jit;
+SET graph_path = cypher_jit;
+
+SET jit_above_cost = 0;
+SET jit_inline_above_cost = 0;
+SET jit_optimize_above_cost = 0;
+
+CREATE (:v {id: 1, name: 'a', list: [1, 2, 3], map: {k: 'x'}}),
+       (:v {id: 2, name: 'b', list: [4, 5], map: {k: 'y'}});
+
+CREATE FUNCTION jit_used(query text) RETURNS bool AS $$
+DECLARE
+  ln text;
+BEGIN
+  FOR ln IN EXECUTE
+    'EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF, SUMMARY OFF) ' || query LOOP
+    IF ln ~ '^JIT:' THEN
+      RETURN true;
+    END IF;
+  END LOOP;
+  RETURN false;
+END;
+$$ LANGUAGE plpgsql;
+
+-- map, list, type cast, property access and list comprehension
+SELECT jit_used($$
+MATCH (n:v)
+RETURN {id: n.id, k: n.map.k}, [n.name, n.list[0]], n.list::bool,
+       [x IN n.list WHERE x > 1 | x * 10]
+$$);
+MATCH (n:v)
+RETURN n.id AS id, {id: n.id, k: n.map.k} AS map,
+       [n.name, n.list[0]] AS list, n.list::bool AS b,
+       [x IN n.list WHERE x > 1 | x * 10] AS comp
+ORDER BY id;
+MATCH (n:v) WHERE n.map.k = 'y' RETURN n.name AS name;
+
+-- cleanup
+DROP FUNCTION jit_used(text);
+
+RESET jit_optimize_above_cost;
+RESET jit_inline_above_cost;
+RESET jit_above_cost;
+RESET jit;
+
+DROP GRAPH cypher_jit CASCADE;
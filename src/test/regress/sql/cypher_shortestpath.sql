@@ -181,13 +181,100 @@ MATCH (v1:v {id: 0}), (v2:v {id: 3}),
 	  (path, x)=dijkstra((v1)-[e:e]->(v2), e.weight, LIMIT 0)
 RETURN nodes(path), x;
 
+-- graph projections
+SELECT graph_projection_create('e_proj', 'e', 'weight');
+SELECT name, graph, edge_label, vertex_label, weight, vertices, edges, valid
+FROM graph_projections();
+
+MATCH (v1:v {id: 0}), (v2:v {id: 3}),
+	  (path, x)=dijkstra((v1)-[e:e]->(v2), e.weight, LIMIT 2)
+RETURN nodes(path), x;
+
+MATCH (v1:v {id: 0}), (v2:v {id: 3}),
+	  (path, x)=dijkstra((v2)<-[e:e]->(v1), e.weight, LIMIT 2)
+RETURN nodes(path), x;
+
+-- EXPLAIN ANALYZE shows the projection that Dijkstra used
+CREATE FUNCTION explain_analyze(query text, format text DEFAULT 'text')
+RETURNS SETOF text AS $$
+DECLARE
+  ln text;
+BEGIN
+  FOR ln IN EXECUTE
+    'EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF, SUMMARY OFF, FORMAT ' ||
+    format || ') ' || query
+  LOOP
+    IF format = 'text' THEN
+      -- the counts and memory sizes depend on the plan and the platform
+      ln := regexp_replace(ln, 'Spilled Batches: [1-9]\d*',
+                           'Spilled Batches: some');
+      ln := regexp_replace(btrim(ln), '\d+', 'N', 'g');
+      ln := regexp_replace(ln, 'N(, N)+', 'N', 'g');
+    END IF;
+    RETURN NEXT ln;
+  END LOOP;
+END;
+$$ LANGUAGE plpgsql;
+
+SELECT c FROM explain_analyze($$
+MATCH (v1:v {id: 0}), (v2:v {id: 3}),
+	  (path, x)=dijkstra((v1)-[e:e]->(v2), e.weight, LIMIT 2)
+RETURN nodes(path), x
+$$) c WHERE c ~ '^Projection:';
+
+-- only the owner of the label can manage its projections
+CREATE ROLE regress_sp_reader;
+GRANT USAGE ON SCHEMA sp TO regress_sp_reader;
+GRANT SELECT ON ALL TABLES IN SCHEMA sp TO regress_sp_reader;
+SET ROLE regress_sp_reader;
+SELECT graph_projection_create('e_proj2', 'e');
+SELECT graph_projection_refresh('e_proj');
+SELECT graph_projection_drop('e_proj');
+SELECT c FROM explain_analyze($$
+MATCH (v1:v {id: 0}), (v2:v {id: 3}),
+	  (path, x)=dijkstra((v1)-[e:e]->(v2), e.weight, LIMIT 2)
+RETURN nodes(path), x
+$$) c WHERE c ~ '^Projection:';
+RESET ROLE;
+
+-- a user that row-level security applies to does not use projections
+ALTER TABLE sp.e ENABLE ROW LEVEL SECURITY;
+CREATE POLICY e_all ON sp.e USING (true);
+SET ROLE regress_sp_reader;
+SELECT c FROM explain_analyze($$
+MATCH (v1:v {id: 0}), (v2:v {id: 3}),
+	  (path, x)=dijkstra((v1)-[e:e]->(v2), e.weight, LIMIT 2)
+RETURN nodes(path), x
+$$) c WHERE c ~ '^Projection:';
+RESET ROLE;
+DROP POLICY e_all ON sp.e;
+ALTER TABLE sp.e DISABLE ROW LEVEL SECURITY;
+
+-- the total size of projections is limited
+SET graph_projection_memory = 0;
+SELECT graph_projection_create('e_proj2', 'e');
+RESET graph_projection_memory;
+
+SELECT graph_projection_create('e_proj', 'e');
+
 MATCH (:v {id: 4})-[e:e]-(:v {id: 6})
 SET e.weight = -1;
+SELECT name, valid FROM graph_projections();
+
+MATCH (v1:v {id: 0}), (v2:v {id: 3}),
+	  (path, x)=dijkstra((v1)-[e:e]->(v2), e.weight, LIMIT 10)
+return nodes(path), x;
+
+SELECT graph_projection_refresh('e_proj');
+SELECT name, valid FROM graph_projections();
 
 MATCH (v1:v {id: 0}), (v2:v {id: 3}),
 	  (path, x)=dijkstra((v1)-[e:e]->(v2), e.weight, LIMIT 10)
 return nodes(path), x;
 
+SELECT graph_projection_drop('e_proj');
+SELECT count(*) FROM graph_projections();
+
 -- AG-81
 MATCH p= DIJKSTRA((a:v)-[:e]->(b:v), 1) WHERE a.id = 1
 RETURN p;
@@ -197,6 +284,79 @@ RETURN p;
 
 MATCH p= DIJKSTRA((a:v)-[r:e]->(b:v), 1, r.weight < 5, LIMIT 1) WHERE a.id = 1
 RETURN p;
+
+-- EXPLAIN ANALYZE shows the traversal counters of graph traversal nodes
+
+SELECT DISTINCT c FROM explain_analyze($$
+MATCH (a:v {id: 0})-[:e*1..2]->(b:v) RETURN count(*)
+$$) c WHERE c ~ '^(Traversal|Frontier Sizes):' ORDER BY c;
+
+SELECT DISTINCT c FROM explain_analyze($$
+MATCH (a:v {id: 0}), (b:v {id: 3})
+RETURN length(shortestpath((a)-[:e*]->(b)))
+$$) c WHERE c ~ '^(Traversal|Frontier Sizes):' ORDER BY c;
+
+SELECT DISTINCT c FROM explain_analyze($$
+MATCH (v1:v {id: 0}), (v2:v {id: 3}),
+	  (path, x)=dijkstra((v1)-[e:e]->(v2), e.weight, LIMIT 2)
+RETURN nodes(path), x
+$$) c WHERE c ~ '^(Traversal|Peak Memory Usage):' ORDER BY c;
+
+-- and in the other formats
+WITH RECURSIVE plans(node) AS (
+  SELECT (j::jsonb)->0->'Plan' FROM explain_analyze($$
+MATCH (v1:v {id: 0}), (v2:v {id: 3}),
+	  (path, x)=dijkstra((v1)-[e:e]->(v2), e.weight, LIMIT 2)
+RETURN nodes(path), x
+$$, 'json') j
+  UNION ALL
+  SELECT c FROM plans, jsonb_array_elements(plans.node->'Plans') c
+)
+SELECT DISTINCT node->>'Node Type' AS node, k AS key
+FROM plans, jsonb_object_keys(node) k
+WHERE k ~ ('^(Vertices Expanded|Edges Examined|Inner Rescans|Max Depth|' ||
+			'Frontier Sizes|Peak (Visited|Queue) Memory Usage|' ||
+			'(Bucket|Batch) Increases|Spilled Batches)$')
+ORDER BY 1, 2;
+
+WITH RECURSIVE plans(node) AS (
+  SELECT (j::jsonb)->0->'Plan' FROM explain_analyze($$
+MATCH (a:v {id: 0}), (b:v {id: 3})
+RETURN length(shortestpath((a)-[:e*]->(b)))
+$$, 'json') j
+  UNION ALL
+  SELECT c FROM plans, jsonb_array_elements(plans.node->'Plans') c
+)
+SELECT DISTINCT node->>'Node Type' AS node, k AS key
+FROM plans, jsonb_object_keys(node) k
+WHERE k ~ ('^(Vertices Expanded|Edges Examined|Inner Rescans|Max Depth|' ||
+			'Frontier Sizes|Peak (Visited|Queue) Memory Usage|' ||
+			'(Bucket|Batch) Increases|Spilled Batches)$')
+ORDER BY 1, 2;
+
+-- a hash table of Shortestpath that does not fit in work_mem spills
+CREATE VLABEL sv;
+CREATE ELABEL se;
+INSERT INTO sp.sv (properties)
+SELECT jsonb_build_object('id', i) FROM generate_series(-1, 10000) i;
+INSERT INTO sp.se (start, "end", properties)
+SELECT (SELECT id FROM sp.sv WHERE properties->'id' = '0'), id, '{}'
+FROM sp.sv WHERE (properties->>'id')::int > 0;
+INSERT INTO sp.se (start, "end", properties)
+SELECT id, (SELECT id FROM sp.sv WHERE properties->'id' = '-1'), '{}'
+FROM sp.sv WHERE (properties->>'id')::int > 0;
+SET work_mem = '64kB';
+SELECT bool_or(c ~ '^Hash Growth: .* Spilled Batches: some') AS spilled
+FROM explain_analyze($$
+MATCH (a:sv {id: 0}), (b:sv {id: -1})
+RETURN length(shortestpath((a)-[:se*]->(b)))
+$$) c;
+RESET work_mem;
+DROP ELABEL se;
+DROP VLABEL sv;
+DROP FUNCTION explain_analyze(text, text);
+
 -- cleanup
 
 DROP GRAPH sp CASCADE;
+DROP ROLE regress_sp_reader;
@@ -1182,3 +1182,15 @@ select '12345.0000000000000000000000000000000000000000000005'::jsonb::float8;
 select '12345.0000000000000000000000000000000000000000000005'::jsonb::int2;
 select '12345.0000000000000000000000000000000000000000000005'::jsonb::int4;
 select '12345.0000000000000000000000000000000000000000000005'::jsonb::int8;
+
+-- field access on out-of-line, uncompressed jsonb reads only needed parts
+CREATE TABLE test_jsonb_external (j jsonb);
+ALTER TABLE test_jsonb_external ALTER COLUMN j SET STORAGE EXTERNAL;
+INSERT INTO test_jsonb_external
+SELECT jsonb_build_object('a', 1, 'big', repeat('x', 10000),
+                          'obj', jsonb_build_object('k', 'v'),
+                          'n', NULL, 's', '', 't', true);
+SELECT j -> 'a', j -> 'obj', j ->> 'obj', j -> 'n', j ->> 's', j -> 't',
+       j -> 'none', length(j ->> 'big')
+FROM test_jsonb_external;
+DROP TABLE test_jsonb_external;
@@ -135,6 +135,30 @@ TRUNCATE trunc_stats_test4;
 INSERT INTO trunc_stats_test4 DEFAULT VALUES;
 ROLLBACK;
 
+-- count graph elements created and matched by MERGE
+CREATE GRAPH stats_graph;
+SET graph_path = stats_graph;
+CREATE VLABEL stats_v;
+CREATE ELABEL stats_e;
+CREATE (:stats_v {id: 1});
+MERGE (:stats_v {id: 1});
+MERGE (:stats_v {id: 2});
+MERGE (:stats_v {id: 1})-[:stats_e]->(:stats_v {id: 2});
+MERGE (:stats_v {id: 1})-[:stats_e]->(:stats_v {id: 2});
+
+-- count vertices expanded by traversals, on the label of each vertex
+CREATE VLABEL stats_w;
+CREATE ELABEL stats_f;
+CREATE (:stats_v {id: 10})-[:stats_f {w: 1}]->(:stats_w {id: 11});
+CREATE (:stats_w {id: 12})-[:stats_e {w: 1}]->(:stats_w {id: 13});
+MATCH (:stats_v {id: 10})-[:stats_f*]->(b) RETURN count(b);
+MATCH (a:stats_w {id: 12}), (b:stats_w {id: 13}),
+      p = shortestpath((a)-[:stats_e*]->(b))
+RETURN length(p) AS len;
+MATCH (a:stats_v {id: 10}), (b:stats_w {id: 11}),
+      p = dijkstra((a)-[e:stats_f]->(b), e.w)
+RETURN length(p) AS len;
+
 -- do a seqscan
 SELECT count(*) FROM tenk2;
 -- do an indexscan
@@ -174,6 +198,12 @@ SELECT st.heap_blks_read + st.heap_blks_hit >= pr.heap_blks + cl.relpages,
 SELECT pr.snap_ts < pg_stat_get_snapshot_timestamp() as snapshot_newer
 FROM prevstats AS pr;
 
+SELECT labname, labkind, created, merge_matched, merge_created, expanded
+  FROM pg_stat_graph_labels
+ WHERE graphname = 'stats_graph' AND labname LIKE 'stats\_%'
+ ORDER BY labname;
+
 DROP TABLE trunc_stats_test, trunc_stats_test1, trunc_stats_test2, trunc_stats_test3, trunc_stats_test4;
 DROP TABLE prevstats;
+DROP GRAPH stats_graph CASCADE;
 -- End of Stats Test
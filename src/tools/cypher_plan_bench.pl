@@ -0,0 +1,184 @@
+#!/usr/bin/perl
+#################################################################
+# cypher_plan_bench.pl -- measure planning time of Cypher queries
+#
+# Copyright (c) 2016 by Bitnine Global, Inc.
+#
+# src/tools/cypher_plan_bench.pl
+#
+# Replays Cypher regression test scripts against a running server and
+# plans every read-only MATCH statement repeatedly with
+# EXPLAIN (SUMMARY ON), then reports the median planning time of each
+# statement and the sum per script.  Each script is run in a freshly
+# created scratch database, which is dropped afterwards.
+#
+# Usage:
+#	cypher_plan_bench.pl [--loops=N] [--dbname=NAME] [--verbose]
+#		[--psql=PATH] [script.sql ...]
+#
+# Without scripts, src/test/regress/sql/cypher_*.sql is used.  Connection
+# parameters are taken from the usual PG* environment variables.
+#################################################################
+
+use strict;
+use warnings;
+
+use File::Basename;
+use Getopt::Long;
+
+my $loops   = 10;
+my $dbname  = 'cypher_plan_bench';
+my $psql    = 'psql';
+my $verbose = 0;
+
+GetOptions(
+	'loops=i'  => \$loops,
+	'dbname=s' => \$dbname,
+	'psql=s'   => \$psql,
+	'verbose'  => \$verbose) or die "invalid options\n";
+
+my @scripts = @ARGV;
+if (!@scripts)
+{
+	my $dir = dirname(__FILE__) . '/../test/regress/sql';
+	@scripts = sort glob("$dir/cypher_*.sql");
+}
+die "no scripts to run\n" if !@scripts;
+
+my $total = 0;
+
+foreach my $script (@scripts)
+{
+	my ($input, $stmts) = make_input($script);
+	my $times = run_input($input);
+	my $sum   = 0;
+
+	foreach my $id (sort { $a <=> $b } keys %$times)
+	{
+		my @t = sort { $a <=> $b } @{ $times->{$id} };
+		next if !@t;
+
+		my $median = $t[ int(@t / 2) ];
+		$sum += $median;
+
+		printf("  %8.3f ms  %s\n", $median, oneline($stmts->[$id]))
+		  if $verbose;
+	}
+
+	printf("%-40s %10.3f ms (%d statements)\n",
+		basename($script), $sum, scalar(keys %$times));
+	$total += $sum;
+}
+
+printf("%-40s %10.3f ms\n", 'total', $total);
+
+exit 0;
+
+# Split a script into statements and build the psql input that replays them
+# and plans read-only MATCH statements $loops times.
+sub make_input
+{
+	my ($script) = @_;
+	my @stmts;
+	my $input = "\\set ON_ERROR_STOP off\n";
+	my $buf = '';
+	my $in_dollar = 0;
+
+	open(my $fh, '<', $script) or die "could not open $script: $!\n";
+	while (my $line = <$fh>)
+	{
+		# psql meta-commands are passed through as they are
+		if ($buf eq '' && $line =~ /^\s*\\/)
+		{
+			$input .= $line;
+			next;
+		}
+
+		$buf .= $line;
+		my $ndollar = () = $line =~ /\$\$/g;
+		$in_dollar = !$in_dollar if $ndollar % 2;
+		next if $in_dollar || $line !~ /;\s*(--.*)?$/;
+
+		$input .= $buf;
+		if (is_readonly_match($buf))
+		{
+			my $id = scalar(@stmts);
+
+			push @stmts, $buf;
+			$input .= "\\echo \@\@bench $id\n";
+			$input .= "EXPLAIN (SUMMARY ON, COSTS OFF) $buf" for 1 .. $loops;
+			$input .= "\\echo \@\@end\n";
+		}
+		$buf = '';
+	}
+	close($fh);
+
+	return ($input, \@stmts);
+}
+
+sub is_readonly_match
+{
+	my ($stmt) = @_;
+
+	$stmt =~ s/--[^\n]*//g;
+	return 0 if $stmt !~ /^\s*(OPTIONAL\s+)?MATCH\b/i;
+	return 0
+	  if $stmt =~ /\b(CREATE|MERGE|SET|DELETE|REMOVE|LOAD|DETACH)\b/i;
+	return 1;
+}
+
+# Run the input in a scratch database and collect planning times per
+# statement.
+sub run_input
+{
+	my ($input) = @_;
+	my %times;
+	my $cur;
+
+	system($psql, '-X', '-q', '-d', 'postgres', '-c',
+		"DROP DATABASE IF EXISTS $dbname") == 0
+	  or die "could not drop database $dbname\n";
+	system($psql, '-X', '-q', '-d', 'postgres', '-c',
+		"CREATE DATABASE $dbname") == 0
+	  or die "could not create database $dbname\n";
+
+	my $tmp = "/tmp/cypher_plan_bench.$$.sql";
+	open(my $out, '>', $tmp) or die "could not open $tmp: $!\n";
+	print $out $input;
+	close($out);
+
+	open(my $res, '-|', "$psql -X -d $dbname -f $tmp 2>/dev/null")
+	  or die "could not run $psql: $!\n";
+	while (my $line = <$res>)
+	{
+		if ($line =~ /^\@\@bench (\d+)/)
+		{
+			$cur = $1;
+			$times{$cur} = [];
+		}
+		elsif ($line =~ /^\@\@end/)
+		{
+			undef $cur;
+		}
+		elsif (defined($cur) && $line =~ /Planning Time: ([\d.]+) ms/)
+		{
+			push @{ $times{$cur} }, $1;
+		}
+	}
+	close($res);
+	unlink($tmp);
+
+	system($psql, '-X', '-q', '-d', 'postgres', '-c',
+		"DROP DATABASE IF EXISTS $dbname");
+
+	return \%times;
+}
+
+sub oneline
+{
+	my ($stmt) = @_;
+
+	$stmt =~ s/\s+/ /g;
+	$stmt =~ s/^ //;
+	return length($stmt) > 70 ? substr($stmt, 0, 67) . '...' : $stmt;
+}